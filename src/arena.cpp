@@ -0,0 +1,81 @@
+#include "arena.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+struct ArenaChunk {
+    ArenaChunk* previous;
+
+    size_t size;
+    size_t used;
+};
+
+const size_t arena_chunk_size = 64 * 1024;
+
+static uint8_t* get_chunk_data(ArenaChunk* chunk) {
+    return (uint8_t*)(chunk + 1);
+}
+
+static ArenaChunk* create_chunk(size_t size, ArenaChunk* previous) {
+    auto chunk = (ArenaChunk*)malloc(sizeof(ArenaChunk) + size);
+    chunk->previous = previous;
+    chunk->size = size;
+    chunk->used = 0;
+
+    return chunk;
+}
+
+static void* allocate_from_chunk(ArenaChunk* chunk, size_t size, size_t alignment) {
+    auto data = get_chunk_data(chunk);
+
+    auto address = (size_t)data + chunk->used;
+    auto aligned_address = (address + alignment - 1) & ~(alignment - 1);
+
+    if(aligned_address + size > (size_t)data + chunk->size) {
+        return nullptr;
+    }
+
+    chunk->used = aligned_address + size - (size_t)data;
+
+    return (void*)aligned_address;
+}
+
+void* allocate_from_arena(Arena* arena, size_t size, size_t alignment) {
+    if(arena->current_chunk != nullptr) {
+        auto pointer = allocate_from_chunk(arena->current_chunk, size, alignment);
+
+        if(pointer != nullptr) {
+            return pointer;
+        }
+    }
+
+    // Large allocations get a chunk of their own behind the current one, so the space left in it isn't wasted
+    if(size > arena_chunk_size / 4 && arena->current_chunk != nullptr) {
+        auto chunk = create_chunk(size + alignment, arena->current_chunk->previous);
+        arena->current_chunk->previous = chunk;
+
+        return allocate_from_chunk(chunk, size, alignment);
+    }
+
+    auto chunk_size = arena_chunk_size;
+    if(size + alignment > chunk_size) {
+        chunk_size = size + alignment;
+    }
+
+    arena->current_chunk = create_chunk(chunk_size, arena->current_chunk);
+
+    return allocate_from_chunk(arena->current_chunk, size, alignment);
+}
+
+void free_arena(Arena* arena) {
+    auto chunk = arena->current_chunk;
+
+    while(chunk != nullptr) {
+        auto previous = chunk->previous;
+
+        free(chunk);
+
+        chunk = previous;
+    }
+
+    arena->current_chunk = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+#include "array.h"
+
+struct ArenaChunk;
+
+// Bump allocator for data that is all freed at once, only one thread may use an arena at a time
+struct Arena {
+    ArenaChunk* current_chunk;
+};
+
+void* allocate_from_arena(Arena* arena, size_t size, size_t alignment);
+void free_arena(Arena* arena);
+
+template <typename T>
+inline T* allocate(Arena* arena, size_t count) {
+    return (T*)allocate_from_arena(arena, sizeof(T) * count, alignof(T));
+}
+
+template <typename T>
+inline T* heapify(Arena* arena, T value) {
+    auto pointer = allocate<T>(arena, 1);
+
+    *pointer = value;
+
+    return pointer;
+}
+
+inline void* operator new(size_t size, Arena* arena) {
+    return allocate_from_arena(arena, size, alignof(max_align_t));
+}
+
+// Growable array whose storage lives in an arena, old storage is left behind in the arena when it grows
+template <typename T>
+struct ArenaList : Array<T> {
+    Arena* arena;
+
+    size_t capacity;
+
+    size_t append(T element) {
+        const size_t initial_capacity = 16;
+
+        if(capacity == 0) {
+            capacity = initial_capacity;
+
+            this->elements = allocate<T>(arena, initial_capacity);
+        } else if(this->length == capacity) {
+            auto new_capacity = capacity * 2;
+
+            auto new_elements = allocate<T>(arena, new_capacity);
+            memcpy((void*)new_elements, (void*)this->elements, this->length * sizeof(T));
+
+            capacity = new_capacity;
+            this->elements = new_elements;
+        }
+
+        auto index = this->length;
+
+        this->elements[index] = element;
+
+        this->length += 1;
+
+        return index;
+    }
+};
\ No newline at end of file
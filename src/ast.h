@@ -4,9 +4,12 @@
 #include "array.h"
 #include "string.h"
 #include "util.h"
+#include "symbols.h"
 
+// The text of an identifier is always an interned symbol
 struct Identifier {
     String text;
+    uint32_t hash;
 
     FileRange range;
 };
@@ -725,17 +728,20 @@ struct Import : Statement {
     String path;
     String absolute_path;
     String name;
+    uint32_t name_hash;
 
     explicit inline Import(
         FileRange range,
         String path,
         String absolute_path,
-        String name
+        String name,
+        uint32_t name_hash
     ) :
         Statement { StatementKind::Import, range },
         path { path },
         absolute_path { absolute_path },
-        name { name }
+        name { name },
+        name_hash { name_hash }
     {}
 };
 
@@ -0,0 +1,188 @@
+#include "byte_scan.h"
+#include "platform.h"
+
+static inline bool is_ascii(uint8_t byte) {
+    return byte < 0x80;
+}
+
+static inline bool is_space(uint8_t byte) {
+    return byte == ' ';
+}
+
+static inline bool is_identifier(uint8_t byte) {
+    return
+        (byte >= 'a' && byte <= 'z') ||
+        (byte >= 'A' && byte <= 'Z') ||
+        (byte >= '0' && byte <= '9') ||
+        byte == '_'
+    ;
+}
+
+static inline bool is_decimal_digit(uint8_t byte) {
+    return byte >= '0' && byte <= '9';
+}
+
+static inline bool is_line_comment(uint8_t byte) {
+    return byte < 0x80 && byte != '\r' && byte != '\n';
+}
+
+static inline bool is_block_comment(uint8_t byte) {
+    return is_line_comment(byte) && byte != '/' && byte != '*';
+}
+
+static inline bool is_string_literal(uint8_t byte) {
+    return is_line_comment(byte) && byte != '"' && byte != '\\';
+}
+
+#if defined(ARCH_X64)
+
+#include <emmintrin.h>
+
+// SSE2 only compares signed bytes, so anything at or above 0x80 is negative and falls outside every range checked here
+static inline __m128i bytes_in_range(__m128i block, char first, char last) {
+    return _mm_and_si128(
+        _mm_cmpgt_epi8(block, _mm_set1_epi8(first - 1)),
+        _mm_cmplt_epi8(block, _mm_set1_epi8(last + 1))
+    );
+}
+
+static inline __m128i bytes_equal(__m128i block, char value) {
+    return _mm_cmpeq_epi8(block, _mm_set1_epi8(value));
+}
+
+// These return a bit for each byte of the block that is not in the class
+static inline uint32_t get_non_ascii_mask(__m128i block) {
+    return (uint32_t)_mm_movemask_epi8(block);
+}
+
+static inline uint32_t get_non_space_mask(__m128i block) {
+    return ~(uint32_t)_mm_movemask_epi8(bytes_equal(block, ' ')) & 0xFFFF;
+}
+
+static inline uint32_t get_non_identifier_mask(__m128i block) {
+    // Setting bit 5 maps upper case letters onto lower case ones, and nothing else onto a letter
+    auto letters = bytes_in_range(_mm_or_si128(block, _mm_set1_epi8(0x20)), 'a', 'z');
+    auto digits = bytes_in_range(block, '0', '9');
+    auto underscores = bytes_equal(block, '_');
+
+    auto matches = _mm_or_si128(_mm_or_si128(letters, digits), underscores);
+
+    return ~(uint32_t)_mm_movemask_epi8(matches) & 0xFFFF;
+}
+
+static inline uint32_t get_non_decimal_digit_mask(__m128i block) {
+    return ~(uint32_t)_mm_movemask_epi8(bytes_in_range(block, '0', '9')) & 0xFFFF;
+}
+
+static inline uint32_t get_non_line_comment_mask(__m128i block) {
+    auto line_endings = _mm_or_si128(bytes_equal(block, '\r'), bytes_equal(block, '\n'));
+
+    return (uint32_t)_mm_movemask_epi8(_mm_or_si128(block, line_endings));
+}
+
+static inline uint32_t get_non_block_comment_mask(__m128i block) {
+    auto line_endings = _mm_or_si128(bytes_equal(block, '\r'), bytes_equal(block, '\n'));
+    auto delimiters = _mm_or_si128(bytes_equal(block, '/'), bytes_equal(block, '*'));
+
+    return (uint32_t)_mm_movemask_epi8(_mm_or_si128(block, _mm_or_si128(line_endings, delimiters)));
+}
+
+static inline uint32_t get_non_string_literal_mask(__m128i block) {
+    auto line_endings = _mm_or_si128(bytes_equal(block, '\r'), bytes_equal(block, '\n'));
+    auto delimiters = _mm_or_si128(bytes_equal(block, '"'), bytes_equal(block, '\\'));
+
+    return (uint32_t)_mm_movemask_epi8(_mm_or_si128(block, _mm_or_si128(line_endings, delimiters)));
+}
+
+template <uint32_t (*get_stop_mask)(__m128i), bool (*is_match)(uint8_t)>
+static inline size_t count_bytes(const uint8_t* bytes, size_t length) {
+    size_t index = 0;
+
+    while(index + 16 <= length) {
+        auto block = _mm_loadu_si128((const __m128i*)&bytes[index]);
+
+        auto stop_mask = get_stop_mask(block);
+        if(stop_mask != 0) {
+            return index + (size_t)__builtin_ctz(stop_mask);
+        }
+
+        index += 16;
+    }
+
+    while(index < length && is_match(bytes[index])) {
+        index += 1;
+    }
+
+    return index;
+}
+
+size_t count_ascii_bytes(const uint8_t* bytes, size_t length) {
+    return count_bytes<get_non_ascii_mask, is_ascii>(bytes, length);
+}
+
+size_t count_space_bytes(const uint8_t* bytes, size_t length) {
+    return count_bytes<get_non_space_mask, is_space>(bytes, length);
+}
+
+size_t count_identifier_bytes(const uint8_t* bytes, size_t length) {
+    return count_bytes<get_non_identifier_mask, is_identifier>(bytes, length);
+}
+
+size_t count_decimal_digit_bytes(const uint8_t* bytes, size_t length) {
+    return count_bytes<get_non_decimal_digit_mask, is_decimal_digit>(bytes, length);
+}
+
+size_t count_line_comment_bytes(const uint8_t* bytes, size_t length) {
+    return count_bytes<get_non_line_comment_mask, is_line_comment>(bytes, length);
+}
+
+size_t count_block_comment_bytes(const uint8_t* bytes, size_t length) {
+    return count_bytes<get_non_block_comment_mask, is_block_comment>(bytes, length);
+}
+
+size_t count_string_literal_bytes(const uint8_t* bytes, size_t length) {
+    return count_bytes<get_non_string_literal_mask, is_string_literal>(bytes, length);
+}
+
+#else
+
+template <bool (*is_match)(uint8_t)>
+static inline size_t count_bytes(const uint8_t* bytes, size_t length) {
+    size_t index = 0;
+
+    while(index < length && is_match(bytes[index])) {
+        index += 1;
+    }
+
+    return index;
+}
+
+size_t count_ascii_bytes(const uint8_t* bytes, size_t length) {
+    return count_bytes<is_ascii>(bytes, length);
+}
+
+size_t count_space_bytes(const uint8_t* bytes, size_t length) {
+    return count_bytes<is_space>(bytes, length);
+}
+
+size_t count_identifier_bytes(const uint8_t* bytes, size_t length) {
+    return count_bytes<is_identifier>(bytes, length);
+}
+
+size_t count_decimal_digit_bytes(const uint8_t* bytes, size_t length) {
+    return count_bytes<is_decimal_digit>(bytes, length);
+}
+
+size_t count_line_comment_bytes(const uint8_t* bytes, size_t length) {
+    return count_bytes<is_line_comment>(bytes, length);
+}
+
+size_t count_block_comment_bytes(const uint8_t* bytes, size_t length) {
+    return count_bytes<is_block_comment>(bytes, length);
+}
+
+size_t count_string_literal_bytes(const uint8_t* bytes, size_t length) {
+    return count_bytes<is_string_literal>(bytes, length);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Each of these returns how many bytes at the start of the given range belong to the named class, checking 16 bytes
+// at a time where the target allows it
+
+size_t count_ascii_bytes(const uint8_t* bytes, size_t length);
+size_t count_space_bytes(const uint8_t* bytes, size_t length);
+size_t count_identifier_bytes(const uint8_t* bytes, size_t length);
+size_t count_decimal_digit_bytes(const uint8_t* bytes, size_t length);
+
+// ASCII bytes that don't end a line
+size_t count_line_comment_bytes(const uint8_t* bytes, size_t length);
+
+// ASCII bytes that don't end a line and can't start or end a nested block comment
+size_t count_block_comment_bytes(const uint8_t* bytes, size_t length);
+
+// ASCII bytes that don't end a line, the literal or start an escape sequence
+size_t count_string_literal_bytes(const uint8_t* bytes, size_t length);
\ No newline at end of file
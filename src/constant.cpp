@@ -63,7 +63,7 @@ String AnyConstantValue::get_description() {
 
         return buffer;
     } else if(kind == ConstantValueKind::StaticArrayConstant) {
-        if(static_array.elements.length == 0) {
+        if(static_array.length == 0) {
             return u8"{}"_S;
         }
 
@@ -71,10 +71,10 @@ String AnyConstantValue::get_description() {
 
         buffer.append(u8"{ u8"_S);
 
-        for(size_t i = 0; i < static_array.elements.length; i += 1) {
-            buffer.append(static_array.elements[i].get_description());
+        for(size_t i = 0; i < static_array.length; i += 1) {
+            buffer.append(static_array.get_element(i).get_description());
 
-            if(i != static_array.elements.length - 1) {
+            if(i != static_array.length - 1) {
                 buffer.append(u8", u8"_S);
             }
         }
@@ -566,7 +566,7 @@ Result<TypedConstantValue> evaluate_constant_index(
         if(value.kind == ConstantValueKind::StaticArrayConstant) {
             auto static_array_value = value.static_array;
 
-            if(index_integer >= static_array_value.elements.length) {
+            if(index_integer >= static_array_value.length) {
                 error(scope, index_range, "Array index %zu out of bounds", index_integer);
 
                 return err();
@@ -574,7 +574,7 @@ Result<TypedConstantValue> evaluate_constant_index(
 
             return ok(TypedConstantValue(
                 *array_type.element_type,
-                static_array_value.elements[index_integer]
+                static_array_value.get_element(index_integer)
             ));
         } else {
             error(scope, range, "Cannot index an array with non-constant elements in a constant context");
@@ -593,11 +593,11 @@ Result<TypedConstantValue> evaluate_constant_index(
         if(value.kind == ConstantValueKind::StaticArrayConstant) {
             auto static_array_value = value.static_array;
 
-            assert(static_array_value.elements.length == static_array.length);
+            assert(static_array_value.length == static_array.length);
 
             return ok(TypedConstantValue(
                 *static_array.element_type,
-                static_array_value.elements[index_integer]
+                static_array_value.get_element(index_integer)
             ));
         } else {
             error(scope, range, "Cannot index an array with non-constant elements in a constant context");
@@ -1637,27 +1637,27 @@ bool does_or_could_have_public_name(Statement* statement, String name) {
     if(statement->kind == StatementKind::FunctionDeclaration) {
         auto function_declaration = (FunctionDeclaration*)statement;
 
-        return name == function_declaration->name.text;
+        return symbols_equal(name, function_declaration->name.text);
     } else if(statement->kind == StatementKind::ConstantDefinition) {
         auto constant_definition = (ConstantDefinition*)statement;
 
-        return name == constant_definition->name.text;
+        return symbols_equal(name, constant_definition->name.text);
     } else if(statement->kind == StatementKind::StructDefinition) {
         auto struct_definition = (StructDefinition*)statement;
 
-        return name == struct_definition->name.text;
+        return symbols_equal(name, struct_definition->name.text);
     } else if(statement->kind == StatementKind::UnionDefinition) {
         auto union_definition = (UnionDefinition*)statement;
 
-        return name == union_definition->name.text;
+        return symbols_equal(name, union_definition->name.text);
     } else if(statement->kind == StatementKind::EnumDefinition) {
         auto enum_definition = (EnumDefinition*)statement;
 
-        return name == enum_definition->name.text;
+        return symbols_equal(name, enum_definition->name.text);
     } else if(statement->kind == StatementKind::Import) {
         auto import = (Import*)statement;
 
-        return name == import->name;
+        return symbols_equal(name, import->name);
     } else if(statement->kind == StatementKind::StaticIf) {
         auto static_if = (StaticIf*)statement;
 
@@ -1681,27 +1681,27 @@ bool does_or_could_have_name(Statement* statement, String name) {
     if(statement->kind == StatementKind::FunctionDeclaration) {
         auto function_declaration = (FunctionDeclaration*)statement;
 
-        return name == function_declaration->name.text;
+        return symbols_equal(name, function_declaration->name.text);
     } else if(statement->kind == StatementKind::ConstantDefinition) {
         auto constant_definition = (ConstantDefinition*)statement;
 
-        return name == constant_definition->name.text;
+        return symbols_equal(name, constant_definition->name.text);
     } else if(statement->kind == StatementKind::StructDefinition) {
         auto struct_definition = (StructDefinition*)statement;
 
-        return name == struct_definition->name.text;
+        return symbols_equal(name, struct_definition->name.text);
     } else if(statement->kind == StatementKind::UnionDefinition) {
         auto union_definition = (UnionDefinition*)statement;
 
-        return name == union_definition->name.text;
+        return symbols_equal(name, union_definition->name.text);
     } else if(statement->kind == StatementKind::EnumDefinition) {
         auto enum_definition = (EnumDefinition*)statement;
 
-        return name == enum_definition->name.text;
+        return symbols_equal(name, enum_definition->name.text);
     } else if(statement->kind == StatementKind::Import) {
         auto import = (Import*)statement;
 
-        return name == import->name;
+        return symbols_equal(name, import->name);
     } else if(statement->kind == StatementKind::StaticIf) {
         auto static_if = (StaticIf*)statement;
 
@@ -1723,7 +1723,7 @@ bool does_or_could_have_name(Statement* statement, String name) {
 
 DelayedResult<TypedConstantValue> get_simple_resolved_declaration(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     ConstantScope* scope,
     Statement* declaration
 ) {
@@ -1743,154 +1743,133 @@ DelayedResult<TypedConstantValue> get_simple_resolved_declaration(
                 }
             }
 
-            for(size_t i = 0; i < jobs->length; i += 1) {
-                auto job = (*jobs)[i];
+            size_t job_index;
+            if(!jobs->find(JobKind::ResolveFunctionDeclaration, function_declaration, scope, &job_index)) {
+                abort();
+            }
 
-                if(job.kind == JobKind::ResolveFunctionDeclaration) {
-                    auto resolve_function_declaration = job.resolve_function_declaration;
+            auto job = &(*jobs)[job_index];
 
-                    if(resolve_function_declaration.declaration == function_declaration) {
-                        if(job.state == JobState::Done) {
-                            return ok(TypedConstantValue(
-                                resolve_function_declaration.type,
-                                resolve_function_declaration.value
-                            ));
-                        } else {
-                            return wait(i);
-                        }
-                    }
-                }
-            }
+            if(get_job_state(job) == JobState::Done) {
+                auto resolve_function_declaration = &job->resolve_function_declaration;
 
-            abort();
+                return ok(TypedConstantValue(
+                    resolve_function_declaration->type,
+                    resolve_function_declaration->value
+                ));
+            } else {
+                return wait(job_index);
+            }
         } break;
 
         case StatementKind::ConstantDefinition: {
             auto constant_definition = (ConstantDefinition*)declaration;
 
-            for(size_t i = 0; i < jobs->length; i += 1) {
-                auto job = (*jobs)[i];
+            size_t job_index;
+            if(!jobs->find(JobKind::ResolveConstantDefinition, constant_definition, scope, &job_index)) {
+                abort();
+            }
 
-                if(job.kind == JobKind::ResolveConstantDefinition) {
-                    auto resolve_constant_definition = job.resolve_constant_definition;
+            auto job = &(*jobs)[job_index];
 
-                    if(resolve_constant_definition.definition == constant_definition) {
-                        if(job.state == JobState::Done) {
-                            return ok(TypedConstantValue(
-                                resolve_constant_definition.type,
-                                resolve_constant_definition.value
-                            ));
-                        } else {
-                            return wait(i);
-                        }
-                    }
-                }
-            }
+            if(get_job_state(job) == JobState::Done) {
+                auto resolve_constant_definition = &job->resolve_constant_definition;
 
-            abort();
+                return ok(TypedConstantValue(
+                    resolve_constant_definition->type,
+                    resolve_constant_definition->value
+                ));
+            } else {
+                return wait(job_index);
+            }
         } break;
 
         case StatementKind::StructDefinition: {
             auto struct_definition = (StructDefinition*)declaration;
 
-            for(size_t i = 0; i < jobs->length; i += 1) {
-                auto job = (*jobs)[i];
+            size_t job_index;
+            if(!jobs->find(JobKind::ResolveStructDefinition, struct_definition, scope, &job_index)) {
+                abort();
+            }
 
-                if(job.kind == JobKind::ResolveStructDefinition) {
-                    auto resolve_struct_definition = job.resolve_struct_definition;
+            auto job = &(*jobs)[job_index];
 
-                    if(resolve_struct_definition.definition == struct_definition) {
-                        if(job.state == JobState::Done) {
-                            return ok(TypedConstantValue(
-                                AnyType::create_type_type(),
-                                AnyConstantValue(resolve_struct_definition.type)
-                            ));
-                        } else {
-                            return wait(i);
-                        }
-                    }
-                }
-            }
+            if(get_job_state(job) == JobState::Done) {
+                auto resolve_struct_definition = &job->resolve_struct_definition;
 
-            abort();
+                return ok(TypedConstantValue(
+                    AnyType::create_type_type(),
+                    AnyConstantValue(resolve_struct_definition->type)
+                ));
+            } else {
+                return wait(job_index);
+            }
         } break;
 
         case StatementKind::UnionDefinition: {
             auto union_definition = (UnionDefinition*)declaration;
 
-            for(size_t i = 0; i < jobs->length; i += 1) {
-                auto job = (*jobs)[i];
+            size_t job_index;
+            if(!jobs->find(JobKind::ResolveUnionDefinition, union_definition, scope, &job_index)) {
+                abort();
+            }
 
-                if(job.kind == JobKind::ResolveUnionDefinition) {
-                    auto resolve_union_definition = job.resolve_union_definition;
+            auto job = &(*jobs)[job_index];
 
-                    if(resolve_union_definition.definition == union_definition) {
-                        if(job.state == JobState::Done) {
-                            return ok(TypedConstantValue(
-                                AnyType::create_type_type(),
-                                AnyConstantValue(resolve_union_definition.type)
-                            ));
-                        } else {
-                            return wait(i);
-                        }
-                    }
-                }
-            }
+            if(get_job_state(job) == JobState::Done) {
+                auto resolve_union_definition = &job->resolve_union_definition;
 
-            abort();
+                return ok(TypedConstantValue(
+                    AnyType::create_type_type(),
+                    AnyConstantValue(resolve_union_definition->type)
+                ));
+            } else {
+                return wait(job_index);
+            }
         } break;
 
         case StatementKind::EnumDefinition: {
             auto enum_definition = (EnumDefinition*)declaration;
 
-            for(size_t i = 0; i < jobs->length; i += 1) {
-                auto job = (*jobs)[i];
+            size_t job_index;
+            if(!jobs->find(JobKind::ResolveEnumDefinition, enum_definition, scope, &job_index)) {
+                abort();
+            }
 
-                if(job.kind == JobKind::ResolveEnumDefinition) {
-                    auto resolve_enum_definition = job.resolve_enum_definition;
+            auto job = &(*jobs)[job_index];
 
-                    if(resolve_enum_definition.definition == enum_definition) {
-                        if(job.state == JobState::Done) {
-                            return ok(TypedConstantValue(
-                                AnyType::create_type_type(),
-                                AnyConstantValue(AnyType(resolve_enum_definition.type))
-                            ));
-                        } else {
-                            return wait(i);
-                        }
-                    }
-                }
-            }
+            if(get_job_state(job) == JobState::Done) {
+                auto resolve_enum_definition = &job->resolve_enum_definition;
 
-            abort();
+                return ok(TypedConstantValue(
+                    AnyType::create_type_type(),
+                    AnyConstantValue(AnyType(resolve_enum_definition->type))
+                ));
+            } else {
+                return wait(job_index);
+            }
         } break;
 
         case StatementKind::Import: {
             auto import = (Import*)declaration;
 
-            auto job_already_added = false;
-            for(size_t i = 0; i < jobs->length; i += 1) {
-                auto job = (*jobs)[i];
-
-                if(job.kind == JobKind::ParseFile) {
-                    auto parse_file = job.parse_file;
-
-                    if(parse_file.path == import->absolute_path) {
-                        if(job.state == JobState::Done) {
-                            return ok(TypedConstantValue(
-                                AnyType::create_file_module(),
-                                AnyConstantValue(FileModuleConstant(
-                                    parse_file.scope
-                                ))
-                            ));
-                        } else {
-                            return wait(i);
-                        }
-                    }
-                }
+            size_t job_index;
+            if(!jobs->find_parse_file(import->absolute_path, &job_index)) {
+                abort();
             }
 
-            abort();
+            auto job = &(*jobs)[job_index];
+
+            if(get_job_state(job) == JobState::Done) {
+                return ok(TypedConstantValue(
+                    AnyType::create_file_module(),
+                    AnyConstantValue(FileModuleConstant(
+                        job->parse_file.scope
+                    ))
+                ));
+            } else {
+                return wait(job_index);
+            }
         } break;
 
         default: abort();
@@ -1936,12 +1915,23 @@ bool constant_values_equal(AnyConstantValue a, AnyConstantValue b) {
         } break;
 
         case ConstantValueKind::StaticArrayConstant: {
-            if(a.static_array.elements.length != b.static_array.elements.length) {
+            if(a.static_array.length != b.static_array.length) {
                 return false;
             }
 
-            for(size_t i = 0; i < a.static_array.elements.length; i += 1) {
-                if(!constant_values_equal(a.static_array.elements[i], b.static_array.elements[i])) {
+            if(
+                a.static_array.is_packed &&
+                b.static_array.is_packed &&
+                a.static_array.packed.element_size == b.static_array.packed.element_size &&
+                a.static_array.packed.is_signed == b.static_array.packed.is_signed
+            ) {
+                auto byte_count = a.static_array.length * register_size_to_byte_size(a.static_array.packed.element_size);
+
+                return memcmp(a.static_array.packed.bytes, b.static_array.packed.bytes, byte_count) == 0;
+            }
+
+            for(size_t i = 0; i < a.static_array.length; i += 1) {
+                if(!constant_values_equal(a.static_array.get_element(i), b.static_array.get_element(i))) {
                     return false;
                 }
             }
@@ -1975,6 +1965,72 @@ bool constant_values_equal(AnyConstantValue a, AnyConstantValue b) {
     }
 }
 
+// Values that are equal under constant_values_equal always hash the same
+uint64_t calculate_constant_value_hash(AnyConstantValue value) {
+    auto hash = (uint64_t)value.kind;
+
+    switch(value.kind) {
+        case ConstantValueKind::FunctionConstant: {
+            hash = combine_hash(hash, (uint64_t)value.function.declaration);
+        } break;
+
+        case ConstantValueKind::PolymorphicFunctionConstant: {
+            hash = combine_hash(hash, (uint64_t)value.polymorphic_function.declaration);
+        } break;
+
+        case ConstantValueKind::BuiltinFunctionConstant: {
+            hash = combine_hash(hash, calculate_string_hash(value.builtin_function.name));
+        } break;
+
+        case ConstantValueKind::IntegerConstant: {
+            hash = combine_hash(hash, value.integer);
+        } break;
+
+        case ConstantValueKind::BooleanConstant: {
+            hash = combine_hash(hash, (uint64_t)value.boolean);
+        } break;
+
+        case ConstantValueKind::FloatConstant: {
+            // -0.0 and 0.0 compare equal
+            if(value.float_ != 0.0) {
+                uint64_t bits;
+                memcpy(&bits, &value.float_, sizeof(bits));
+
+                hash = combine_hash(hash, bits);
+            }
+        } break;
+
+        case ConstantValueKind::TypeConstant: {
+            hash = combine_hash(hash, value.type.get_hash());
+        } break;
+
+        case ConstantValueKind::ArrayConstant: {
+            hash = combine_hash(hash, (uint64_t)value.array.length);
+            hash = combine_hash(hash, (uint64_t)value.array.pointer);
+        } break;
+
+        case ConstantValueKind::StaticArrayConstant: {
+            for(size_t i = 0; i < value.static_array.length; i += 1) {
+                hash = combine_hash(hash, calculate_constant_value_hash(value.static_array.get_element(i)));
+            }
+        } break;
+
+        case ConstantValueKind::StructConstant: {
+            for(size_t i = 0; i < value.struct_.members.length; i += 1) {
+                hash = combine_hash(hash, calculate_constant_value_hash(value.struct_.members[i]));
+            }
+        } break;
+
+        case ConstantValueKind::FileModuleConstant: {
+            hash = combine_hash(hash, (uint64_t)value.file_module.scope);
+        } break;
+
+        default: break;
+    }
+
+    return hash;
+}
+
 static Result<String> get_declaration_name(Statement* declaration) {
     if(declaration->kind == StatementKind::FunctionDeclaration) {
         auto function_declaration = (FunctionDeclaration*)declaration;
@@ -2005,60 +2061,110 @@ static Result<String> get_declaration_name(Statement* declaration) {
     }
 }
 
-uint32_t calculate_string_hash(String string) {
-    uint32_t hash = 0;
+static uint32_t get_declaration_name_hash(Statement* declaration) {
+    if(declaration->kind == StatementKind::FunctionDeclaration) {
+        auto function_declaration = (FunctionDeclaration*)declaration;
 
-    for(size_t i = 0; i < string.length; i += 1) {
-        hash = (uint8_t)string.elements[i] + (hash << 6) + (hash << 16) - hash;
-    }
+        return function_declaration->name.hash;
+    } else if(declaration->kind == StatementKind::ConstantDefinition) {
+        auto constant_definition = (ConstantDefinition*)declaration;
 
-    return hash;
+        return constant_definition->name.hash;
+    } else if(declaration->kind == StatementKind::StructDefinition) {
+        auto struct_definition = (StructDefinition*)declaration;
+
+        return struct_definition->name.hash;
+    } else if(declaration->kind == StatementKind::UnionDefinition) {
+        auto union_definition = (UnionDefinition*)declaration;
+
+        return union_definition->name.hash;
+    } else if(declaration->kind == StatementKind::EnumDefinition) {
+        auto enum_definition = (EnumDefinition*)declaration;
+
+        return enum_definition->name.hash;
+    } else if(declaration->kind == StatementKind::Import) {
+        auto import = (Import*)declaration;
+
+        return import->name_hash;
+    } else {
+        abort();
+    }
 }
 
 DeclarationHashTable create_declaration_hash_table(Array<Statement*> statements) {
+    size_t declaration_count = 0;
+    for(auto statement : statements) {
+        if(get_declaration_name(statement).status) {
+            declaration_count += 1;
+        }
+    }
+
     DeclarationHashTable hash_table {};
 
+    if(declaration_count == 0) {
+        return hash_table;
+    }
+
+    // Keep the table at most half full
+    hash_table.capacity = 8;
+    while(hash_table.capacity < declaration_count * 2) {
+        hash_table.capacity *= 2;
+    }
+
+    hash_table.entries = allocate<DeclarationHashTableEntry>(hash_table.capacity);
+    memset(hash_table.entries, 0, hash_table.capacity * sizeof(DeclarationHashTableEntry));
+
     for(auto statement : statements) {
         auto result = get_declaration_name(statement);
 
         if(result.status) {
-            auto declaration_name = result.value;
-
-            auto hash = calculate_string_hash(declaration_name);
+            auto hash = get_declaration_name_hash(statement);
 
-            auto bucket_index = hash % DECLARATION_HASH_TABLE_SIZE;
+            auto entry_index = (size_t)hash & (hash_table.capacity - 1);
+            while(hash_table.entries[entry_index].declaration != nullptr) {
+                entry_index = (entry_index + 1) & (hash_table.capacity - 1);
+            }
 
-            hash_table.buckets[bucket_index].append(statement);
+            auto entry = &hash_table.entries[entry_index];
+            entry->name = result.value;
+            entry->hash = hash;
+            entry->declaration = statement;
         }
     }
 
     return hash_table;
 }
 
-Statement* search_in_declaration_hash_table(DeclarationHashTable declaration_hash_table, uint32_t hash, String name) {
-    auto bucket = declaration_hash_table.buckets[hash % DECLARATION_HASH_TABLE_SIZE];
+// Declarations are inserted in order, so when a name is declared more than once the first declaration is found
+Statement* search_in_declaration_hash_table(DeclarationHashTable* declaration_hash_table, uint32_t hash, String name) {
+    if(declaration_hash_table->capacity == 0) {
+        return nullptr;
+    }
 
-    for(auto declaration : bucket) {
-        auto result = get_declaration_name(declaration);
+    auto entry_index = (size_t)hash & (declaration_hash_table->capacity - 1);
+    while(true) {
+        auto entry = &declaration_hash_table->entries[entry_index];
 
-        assert(result.status);
+        if(entry->declaration == nullptr) {
+            return nullptr;
+        }
 
-        if(result.value == name) {
-            return declaration;
+        if(entry->hash == hash && symbols_equal(entry->name, name)) {
+            return entry->declaration;
         }
-    }
 
-    return nullptr;
+        entry_index = (entry_index + 1) & (declaration_hash_table->capacity - 1);
+    }
 }
 
 static DelayedResult<NameSearchResult> search_for_name_internal(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     String name,
     uint32_t name_hash,
     ConstantScope* scope,
     Array<Statement*> statements,
-    DeclarationHashTable declarations,
+    DeclarationHashTable* declarations,
     bool external,
     Statement* ignore,
     bool* has_reached_ignore_in_scope
@@ -2109,7 +2215,7 @@ static DelayedResult<NameSearchResult> search_for_name_internal(
                         name_hash,
                         file_module.scope,
                         file_module.scope->statements,
-                        file_module.scope->declarations,
+                        &file_module.scope->declarations,
                         true,
                         nullptr
                     ));
@@ -2129,7 +2235,7 @@ static DelayedResult<NameSearchResult> search_for_name_internal(
                         auto enum_ = type.enum_;
 
                         for(size_t i = 0; i < enum_.variant_values.length; i += 1) {
-                            if(enum_.definition->variants[i].name.text == name) {
+                            if(symbols_equal(enum_.definition->variants[i].name.text, name)) {
                                 NameSearchResult result {};
                                 result.found = true;
                                 result.type = AnyType(*enum_.backing_type);
@@ -2152,60 +2258,50 @@ static DelayedResult<NameSearchResult> search_for_name_internal(
         } else if(statement->kind == StatementKind::StaticIf) {
             auto static_if = (StaticIf*)statement;
 
-            auto found = false;
-            for(size_t i = 0; i < jobs->length; i += 1) {
-                auto job = (*jobs)[i];
+            size_t job_index;
+            if(!jobs->find(JobKind::ResolveStaticIf, static_if, scope, &job_index)) {
+                abort();
+            }
 
-                if(job.kind == JobKind::ResolveStaticIf) {
-                    auto resolve_static_if = job.resolve_static_if;
+            auto job = &(*jobs)[job_index];
+            auto resolve_static_if = &job->resolve_static_if;
 
-                    if(
-                        resolve_static_if.static_if == static_if &&
-                        resolve_static_if.scope == scope
-                    ) {
-                        found = true;
-
-                        if(job.state == JobState::Done) {
-                            if(resolve_static_if.condition) {
-                                expect_delayed(search_value, search_for_name_internal(
-                                    info,
-                                    jobs,
-                                    name,
-                                    name_hash,
-                                    scope,
-                                    static_if->statements,
-                                    resolve_static_if.declarations,
-                                    false,
-                                    ignore,
-                                    has_reached_ignore_in_scope
-                                ));
-
-                                if(search_value.found) {
-                                    NameSearchResult result {};
-                                    result.found = true;
-                                    result.type = search_value.type;
-                                    result.value = search_value.value;
-
-                                    return ok(result);
-                                }
-                            }
-                        } else {
-                            bool could_have_declaration;
-                            if(external) {
-                                could_have_declaration = does_or_could_have_public_name(static_if, name);
-                            } else {
-                                could_have_declaration = does_or_could_have_name(static_if, name);
-                            }
+            if(get_job_state(job) == JobState::Done) {
+                if(resolve_static_if->condition) {
+                    expect_delayed(search_value, search_for_name_internal(
+                        info,
+                        jobs,
+                        name,
+                        name_hash,
+                        scope,
+                        static_if->statements,
+                        &resolve_static_if->declarations,
+                        false,
+                        ignore,
+                        has_reached_ignore_in_scope
+                    ));
 
-                            if(could_have_declaration) {
-                                return wait(i);
-                            }
-                        }
+                    if(search_value.found) {
+                        NameSearchResult result {};
+                        result.found = true;
+                        result.type = search_value.type;
+                        result.value = search_value.value;
+
+                        return ok(result);
                     }
                 }
-            }
+            } else {
+                bool could_have_declaration;
+                if(external) {
+                    could_have_declaration = does_or_could_have_public_name(static_if, name);
+                } else {
+                    could_have_declaration = does_or_could_have_name(static_if, name);
+                }
 
-            assert(found);
+                if(could_have_declaration) {
+                    return wait(job_index);
+                }
+            }
         }
 
         if(*has_reached_ignore_in_scope) {
@@ -2214,7 +2310,7 @@ static DelayedResult<NameSearchResult> search_for_name_internal(
     }
 
     for(auto scope_constant : scope->scope_constants) {
-        if(scope_constant.name == name) {
+        if(symbols_equal(scope_constant.name, name)) {
             NameSearchResult result {};
             result.found = true;
             result.type = scope_constant.type;
@@ -2232,12 +2328,12 @@ static DelayedResult<NameSearchResult> search_for_name_internal(
 
 profiled_function(DelayedResult<NameSearchResult>, search_for_name, (
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     String name,
     uint32_t name_hash,
     ConstantScope* scope,
     Array<Statement*> statements,
-    DeclarationHashTable declarations,
+    DeclarationHashTable* declarations,
     bool external,
     Statement* ignore
 ), (
@@ -2274,7 +2370,7 @@ Result<String> array_to_string(ConstantScope* scope, FileRange range, AnyType ty
         element_type = *type.static_array.element_type;
 
         if(value.kind == ConstantValueKind::StaticArrayConstant) {
-            assert(value.static_array.elements.length == type.static_array.length);
+            assert(value.static_array.length == type.static_array.length);
 
             static_array_value = value.static_array;
         } else {
@@ -2307,35 +2403,74 @@ Result<String> array_to_string(ConstantScope* scope, FileRange range, AnyType ty
         return err();
     }
 
-    auto data = allocate<uint8_t>(static_array_value.elements.length);
-    for(size_t i = 0; i < static_array_value.elements.length; i += 1) {
-        auto element_value = static_array_value.elements[i];
+    uint8_t* data;
+    if(static_array_value.is_packed) {
+        data = static_array_value.packed.bytes;
+    } else {
+        data = allocate<uint8_t>(static_array_value.length);
+        for(size_t i = 0; i < static_array_value.length; i += 1) {
+            auto element_value = static_array_value.elements[i];
 
-        if(element_value.kind == ConstantValueKind::UndefConstant) {
-            error(scope, range, "String array is partially undefined, at element %zu", i);
+            if(element_value.kind == ConstantValueKind::UndefConstant) {
+                error(scope, range, "String array is partially undefined, at element %zu", i);
 
-            return err();
-        }
+                return err();
+            }
 
-        data[i] = (uint8_t)element_value.unwrap_integer();
+            data[i] = (uint8_t)element_value.unwrap_integer();
+        }
     }
 
-    if(!validate_utf8_string(data, static_array_value.elements.length).status) {
+    if(!validate_utf8_string(data, static_array_value.length).status) {
         error(scope, range, "String value is not valid UTF-8");
 
         return err();
     }
 
     String string {};
-    string.length = static_array_value.elements.length;
+    string.length = static_array_value.length;
     string.elements = (char8_t*)data;
 
     return ok(string);
 }
 
+AnyConstantValue StaticArrayConstant::get_element(size_t index) {
+    assert(index < length);
+
+    if(is_packed) {
+        return AnyConstantValue(read_packed_integer(packed.bytes, packed.element_size, packed.is_signed, index));
+    } else {
+        return elements[index];
+    }
+}
+
+StaticArrayConstant create_static_array_constant(AnyType element_type, Array<AnyConstantValue> elements) {
+    if(element_type.kind != TypeKind::Integer) {
+        return StaticArrayConstant(elements);
+    }
+
+    for(auto element : elements) {
+        if(element.kind != ConstantValueKind::IntegerConstant) {
+            return StaticArrayConstant(elements);
+        }
+    }
+
+    auto integer = element_type.integer;
+
+    auto bytes = allocate<uint8_t>(elements.length * register_size_to_byte_size(integer.size));
+
+    for(size_t i = 0; i < elements.length; i += 1) {
+        write_packed_integer(bytes, integer.size, i, elements[i].integer);
+    }
+
+    free(elements.elements);
+
+    return StaticArrayConstant(elements.length, integer.size, integer.is_signed, bytes);
+}
+
 profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expression, (
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     ConstantScope* scope,
     Statement* ignore_statement,
     Expression* expression
@@ -2349,7 +2484,7 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
     if(expression->kind == ExpressionKind::NamedReference) {
         auto named_reference = (NamedReference*)expression;
 
-        auto name_hash = calculate_string_hash(named_reference->name.text);
+        auto name_hash = named_reference->name.hash;
 
         auto current_scope = scope;
         while(true) {
@@ -2360,7 +2495,7 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
                 name_hash,
                 current_scope,
                 current_scope->statements,
-                current_scope->declarations,
+                &current_scope->declarations,
                 false,
                 ignore_statement
             ));
@@ -2380,7 +2515,7 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
         }
 
         for(auto global_constant : info.global_constants) {
-            if(named_reference->name.text == global_constant.name) {
+            if(symbols_equal(named_reference->name.text, global_constant.name)) {
                 return ok(TypedConstantValue(
                     global_constant.type,
                     global_constant.value
@@ -2437,7 +2572,7 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
                             info.architecture_sizes.address_size,
                             false
                         )),
-                        AnyConstantValue(static_array_value.elements.length)
+                        AnyConstantValue(static_array_value.length)
                     ));
                 } else if(member_reference->name.text == u8"pointer"_S) {
                     error(scope, member_reference->name.range, "Cannot take pointer to array with constant elements in constant context", member_reference->name.text);
@@ -2510,10 +2645,10 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
                 info,
                 jobs,
                 member_reference->name.text,
-                calculate_string_hash(member_reference->name.text),
+                member_reference->name.hash,
                 file_module_value.scope,
                 file_module_value.scope->statements,
-                file_module_value.scope->declarations,
+                &file_module_value.scope->declarations,
                 true,
                 nullptr
             ));
@@ -2535,7 +2670,7 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
                 auto enum_ = type.enum_;
 
                 for(size_t i = 0; i < enum_.variant_values.length; i += 1) {
-                    if(enum_.definition->variants[i].name.text == member_reference->name.text) {
+                    if(symbols_equal(enum_.definition->variants[i].name.text, member_reference->name.text)) {
                         return ok(TypedConstantValue(
                             type,
                             AnyConstantValue(enum_.variant_values[i])
@@ -2605,22 +2740,19 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
 
         auto character_count = string_literal->characters.length;
 
-        auto characters = allocate<AnyConstantValue>(character_count);
-
-        for(size_t i = 0; i < character_count; i += 1) {
-            characters[i] = AnyConstantValue((uint64_t)string_literal->characters[i]);
-        }
-
         return ok(TypedConstantValue(
             AnyType(StaticArray(
                 character_count,
-                heapify(AnyType(Integer(
+                intern_type(AnyType(Integer(
                     RegisterSize::Size8,
                     false
                 )))
             )),
             AnyConstantValue(StaticArrayConstant(
-                Array(character_count, characters)
+                character_count,
+                RegisterSize::Size8,
+                false,
+                (uint8_t*)string_literal->characters.elements
             ))
         ));
     } else if(expression->kind == ExpressionKind::ArrayLiteral) {
@@ -2666,9 +2798,10 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
         return ok(TypedConstantValue(
             AnyType(StaticArray(
                 element_count,
-                heapify(determined_element_type)
+                intern_type(determined_element_type)
             )),
-            AnyConstantValue(StaticArrayConstant(
+            AnyConstantValue(create_static_array_constant(
+                determined_element_type,
                 Array(element_count, elements)
             ))
         ));
@@ -2872,32 +3005,21 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
                     parameters[i] = parameter_value;
                 }
 
-                for(size_t i = 0; i < jobs->length; i += 1) {
-                    auto job = (*jobs)[i];
+                jobs->lock();
 
-                    if(job.kind == JobKind::ResolvePolymorphicStruct) {
-                        auto resolve_polymorphic_struct = job.resolve_polymorphic_struct;
+                size_t job_index;
+                if(jobs->find_polymorphic_struct(definition, parameters, &job_index)) {
+                    jobs->unlock();
 
-                        if(resolve_polymorphic_struct.definition == definition) {
-                            auto same_parameters = true;
-                            for(size_t i = 0; i < parameter_count; i += 1) {
-                                if(!constant_values_equal(parameters[i], resolve_polymorphic_struct.parameters[i])) {
-                                    same_parameters = false;
-                                    break;
-                                }
-                            }
+                    auto job = &(*jobs)[job_index];
 
-                            if(same_parameters) {
-                                if(job.state == JobState::Done) {
-                                    return ok(TypedConstantValue(
-                                        AnyType::create_type_type(),
-                                        AnyConstantValue(resolve_polymorphic_struct.type)
-                                    ));
-                                } else {
-                                    return wait(i);
-                                }
-                            }
-                        }
+                    if(get_job_state(job) == JobState::Done) {
+                        return ok(TypedConstantValue(
+                            AnyType::create_type_type(),
+                            AnyConstantValue(job->resolve_polymorphic_struct.type)
+                        ));
+                    } else {
+                        return wait(job_index);
                     }
                 }
 
@@ -2908,7 +3030,9 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
                 job.resolve_polymorphic_struct.parameters = parameters;
                 job.resolve_polymorphic_struct.scope = polymorphic_struct.parent;
 
-                auto job_index = jobs->append(job);
+                job_index = jobs->append(job);
+
+                jobs->unlock();
 
                 return wait(job_index);
             } else if(type.kind == TypeKind::PolymorphicUnion) {
@@ -2942,32 +3066,21 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
                     parameters[i] = parameter_value;
                 }
 
-                for(size_t i = 0; i < jobs->length; i += 1) {
-                    auto job = (*jobs)[i];
+                jobs->lock();
 
-                    if(job.kind == JobKind::ResolvePolymorphicUnion) {
-                        auto resolve_polymorphic_union = job.resolve_polymorphic_union;
+                size_t job_index;
+                if(jobs->find_polymorphic_union(definition, parameters, &job_index)) {
+                    jobs->unlock();
 
-                        if(resolve_polymorphic_union.definition == definition) {
-                            auto same_parameters = true;
-                            for(size_t i = 0; i < parameter_count; i += 1) {
-                                if(!constant_values_equal(parameters[i], resolve_polymorphic_union.parameters[i])) {
-                                    same_parameters = false;
-                                    break;
-                                }
-                            }
+                    auto job = &(*jobs)[job_index];
 
-                            if(same_parameters) {
-                                if(job.state == JobState::Done) {
-                                    return ok(TypedConstantValue(
-                                        AnyType::create_type_type(),
-                                        AnyConstantValue(resolve_polymorphic_union.type)
-                                    ));
-                                } else {
-                                    return wait(i);
-                                }
-                            }
-                        }
+                    if(get_job_state(job) == JobState::Done) {
+                        return ok(TypedConstantValue(
+                            AnyType::create_type_type(),
+                            AnyConstantValue(job->resolve_polymorphic_union.type)
+                        ));
+                    } else {
+                        return wait(job_index);
                     }
                 }
 
@@ -2978,7 +3091,9 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
                 job.resolve_polymorphic_union.parameters = parameters;
                 job.resolve_polymorphic_union.scope = polymorphic_union.parent;
 
-                auto job_index = jobs->append(job);
+                job_index = jobs->append(job);
+
+                jobs->unlock();
 
                 return wait(job_index);
             } else {
@@ -3038,7 +3153,7 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
                         AnyType::create_type_type(),
                         AnyConstantValue(
                             AnyType(Pointer(
-                                heapify(type)
+                                intern_type(type)
                             ))
                         )
                     ));
@@ -3152,52 +3267,26 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
                 return err();
             }
 
-            for(size_t i = 0; i < jobs->length; i += 1) {
-                auto job = (*jobs)[i];
+            jobs->lock();
 
-                if(job.kind == JobKind::ResolvePolymorphicFunction) {
-                    auto resolve_polymorphic_function = job.resolve_polymorphic_function;
-
-                    if(
-                        resolve_polymorphic_function.declaration == polymorphic_function_value.declaration &&
-                        resolve_polymorphic_function.scope == polymorphic_function_value.scope
-                    ) {
-                        auto matching_polymorphic_parameters = true;
-                        for(size_t i = 0; i < declaration_parameter_count; i += 1) {
-                            auto declaration_parameter = declaration_parameters[i];
-                            auto call_parameter = parameters[i];
-                            auto job_parameter = resolve_polymorphic_function.parameters[i];
-
-                            if(
-                                (declaration_parameter.is_polymorphic_determiner || declaration_parameter.is_constant) &&
-                                job_parameter.type != call_parameter.type
-                            ) {
-                                matching_polymorphic_parameters = false;
-                                break;
-                            }
+            size_t job_index;
+            if(jobs->find_polymorphic_function(
+                polymorphic_function_value.declaration,
+                polymorphic_function_value.scope,
+                parameters,
+                &job_index
+            )) {
+                jobs->unlock();
 
-                            if(
-                                declaration_parameter.is_constant &&
-                                !constant_values_equal(call_parameter.value, job_parameter.value)
-                            ) {
-                                matching_polymorphic_parameters = false;
-                                break;
-                            }
-                        }
+                auto job = &(*jobs)[job_index];
 
-                        if(!matching_polymorphic_parameters) {
-                            continue;
-                        }
-
-                        if(job.state == JobState::Done) {
-                            return ok(TypedConstantValue(
-                                AnyType(resolve_polymorphic_function.type),
-                                AnyConstantValue(resolve_polymorphic_function.value)
-                            ));
-                        } else {
-                            return wait(i);
-                        }  
-                    }
+                if(get_job_state(job) == JobState::Done) {
+                    return ok(TypedConstantValue(
+                        AnyType(job->resolve_polymorphic_function.type),
+                        AnyConstantValue(job->resolve_polymorphic_function.value)
+                    ));
+                } else {
+                    return wait(job_index);
                 }
             }
 
@@ -3216,7 +3305,9 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
             job.resolve_polymorphic_function.call_scope = scope;
             job.resolve_polymorphic_function.call_parameter_ranges = call_parameter_ranges;
 
-            auto job_index = jobs->append(job);
+            job_index = jobs->append(job);
+
+            jobs->unlock();
 
             return wait(job_index);
         } else if(expression_value.type.kind == TypeKind::FunctionTypeType) {
@@ -3284,7 +3375,7 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
                 AnyConstantValue(
                     AnyType(StaticArray(
                         length_integer,
-                        heapify(type)
+                        intern_type(type)
                     ))
                 )
             ));
@@ -3293,7 +3384,7 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
                 AnyType::create_type_type(),
                 AnyConstantValue(
                     AnyType(ArrayTypeType(
-                        heapify(type)
+                        intern_type(type)
                     ))
                 )
             ));
@@ -3402,7 +3493,7 @@ profiled_function(DelayedResult<TypedConstantValue>, evaluate_constant_expressio
 
 DelayedResult<AnyType> evaluate_type_expression(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     ConstantScope* scope,
     Statement* ignore_statement,
     Expression* expression
@@ -3418,7 +3509,7 @@ DelayedResult<AnyType> evaluate_type_expression(
     }
 }
 
-DelayedResult<StaticIfResolutionResult> do_resolve_static_if(GlobalInfo info, List<AnyJob>* jobs, StaticIf* static_if, ConstantScope* scope) {
+DelayedResult<StaticIfResolutionResult> do_resolve_static_if(GlobalInfo info, JobList* jobs, StaticIf* static_if, ConstantScope* scope) {
     expect_delayed(condition, evaluate_constant_expression(info, jobs, scope, static_if, static_if->condition));
 
     if(condition.type.kind != TypeKind::Boolean) {
@@ -3455,7 +3546,7 @@ DelayedResult<StaticIfResolutionResult> do_resolve_static_if(GlobalInfo info, Li
 
 profiled_function(DelayedResult<TypedConstantValue>, do_resolve_function_declaration, (
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     FunctionDeclaration* declaration,
     ConstantScope* scope
 ), (
@@ -3528,8 +3619,8 @@ profiled_function(DelayedResult<TypedConstantValue>, do_resolve_function_declara
                         if(parameter.value.kind == ConstantValueKind::StaticArrayConstant) {
                             auto static_array_value = (parameter.value.unwrap_static_array());
 
-                            for(auto element : static_array_value.elements) {
-                                expect(library_path, array_to_string(scope, tag.parameters[i]->range, *array.element_type, element));
+                            for(size_t j = 0; j < static_array_value.length; j += 1) {
+                                expect(library_path, array_to_string(scope, tag.parameters[i]->range, *array.element_type, static_array_value.elements[j]));
 
                                 libraries.append(library_path);
                             }
@@ -3558,10 +3649,10 @@ profiled_function(DelayedResult<TypedConstantValue>, do_resolve_function_declara
 
                         auto static_array_value = (parameter.value.unwrap_static_array());
 
-                        assert(static_array.length == static_array_value.elements.length);
+                        assert(static_array.length == static_array_value.length);
 
-                        for(auto element : static_array_value.elements) {
-                            expect(library_path, array_to_string(scope, tag.parameters[i]->range, *static_array.element_type, element));
+                        for(size_t j = 0; j < static_array_value.length; j += 1) {
+                            expect(library_path, array_to_string(scope, tag.parameters[i]->range, *static_array.element_type, static_array_value.elements[j]));
 
                             libraries.append(library_path);
                         }
@@ -3692,7 +3783,7 @@ profiled_function(DelayedResult<TypedConstantValue>, do_resolve_function_declara
 
 profiled_function(DelayedResult<FunctionResolutionResult>, do_resolve_polymorphic_function, (
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     FunctionDeclaration* declaration,
     TypedConstantValue* parameters,
     ConstantScope* scope,
@@ -3896,7 +3987,7 @@ profiled_function(DelayedResult<FunctionResolutionResult>, do_resolve_polymorphi
 
 profiled_function(DelayedResult<AnyType>, do_resolve_struct_definition, (
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     StructDefinition* struct_definition,
     ConstantScope* scope
 ), (
@@ -3967,7 +4058,7 @@ profiled_function(DelayedResult<AnyType>, do_resolve_struct_definition, (
 
 profiled_function(DelayedResult<AnyType>, do_resolve_polymorphic_struct, (
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     StructDefinition* struct_definition,
     AnyConstantValue* parameters,
     ConstantScope* scope
@@ -4036,7 +4127,7 @@ profiled_function(DelayedResult<AnyType>, do_resolve_polymorphic_struct, (
 
 profiled_function(DelayedResult<AnyType>, do_resolve_union_definition, (
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     UnionDefinition* union_definition,
     ConstantScope* scope
 ), (
@@ -4107,7 +4198,7 @@ profiled_function(DelayedResult<AnyType>, do_resolve_union_definition, (
 
 profiled_function(DelayedResult<AnyType>, do_resolve_polymorphic_union, (
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     UnionDefinition* union_definition,
     AnyConstantValue* parameters,
     ConstantScope* scope
@@ -4175,7 +4266,7 @@ profiled_function(DelayedResult<AnyType>, do_resolve_polymorphic_union, (
 }
 
 profiled_function(Result<void>, process_scope, (
-    List<AnyJob>* jobs,
+    JobList* jobs,
     ConstantScope* scope,
     Array<Statement*> statements,
     List<ConstantScope*>* child_scopes,
@@ -4365,21 +4456,10 @@ profiled_function(Result<void>, process_scope, (
             case StatementKind::Import: {
                 auto import = (Import*)statement;
 
-                auto job_already_added = false;
-                for(size_t i = 0; i < jobs->length; i += 1) {
-                    auto job = (*jobs)[i];
+                jobs->lock();
 
-                    if(job.kind == JobKind::ParseFile) {
-                        auto parse_file = job.parse_file;
-
-                        if(parse_file.path == import->absolute_path) {
-                            job_already_added = true;
-                            break;
-                        }
-                    }
-                }
-
-                if(!job_already_added) {
+                size_t job_index;
+                if(!jobs->find_parse_file(import->absolute_path, &job_index)) {
                     AnyJob job;
                     job.kind = JobKind::ParseFile;
                     job.state = JobState::Working;
@@ -4387,6 +4467,8 @@ profiled_function(Result<void>, process_scope, (
 
                     jobs->append(job);
                 }
+
+                jobs->unlock();
             } break;
 
             case StatementKind::UsingStatement: break;
@@ -4418,7 +4500,7 @@ profiled_function(Result<void>, process_scope, (
 
 profiled_function(DelayedResult<Enum>, do_resolve_enum_definition, (
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     EnumDefinition* enum_definition,
     ConstantScope* scope
 ), (
@@ -4429,7 +4511,7 @@ profiled_function(DelayedResult<Enum>, do_resolve_enum_definition, (
 )) {
     Integer backing_type;
     if(enum_definition->backing_type != nullptr) {
-        expect(type, evaluate_type_expression(
+        expect_delayed(type, evaluate_type_expression(
             info,
             jobs,
             scope,
@@ -7,7 +7,7 @@
 #include "platform.h"
 #include "list.h"
 
-struct AnyJob;
+struct JobList;
 struct ConstantScope;
 struct AnyConstantValue;
 
@@ -64,9 +64,29 @@ struct ArrayConstant {
 
 struct StaticArrayConstant {
     inline StaticArrayConstant() = default;
-    explicit inline StaticArrayConstant(Array<AnyConstantValue> elements) : elements(elements) {}
+    explicit inline StaticArrayConstant(Array<AnyConstantValue> elements) : length(elements.length), is_packed(false), elements(elements.elements) {}
+    explicit inline StaticArrayConstant(size_t length, RegisterSize element_size, bool is_signed, uint8_t* bytes) : length(length), is_packed(true) {
+        packed.element_size = element_size;
+        packed.is_signed = is_signed;
+        packed.bytes = bytes;
+    }
+
+    size_t length;
+
+    // Fully-defined integer arrays (e.g. strings) keep their raw bytes rather than an AnyConstantValue per element
+    bool is_packed;
 
-    Array<AnyConstantValue> elements;
+    union {
+        AnyConstantValue* elements;
+
+        struct {
+            RegisterSize element_size;
+            bool is_signed;
+            uint8_t* bytes;
+        } packed;
+    };
+
+    AnyConstantValue get_element(size_t index);
 };
 
 struct StructConstant {
@@ -213,16 +233,21 @@ struct AnyConstantValue {
     String get_description();
 };
 
-const size_t DECLARATION_HASH_TABLE_SIZE = 32;
+struct DeclarationHashTableEntry {
+    String name;
+    uint32_t hash;
+
+    Statement* declaration;
+};
 
+// Open addressing table of the named declarations in a block, sized to fit them when it is created
 struct DeclarationHashTable {
-    List<Statement*> buckets[DECLARATION_HASH_TABLE_SIZE];
+    DeclarationHashTableEntry* entries;
+    size_t capacity;
 };
 
-uint32_t calculate_string_hash(String string);
 DeclarationHashTable create_declaration_hash_table(Array<Statement*> statements);
-Statement* search_in_declaration_hash_table(DeclarationHashTable declaration_hash_table, String name);
-Statement* search_in_declaration_hash_table(DeclarationHashTable declaration_hash_table, uint32_t hash, String name);
+Statement* search_in_declaration_hash_table(DeclarationHashTable* declaration_hash_table, uint32_t hash, String name);
 
 struct ScopeConstant {
     String name;
@@ -345,6 +370,7 @@ inline DelayedResultWaitHelper wait(size_t job) {
 void error(ConstantScope* scope, FileRange range, const char* format, ...);
 
 Result<String> array_to_string(ConstantScope* scope, FileRange range, AnyType type, AnyConstantValue value);
+StaticArrayConstant create_static_array_constant(AnyType element_type, Array<AnyConstantValue> elements);
 
 Result<void> check_undetermined_integer_to_integer_coercion(ConstantScope* scope, FileRange range, Integer target_type, uint64_t value, bool probing);
 Result<AnyConstantValue> coerce_constant_to_integer_type(
@@ -399,7 +425,7 @@ Result<AnyConstantValue> evaluate_constant_cast(
 );
 DelayedResult<AnyType> evaluate_type_expression(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     ConstantScope* scope,
     Statement* ignore_statement,
     Expression* expression
@@ -410,11 +436,12 @@ bool does_or_could_have_public_name(Statement* statement, String name);
 bool does_or_could_have_name(Statement* statement, String name);
 DelayedResult<TypedConstantValue> get_simple_resolved_declaration(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     ConstantScope* scope,
     Statement* declaration
 );
 bool constant_values_equal(AnyConstantValue a, AnyConstantValue b);
+uint64_t calculate_constant_value_hash(AnyConstantValue value);
 
 struct NameSearchResult {
     bool found;
@@ -425,19 +452,19 @@ struct NameSearchResult {
 
 DelayedResult<NameSearchResult> search_for_name(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     String name,
     uint32_t name_hash,
     ConstantScope* scope,
     Array<Statement*> statements,
-    DeclarationHashTable declarations,
+    DeclarationHashTable* declarations,
     bool external,
     Statement* ignore
 );
 
 DelayedResult<TypedConstantValue> evaluate_constant_expression(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     ConstantScope* scope,
     Statement* ignore_statement,
     Expression* expression
@@ -449,11 +476,11 @@ struct StaticIfResolutionResult {
     DeclarationHashTable declarations;
 };
 
-DelayedResult<StaticIfResolutionResult> do_resolve_static_if(GlobalInfo info, List<AnyJob>* jobs, StaticIf* static_if, ConstantScope* scope);
+DelayedResult<StaticIfResolutionResult> do_resolve_static_if(GlobalInfo info, JobList* jobs, StaticIf* static_if, ConstantScope* scope);
 
 DelayedResult<TypedConstantValue> do_resolve_function_declaration(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     FunctionDeclaration* declaration,
     ConstantScope* scope
 );
@@ -466,7 +493,7 @@ struct FunctionResolutionResult {
 
 DelayedResult<FunctionResolutionResult> do_resolve_polymorphic_function(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     FunctionDeclaration* declaration,
     TypedConstantValue* parameters,
     ConstantScope* scope,
@@ -476,14 +503,14 @@ DelayedResult<FunctionResolutionResult> do_resolve_polymorphic_function(
 
 DelayedResult<AnyType> do_resolve_struct_definition(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     StructDefinition* struct_definition,
     ConstantScope* scope
 );
 
 DelayedResult<AnyType> do_resolve_polymorphic_struct(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     StructDefinition* struct_definition,
     AnyConstantValue* parameters,
     ConstantScope* scope
@@ -491,14 +518,14 @@ DelayedResult<AnyType> do_resolve_polymorphic_struct(
 
 DelayedResult<AnyType> do_resolve_union_definition(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     UnionDefinition* union_definition,
     ConstantScope* scope
 );
 
 DelayedResult<AnyType> do_resolve_polymorphic_union(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     UnionDefinition* union_definition,
     AnyConstantValue* parameters,
     ConstantScope* scope
@@ -506,9 +533,9 @@ DelayedResult<AnyType> do_resolve_polymorphic_union(
 
 DelayedResult<Enum> do_resolve_enum_definition(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     EnumDefinition* enum_definition,
     ConstantScope* scope
 );
 
-Result<void> process_scope(List<AnyJob>* jobs, ConstantScope* scope, Array<Statement*> statements, List<ConstantScope*>* child_scopes, bool is_top_level);
\ No newline at end of file
+Result<void> process_scope(JobList* jobs, ConstantScope* scope, Array<Statement*> statements, List<ConstantScope*>* child_scopes, bool is_top_level);
\ No newline at end of file
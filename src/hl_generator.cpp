@@ -13,6 +13,7 @@
 #include "constant.h"
 #include "types.h"
 #include "jobs.h"
+#include "arena.h"
 
 struct AnyRuntimeValue;
 
@@ -106,6 +107,8 @@ struct VariableScope {
 };
 
 struct GenerationContext {
+    Arena* arena;
+
     Array<AnyType> return_types;
 
     Array<ConstantScope*> child_scopes;
@@ -132,7 +135,7 @@ static Result<void> add_new_variable(GenerationContext* context, Identifier name
     auto variable_scope = &(context->variable_scope_stack[context->variable_scope_stack.length - 1]);
 
     for(auto variable : variable_scope->variables) {
-        if(variable.name.text == name.text) {
+        if(symbols_equal(variable.name.text, name.text)) {
             error(variable_scope->constant_scope, name.range, "Duplicate variable name %.*s", STRING_PRINTF_ARGUMENTS(name.text));
             error(variable_scope->constant_scope, variable.name.range, "Original declared here");
 
@@ -179,7 +182,7 @@ static size_t append_integer_arithmetic_operation(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto integer_arithmetic_operation = new IntegerArithmeticOperation;
+    auto integer_arithmetic_operation = new(context->arena) IntegerArithmeticOperation;
     integer_arithmetic_operation->range = range;
     integer_arithmetic_operation->debug_scope_index = current_variable_scope.debug_scope_index;
     integer_arithmetic_operation->operation = operation;
@@ -204,7 +207,7 @@ static size_t append_integer_comparison_operation(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto integer_comparison_operation = new IntegerComparisonOperation;
+    auto integer_comparison_operation = new(context->arena) IntegerComparisonOperation;
     integer_comparison_operation->range = range;
     integer_comparison_operation->debug_scope_index = current_variable_scope.debug_scope_index;
     integer_comparison_operation->operation = operation;
@@ -229,7 +232,7 @@ static size_t append_integer_extension(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto integer_extension = new IntegerExtension;
+    auto integer_extension = new(context->arena) IntegerExtension;
     integer_extension->range = range;
     integer_extension->debug_scope_index = current_variable_scope.debug_scope_index;
     integer_extension->is_signed = is_signed;
@@ -253,7 +256,7 @@ static size_t append_integer_truncation(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto integer_truncation = new IntegerTruncation;
+    auto integer_truncation = new(context->arena) IntegerTruncation;
     integer_truncation->range = range;
     integer_truncation->debug_scope_index = current_variable_scope.debug_scope_index;
     integer_truncation->source_register = source_register;
@@ -277,7 +280,7 @@ static size_t append_float_arithmetic_operation(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto float_arithmetic_operation = new FloatArithmeticOperation;
+    auto float_arithmetic_operation = new(context->arena) FloatArithmeticOperation;
     float_arithmetic_operation->range = range;
     float_arithmetic_operation->debug_scope_index = current_variable_scope.debug_scope_index;
     float_arithmetic_operation->operation = operation;
@@ -302,7 +305,7 @@ static size_t append_float_comparison_operation(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto float_comparison_operation = new FloatComparisonOperation;
+    auto float_comparison_operation = new(context->arena) FloatComparisonOperation;
     float_comparison_operation->range = range;
     float_comparison_operation->debug_scope_index = current_variable_scope.debug_scope_index;
     float_comparison_operation->operation = operation;
@@ -326,7 +329,7 @@ static size_t append_float_conversion(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto float_conversion = new FloatConversion;
+    auto float_conversion = new(context->arena) FloatConversion;
     float_conversion->range = range;
     float_conversion->debug_scope_index = current_variable_scope.debug_scope_index;
     float_conversion->source_register = source_register;
@@ -350,7 +353,7 @@ static size_t append_float_from_integer(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto float_from_integer = new FloatFromInteger;
+    auto float_from_integer = new(context->arena) FloatFromInteger;
     float_from_integer->range = range;
     float_from_integer->debug_scope_index = current_variable_scope.debug_scope_index;
     float_from_integer->is_signed = is_signed;
@@ -375,7 +378,7 @@ static size_t append_integer_from_float(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto integer_from_float = new IntegerFromFloat;
+    auto integer_from_float = new(context->arena) IntegerFromFloat;
     integer_from_float->range = range;
     integer_from_float->debug_scope_index = current_variable_scope.debug_scope_index;
     integer_from_float->is_signed = is_signed;
@@ -399,7 +402,7 @@ static size_t append_pointer_equality(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto pointer_equality = new PointerEquality;
+    auto pointer_equality = new(context->arena) PointerEquality;
     pointer_equality->range = range;
     pointer_equality->debug_scope_index = current_variable_scope.debug_scope_index;
     pointer_equality->source_register_a = source_register_a;
@@ -421,7 +424,7 @@ static size_t append_pointer_from_integer(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto pointer_from_integer = new PointerFromInteger;
+    auto pointer_from_integer = new(context->arena) PointerFromInteger;
     pointer_from_integer->range = range;
     pointer_from_integer->debug_scope_index = current_variable_scope.debug_scope_index;
     pointer_from_integer->source_register = source_register;
@@ -443,7 +446,7 @@ static size_t append_integer_from_pointer(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto integer_from_pointer = new IntegerFromPointer;
+    auto integer_from_pointer = new(context->arena) IntegerFromPointer;
     integer_from_pointer->range = range;
     integer_from_pointer->debug_scope_index = current_variable_scope.debug_scope_index;
     integer_from_pointer->source_register = source_register;
@@ -467,7 +470,7 @@ static size_t append_boolean_arithmetic_operation(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto boolean_arithmetic_operation = new BooleanArithmeticOperation;
+    auto boolean_arithmetic_operation = new(context->arena) BooleanArithmeticOperation;
     boolean_arithmetic_operation->range = range;
     boolean_arithmetic_operation->debug_scope_index = current_variable_scope.debug_scope_index;
     boolean_arithmetic_operation->operation = operation;
@@ -491,7 +494,7 @@ static size_t append_boolean_equality(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto boolean_equality = new BooleanEquality;
+    auto boolean_equality = new(context->arena) BooleanEquality;
     boolean_equality->range = range;
     boolean_equality->debug_scope_index = current_variable_scope.debug_scope_index;
     boolean_equality->source_register_a = source_register_a;
@@ -513,7 +516,7 @@ static size_t append_boolean_inversion(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto boolean_inversion = new BooleanInversion;
+    auto boolean_inversion = new(context->arena) BooleanInversion;
     boolean_inversion->range = range;
     boolean_inversion->debug_scope_index = current_variable_scope.debug_scope_index;
     boolean_inversion->source_register = source_register;
@@ -534,7 +537,7 @@ static size_t append_assemble_static_array(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto assembly_static_array = new AssembleStaticArray;
+    auto assembly_static_array = new(context->arena) AssembleStaticArray;
     assembly_static_array->range = range;
     assembly_static_array->debug_scope_index = current_variable_scope.debug_scope_index;
     assembly_static_array->element_registers = element_registers;
@@ -556,7 +559,7 @@ static size_t append_read_static_array_element(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto read_static_array_element = new ReadStaticArrayElement;
+    auto read_static_array_element = new(context->arena) ReadStaticArrayElement;
     read_static_array_element->range = range;
     read_static_array_element->debug_scope_index = current_variable_scope.debug_scope_index;
     read_static_array_element->element_index = element_index;
@@ -578,7 +581,7 @@ static size_t append_assemble_struct(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto assemble_struct = new AssembleStruct;
+    auto assemble_struct = new(context->arena) AssembleStruct;
     assemble_struct->range = range;
     assemble_struct->debug_scope_index = current_variable_scope.debug_scope_index;
     assemble_struct->member_registers = member_registers;
@@ -600,7 +603,7 @@ static size_t append_read_struct_member(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto read_read_struct_member = new ReadStructMember;
+    auto read_read_struct_member = new(context->arena) ReadStructMember;
     read_read_struct_member->range = range;
     read_read_struct_member->debug_scope_index = current_variable_scope.debug_scope_index;
     read_read_struct_member->member_index = member_index;
@@ -618,7 +621,7 @@ static size_t append_literal(GenerationContext* context, FileRange range, IRType
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto literal = new Literal;
+    auto literal = new(context->arena) Literal;
     literal->range = range;
     literal->debug_scope_index = current_variable_scope.debug_scope_index;
     literal->destination_register = destination_register;
@@ -634,7 +637,7 @@ static void append_jump(GenerationContext* context, FileRange range, Block* dest
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto jump = new Jump;
+    auto jump = new(context->arena) Jump;
     jump->range = range;
     jump->debug_scope_index = current_variable_scope.debug_scope_index;
     jump->destination_block = destination_block;
@@ -652,7 +655,7 @@ static void append_branch(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto branch = new Branch;
+    auto branch = new(context->arena) Branch;
     branch->range = range;
     branch->debug_scope_index = current_variable_scope.debug_scope_index;
     branch->condition_register = condition_register;
@@ -672,7 +675,7 @@ static size_t append_allocate_local(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto allocate_local = new AllocateLocal;
+    auto allocate_local = new(context->arena) AllocateLocal;
     allocate_local->range = range;
     allocate_local->debug_scope_index = current_variable_scope.debug_scope_index;
     allocate_local->type = type;
@@ -696,7 +699,7 @@ static size_t append_allocate_local(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto allocate_local = new AllocateLocal;
+    auto allocate_local = new(context->arena) AllocateLocal;
     allocate_local->range = range;
     allocate_local->debug_scope_index = current_variable_scope.debug_scope_index;
     allocate_local->type = type;
@@ -721,7 +724,7 @@ static size_t append_load(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto load = new Load;
+    auto load = new(context->arena) Load;
     load->range = range;
     load->debug_scope_index = current_variable_scope.debug_scope_index;
     load->pointer_register = pointer_register;
@@ -742,7 +745,7 @@ static void append_store(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto store = new Store;
+    auto store = new(context->arena) Store;
     store->range = range;
     store->debug_scope_index = current_variable_scope.debug_scope_index;
     store->source_register = source_register;
@@ -763,7 +766,7 @@ static size_t append_struct_member_pointer(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto struct_member_pointer = new StructMemberPointer;
+    auto struct_member_pointer = new(context->arena) StructMemberPointer;
     struct_member_pointer->range = range;
     struct_member_pointer->debug_scope_index = current_variable_scope.debug_scope_index;
     struct_member_pointer->members = members;
@@ -788,7 +791,7 @@ static size_t append_pointer_index(
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto pointer_index = new PointerIndex;
+    auto pointer_index = new(context->arena) PointerIndex;
     pointer_index->range = range;
     pointer_index->debug_scope_index = current_variable_scope.debug_scope_index;
     pointer_index->index_register = index_register;
@@ -807,7 +810,7 @@ static size_t append_reference_static(GenerationContext* context, FileRange rang
     assert(context->variable_scope_stack.length != 0);
     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-    auto reference_static = new ReferenceStatic;
+    auto reference_static = new(context->arena) ReferenceStatic;
     reference_static->range = range;
     reference_static->debug_scope_index = current_variable_scope.debug_scope_index;
     reference_static->runtime_static = runtime_static;
@@ -889,13 +892,22 @@ inline IRConstantValue get_array_ir_constant_value(ArrayConstant array) {
 }
 
 inline IRConstantValue get_static_array_ir_constant_value(StaticArrayConstant static_array) {
-    auto elements = allocate<IRConstantValue>(static_array.elements.length);
+    if(static_array.is_packed) {
+        return IRConstantValue::create_packed_static_array(
+            static_array.length,
+            static_array.packed.element_size,
+            static_array.packed.is_signed,
+            static_array.packed.bytes
+        );
+    }
 
-    for(size_t i = 0; i < static_array.elements.length; i += 1) {
+    auto elements = allocate<IRConstantValue>(static_array.length);
+
+    for(size_t i = 0; i < static_array.length; i += 1) {
         elements[i] = get_runtime_ir_constant_value(static_array.elements[i]);
     }
 
-    return IRConstantValue::create_static_array(Array(static_array.elements.length, elements));
+    return IRConstantValue::create_static_array(Array(static_array.length, elements));
 }
 
 inline IRConstantValue get_struct_ir_constant_value(StructConstant struct_) {
@@ -939,7 +951,7 @@ static StaticConstant* register_static_constant(
     auto ir_type = get_ir_type(info.architecture_sizes, type);
     auto ir_value = get_runtime_ir_constant_value(value);
 
-    auto constant = new StaticConstant;
+    auto constant = new(context->arena) StaticConstant;
     constant->name = u8"static_constant"_S;
     constant->is_no_mangle = false;
     constant->path = get_scope_file_path(*scope);
@@ -1699,7 +1711,7 @@ static Result<RegisterValue> coerce_to_type_register(
 
 static DelayedResult<TypedRuntimeValue> generate_expression(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     ConstantScope* scope,
     GenerationContext* context,
     Expression* expression
@@ -1707,7 +1719,7 @@ static DelayedResult<TypedRuntimeValue> generate_expression(
 
 static DelayedResult<AnyType> evaluate_type_expression(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     ConstantScope* scope,
     GenerationContext* context,
     Expression* expression
@@ -1727,7 +1739,7 @@ static DelayedResult<AnyType> evaluate_type_expression(
 
 static DelayedResult<TypedRuntimeValue> generate_binary_operation(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     ConstantScope* scope,
     GenerationContext* context,
     FileRange range,
@@ -2228,7 +2240,7 @@ struct RuntimeNameSearchResult {
 
 static_profiled_function(DelayedResult<RuntimeNameSearchResult>, search_for_name, (
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     ConstantScope* scope,
     GenerationContext* context,
     String name,
@@ -2236,7 +2248,7 @@ static_profiled_function(DelayedResult<RuntimeNameSearchResult>, search_for_name
     ConstantScope* name_scope,
     FileRange name_range,
     Array<Statement*> statements,
-    DeclarationHashTable declarations,
+    DeclarationHashTable* declarations,
     bool external
 ), (
     info,
@@ -2291,7 +2303,7 @@ static_profiled_function(DelayedResult<RuntimeNameSearchResult>, search_for_name
                         name_scope,
                         name_range,
                         file_module.scope->statements,
-                        file_module.scope->declarations,
+                        &file_module.scope->declarations,
                         true
                     ));
 
@@ -2310,7 +2322,7 @@ static_profiled_function(DelayedResult<RuntimeNameSearchResult>, search_for_name
                         auto enum_ = type.enum_;
 
                         for(size_t i = 0; i < enum_.variant_values.length; i += 1) {
-                            if(enum_.definition->variants[i].name.text == name) {
+                            if(symbols_equal(enum_.definition->variants[i].name.text, name)) {
                                 RuntimeNameSearchResult result {};
                                 result.found = true;
                                 result.type = AnyType(*enum_.backing_type);
@@ -2333,103 +2345,90 @@ static_profiled_function(DelayedResult<RuntimeNameSearchResult>, search_for_name
         } else if(statement->kind == StatementKind::StaticIf) {
             auto static_if = (StaticIf*)statement;
 
-            auto found = false;
-            for(size_t i = 0; i < jobs->length; i += 1) {
-                auto job = (*jobs)[i];
+            size_t job_index;
+            if(!jobs->find(JobKind::ResolveStaticIf, static_if, scope, &job_index)) {
+                abort();
+            }
 
-                if(job.kind == JobKind::ResolveStaticIf) {
-                    auto resolve_static_if = job.resolve_static_if;
+            auto job = &(*jobs)[job_index];
+            auto resolve_static_if = &job->resolve_static_if;
 
-                    if(
-                        resolve_static_if.static_if == static_if &&
-                        resolve_static_if.scope == scope
-                    ) {
-                        found = true;
-
-                        if(job.state == JobState::Done) {
-                            if(resolve_static_if.condition) {
-                                expect_delayed(search_value, search_for_name(
-                                    info,
-                                    jobs,
-                                    scope,
-                                    context,
-                                    name,
-                                    name_hash,
-                                    name_scope,
-                                    name_range,
-                                    static_if->statements,
-                                    resolve_static_if.declarations,
-                                    false
-                                ));
-
-                                if(search_value.found) {
-                                    RuntimeNameSearchResult result {};
-                                    result.found = true;
-                                    result.type = search_value.type;
-                                    result.value = search_value.value;
-
-                                    return ok(result);
-                                }
-                            }
-                        } else {
-                            bool could_have_declaration;
-                            if(external) {
-                                could_have_declaration = does_or_could_have_public_name(static_if, name);
-                            } else {
-                                could_have_declaration = does_or_could_have_name(static_if, name);
-                            }
+            if(get_job_state(job) == JobState::Done) {
+                if(resolve_static_if->condition) {
+                    expect_delayed(search_value, search_for_name(
+                        info,
+                        jobs,
+                        scope,
+                        context,
+                        name,
+                        name_hash,
+                        name_scope,
+                        name_range,
+                        static_if->statements,
+                        &resolve_static_if->declarations,
+                        false
+                    ));
 
-                            if(could_have_declaration) {
-                                return wait(i);
-                            }
-                        }
+                    if(search_value.found) {
+                        RuntimeNameSearchResult result {};
+                        result.found = true;
+                        result.type = search_value.type;
+                        result.value = search_value.value;
+
+                        return ok(result);
                     }
                 }
-            }
+            } else {
+                bool could_have_declaration;
+                if(external) {
+                    could_have_declaration = does_or_could_have_public_name(static_if, name);
+                } else {
+                    could_have_declaration = does_or_could_have_name(static_if, name);
+                }
 
-            assert(found);
+                if(could_have_declaration) {
+                    return wait(job_index);
+                }
+            }
         } else if(statement->kind == StatementKind::VariableDeclaration) {
             if(scope->is_top_level) {
                 auto variable_declaration = (VariableDeclaration*)statement;
 
-                if(variable_declaration->name.text == name) {
-                    for(size_t i = 0; i < jobs->length; i += 1) {
-                        auto job = (*jobs)[i];
+                if(symbols_equal(variable_declaration->name.text, name)) {
+                    size_t job_index;
+                    if(!jobs->find(JobKind::GenerateStaticVariable, variable_declaration, scope, &job_index)) {
+                        abort();
+                    }
 
-                        if(job.kind == JobKind::GenerateStaticVariable) {
-                            auto generate_static_variable = job.generate_static_variable;
+                    auto job = &(*jobs)[job_index];
 
-                            if(generate_static_variable.declaration == variable_declaration) {
-                                if(job.state == JobState::Done) {
-                                    auto pointer_register = append_reference_static(
-                                        context,
-                                        name_range,
-                                        generate_static_variable.static_variable
-                                    );
+                    if(get_job_state(job) == JobState::Done) {
+                        auto generate_static_variable = &job->generate_static_variable;
 
-                                    auto ir_type = get_ir_type(info.architecture_sizes, generate_static_variable.type);
+                        auto pointer_register = append_reference_static(
+                            context,
+                            name_range,
+                            generate_static_variable->static_variable
+                        );
 
-                                    RuntimeNameSearchResult result {};
-                                    result.found = true;
-                                    result.type = generate_static_variable.type;
-                                    result.value = AnyRuntimeValue(AddressedValue(ir_type, pointer_register));
+                        auto ir_type = get_ir_type(info.architecture_sizes, generate_static_variable->type);
 
-                                    return ok(result);
-                                } else {
-                                    return wait(i);
-                                }
-                            }
-                        }
-                    }
+                        RuntimeNameSearchResult result {};
+                        result.found = true;
+                        result.type = generate_static_variable->type;
+                        result.value = AnyRuntimeValue(AddressedValue(ir_type, pointer_register));
 
-                    abort();
+                        return ok(result);
+                    } else {
+                        return wait(job_index);
+                    }
                 }
             }
         }
     }
 
     for(auto scope_constant : scope->scope_constants) {
-        if(scope_constant.name == name) {
+        if(symbols_equal(scope_constant.name, name)) {
             RuntimeNameSearchResult result {};
             result.found = true;
             result.type = scope_constant.type;
@@ -2447,7 +2446,7 @@ static_profiled_function(DelayedResult<RuntimeNameSearchResult>, search_for_name
 
 static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression, (
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     ConstantScope* scope,
     GenerationContext* context,
     Expression* expression
@@ -2461,7 +2460,7 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
     if(expression->kind == ExpressionKind::NamedReference) {
         auto named_reference = (NamedReference*)expression;
 
-        auto name_hash = calculate_string_hash(named_reference->name.text);
+        auto name_hash = named_reference->name.hash;
 
         assert(context->variable_scope_stack.length > 0);
 
@@ -2469,7 +2468,7 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
             auto current_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1 - i];
 
             for(auto variable : current_scope.variables) {
-                if(variable.name.text == named_reference->name.text) {
+                if(symbols_equal(variable.name.text, named_reference->name.text)) {
                     return ok(TypedRuntimeValue(
                         variable.type,
                         AnyRuntimeValue(variable.value)
@@ -2487,7 +2486,7 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                 scope,
                 named_reference->name.range,
                 current_scope.constant_scope->statements,
-                current_scope.constant_scope->declarations,
+                &current_scope.constant_scope->declarations,
                 false
             ));
 
@@ -2513,7 +2512,7 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                 scope,
                 named_reference->name.range,
                 current_scope->statements,
-                current_scope->declarations,
+                &current_scope->declarations,
                 false
             ));
 
@@ -2532,7 +2531,7 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
         }
 
         for(auto global_constant : info.global_constants) {
-            if(named_reference->name.text == global_constant.name) {
+            if(symbols_equal(named_reference->name.text, global_constant.name)) {
                 return ok(TypedRuntimeValue(
                     global_constant.type,
                     AnyRuntimeValue(global_constant.value)
@@ -2740,7 +2739,7 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                     } else if(expression_value.value.constant.kind == ConstantValueKind::StaticArrayConstant) {
                         auto static_array_value = expression_value.value.constant.unwrap_static_array();
 
-                        value = AnyRuntimeValue(AnyConstantValue(static_array_value.elements.length));
+                        value = AnyRuntimeValue(AnyConstantValue(static_array_value.length));
                     } else {
                         assert(expression_value.value.constant.kind == ConstantValueKind::UndefConstant);
 
@@ -3052,11 +3051,11 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                 file_module_value.scope,
                 context,
                 member_reference->name.text,
-                calculate_string_hash(member_reference->name.text),
+                member_reference->name.hash,
                 scope,
                 member_reference->name.range,
                 file_module_value.scope->statements,
-                file_module_value.scope->declarations,
+                &file_module_value.scope->declarations,
                 true
             ));
 
@@ -3079,7 +3078,7 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                 auto enum_ = type.enum_;
 
                 for(size_t i = 0; i < enum_.variant_values.length; i += 1) {
-                    if(enum_.definition->variants[i].name.text == member_reference->name.text) {
+                    if(symbols_equal(enum_.definition->variants[i].name.text, member_reference->name.text)) {
                         return ok(TypedRuntimeValue(
                             type,
                             AnyRuntimeValue(AnyConstantValue(enum_.variant_values[i]))
@@ -3130,22 +3129,19 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
 
         auto character_count = string_literal->characters.length;
 
-        auto characters = allocate<AnyConstantValue>(character_count);
-
-        for(size_t i = 0; i < character_count; i += 1) {
-            characters[i] = AnyConstantValue((uint64_t)string_literal->characters[i]);
-        }
-
         return ok(TypedRuntimeValue(
             AnyType(StaticArray(
                 character_count,
-                heapify(AnyType(Integer(
+                intern_type(AnyType(Integer(
                     RegisterSize::Size8,
                     false
                 )))
             )),
             AnyRuntimeValue(AnyConstantValue(StaticArrayConstant(
-                Array(character_count, characters)
+                character_count,
+                RegisterSize::Size8,
+                false,
+                (uint8_t*)string_literal->characters.elements
             )))
         ));
     } else if(expression->kind == ExpressionKind::ArrayLiteral) {
@@ -3201,7 +3197,8 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                 element_values[i] = coerced_constant_value;
             }
 
-            value = AnyRuntimeValue(AnyConstantValue(StaticArrayConstant(
+            value = AnyRuntimeValue(AnyConstantValue(create_static_array_constant(
+                determined_element_type,
                 Array(element_count, element_values)
             )));
         } else {
@@ -3239,7 +3236,7 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
         return ok(TypedRuntimeValue(
             AnyType(StaticArray(
                 element_count,
-                heapify(determined_element_type)
+                intern_type(determined_element_type)
             )),
             value
         ));
@@ -3369,55 +3366,26 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                     }
                 }
 
-                auto found = false;
-                for(size_t i = 0; i < jobs->length; i += 1) {
-                    auto job = (*jobs)[i];
-
-                    if(job.kind == JobKind::ResolvePolymorphicFunction) {
-                        auto resolve_polymorphic_function = job.resolve_polymorphic_function;
-
-                        if(
-                            resolve_polymorphic_function.declaration == polymorphic_function_value.declaration &&
-                            resolve_polymorphic_function.scope == polymorphic_function_value.scope
-                        ) {
-                            auto matching_polymorphic_parameters = true;
-                            for(size_t i = 0; i < declaration_parameter_count; i += 1) {
-                                auto declaration_parameter = declaration_parameters[i];
-                                auto call_parameter = polymorphic_parameters[i];
-                                auto job_parameter = resolve_polymorphic_function.parameters[i];
-
-                                if(
-                                    (declaration_parameter.is_polymorphic_determiner || declaration_parameter.is_constant) &&
-                                    job_parameter.type != call_parameter.type
-                                ) {
-                                    matching_polymorphic_parameters = false;
-                                    break;
-                                }
-
-                                if(
-                                    declaration_parameter.is_constant &&
-                                    !constant_values_equal(call_parameter.value, job_parameter.value)
-                                ) {
-                                    matching_polymorphic_parameters = false;
-                                    break;
-                                }
-                            }
+                jobs->lock();
 
-                            if(!matching_polymorphic_parameters) {
-                                continue;
-                            }
+                size_t job_index;
+                auto found = jobs->find_polymorphic_function(
+                    polymorphic_function_value.declaration,
+                    polymorphic_function_value.scope,
+                    polymorphic_parameters,
+                    &job_index
+                );
 
-                            if(job.state == JobState::Done) {
-                                found = true;
+                if(found) {
+                    auto job = &(*jobs)[job_index];
 
-                                function_type = resolve_polymorphic_function.type;
-                                function_value = resolve_polymorphic_function.value;
+                    if(get_job_state(job) == JobState::Done) {
+                        function_type = job->resolve_polymorphic_function.type;
+                        function_value = job->resolve_polymorphic_function.value;
+                    } else {
+                        jobs->unlock();
 
-                                break;
-                            } else {
-                                return wait(i);
-                            }  
-                        }
+                        return wait(job_index);
                     }
                 }
 
@@ -3437,10 +3405,14 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                     job.resolve_polymorphic_function.call_scope = scope;
                     job.resolve_polymorphic_function.call_parameter_ranges = call_parameter_ranges;
 
-                    auto job_index = jobs->append(job);
+                    job_index = jobs->append(job);
+
+                    jobs->unlock();
 
                     return wait(job_index);
                 }
+
+                jobs->unlock();
             } else {
                 function_type = expression_value.type.function;
 
@@ -3461,29 +3433,13 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                 }
             }
 
-            auto found = false;
-            Function* runtime_function;
-            for(size_t i = 0; i < jobs->length; i += 1) {
-                auto job = (*jobs)[i];
-
-                if(job.kind == JobKind::GenerateFunction) {
-                    auto generate_function = job.generate_function;
-
-                    if(
-                        AnyType(generate_function.type) == AnyType(function_type) &&
-                        generate_function.value.declaration == function_value.declaration &&
-                        generate_function.value.body_scope == function_value.body_scope
-                    ) {
-                        found = true;
+            jobs->lock();
 
-                        runtime_function = generate_function.function;
-
-                        break;
-                    }
-                }
-            }
-
-            if(!found) {
+            size_t job_index;
+            Function* runtime_function;
+            if(jobs->find(JobKind::GenerateFunction, function_value.declaration, function_value.body_scope, &job_index)) {
+                runtime_function = (*jobs)[job_index].generate_function.function;
+            } else {
                 runtime_function = new Function;
 
                 AnyJob job;
@@ -3492,10 +3448,13 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                 job.generate_function.type = function_type;
                 job.generate_function.value = function_value;
                 job.generate_function.function = runtime_function;
+                job.generate_function.generation_state = nullptr;
 
                 jobs->append(job);
             }
 
+            jobs->unlock();
+
             auto instruction_parameters = allocate<FunctionCallInstruction::Parameter>(function_type.parameters.length);
 
             size_t runtime_parameter_index = 0;
@@ -3553,7 +3512,7 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
             assert(context->variable_scope_stack.length != 0);
             auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-            auto function_call_instruction = new FunctionCallInstruction;
+            auto function_call_instruction = new(context->arena) FunctionCallInstruction;
             function_call_instruction->range = function_call->range;
             function_call_instruction->debug_scope_index = current_variable_scope.debug_scope_index;
             function_call_instruction->pointer_register = pointer_register;
@@ -3836,7 +3795,7 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                     assert(context->variable_scope_stack.length != 0);
                     auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-                    auto intrinsic_call_instruction = new IntrinsicCallInstruction;
+                    auto intrinsic_call_instruction = new(context->arena) IntrinsicCallInstruction;
                     intrinsic_call_instruction->range = function_call->range;
                     intrinsic_call_instruction->debug_scope_index = current_variable_scope.debug_scope_index;
                     intrinsic_call_instruction->intrinsic = IntrinsicCallInstruction::Intrinsic::Sqrt;
@@ -3937,7 +3896,7 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
             assert(context->variable_scope_stack.length != 0);
             auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-            auto function_call_instruction = new FunctionCallInstruction;
+            auto function_call_instruction = new(context->arena) FunctionCallInstruction;
             function_call_instruction->range = function_call->range;
             function_call_instruction->debug_scope_index = current_variable_scope.debug_scope_index;
             function_call_instruction->pointer_register = pointer_register;
@@ -4000,32 +3959,21 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                     };
                 }
 
-                for(size_t i = 0; i < jobs->length; i += 1) {
-                    auto job = (*jobs)[i];
+                jobs->lock();
 
-                    if(job.kind == JobKind::ResolvePolymorphicStruct) {
-                        auto resolve_polymorphic_struct = job.resolve_polymorphic_struct;
+                size_t job_index;
+                if(jobs->find_polymorphic_struct(definition, parameters, &job_index)) {
+                    jobs->unlock();
 
-                        if(resolve_polymorphic_struct.definition == definition && resolve_polymorphic_struct.parameters != nullptr) {
-                            auto same_parameters = true;
-                            for(size_t i = 0; i < parameter_count; i += 1) {
-                                if(!constant_values_equal(parameters[i], resolve_polymorphic_struct.parameters[i])) {
-                                    same_parameters = false;
-                                    break;
-                                }
-                            }
+                    auto job = &(*jobs)[job_index];
 
-                            if(same_parameters) {
-                                if(job.state == JobState::Done) {
-                                    return ok(TypedRuntimeValue(
-                                        AnyType::AnyType::create_type_type(),
-                                        AnyRuntimeValue(AnyConstantValue(resolve_polymorphic_struct.type))
-                                    ));
-                                } else {
-                                    return wait(i);
-                                }
-                            }
-                        }
+                    if(get_job_state(job) == JobState::Done) {
+                        return ok(TypedRuntimeValue(
+                            AnyType::AnyType::create_type_type(),
+                            AnyRuntimeValue(AnyConstantValue(job->resolve_polymorphic_struct.type))
+                        ));
+                    } else {
+                        return wait(job_index);
                     }
                 }
 
@@ -4036,7 +3984,9 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                 job.resolve_polymorphic_struct.parameters = parameters;
                 job.resolve_polymorphic_struct.scope = polymorphic_struct.parent;
 
-                auto job_index = jobs->append(job);
+                job_index = jobs->append(job);
+
+                jobs->unlock();
 
                 return wait(job_index);
             } else if(type.kind == TypeKind::PolymorphicUnion) {
@@ -4071,32 +4021,21 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                     };
                 }
 
-                for(size_t i = 0; i < jobs->length; i += 1) {
-                    auto job = (*jobs)[i];
+                jobs->lock();
 
-                    if(job.kind == JobKind::ResolvePolymorphicUnion) {
-                        auto resolve_polymorphic_union = job.resolve_polymorphic_union;
+                size_t job_index;
+                if(jobs->find_polymorphic_union(definition, parameters, &job_index)) {
+                    jobs->unlock();
 
-                        if(resolve_polymorphic_union.definition == definition && resolve_polymorphic_union.parameters != nullptr) {
-                            auto same_parameters = true;
-                            for(size_t i = 0; i < parameter_count; i += 1) {
-                                if(!constant_values_equal(parameters[i], resolve_polymorphic_union.parameters[i])) {
-                                    same_parameters = false;
-                                    break;
-                                }
-                            }
+                    auto job = &(*jobs)[job_index];
 
-                            if(same_parameters) {
-                                if(job.state == JobState::Done) {
-                                    return ok(TypedRuntimeValue(
-                                        AnyType::AnyType::create_type_type(),
-                                        AnyRuntimeValue(AnyConstantValue(resolve_polymorphic_union.type))
-                                    ));
-                                } else {
-                                    return wait(i);
-                                }
-                            }
-                        }
+                    if(get_job_state(job) == JobState::Done) {
+                        return ok(TypedRuntimeValue(
+                            AnyType::AnyType::create_type_type(),
+                            AnyRuntimeValue(AnyConstantValue(job->resolve_polymorphic_union.type))
+                        ));
+                    } else {
+                        return wait(job_index);
                     }
                 }
 
@@ -4107,7 +4046,9 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                 job.resolve_polymorphic_union.parameters = parameters;
                 job.resolve_polymorphic_union.scope = polymorphic_union.parent;
 
-                auto job_index = jobs->append(job);
+                job_index = jobs->append(job);
+
+                jobs->unlock();
 
                 return wait(job_index);
             } else {
@@ -4151,29 +4092,13 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
 
                         auto function_value = constant_value.unwrap_function();
 
-                        auto found = false;
-                        Function* runtime_function;
-                        for(size_t i = 0; i < jobs->length; i += 1) {
-                            auto job = (*jobs)[i];
-
-                            if(job.kind == JobKind::GenerateFunction) {
-                                auto generate_function = job.generate_function;
-
-                                if(
-                                    AnyType(generate_function.type) == AnyType(function) &&
-                                    generate_function.value.declaration == function_value.declaration &&
-                                    generate_function.value.body_scope == function_value.body_scope
-                                ) {
-                                    found = true;
-
-                                    runtime_function = generate_function.function;
+                        jobs->lock();
 
-                                    break;
-                                }
-                            }
-                        }
-
-                        if(!found) {
+                        size_t job_index;
+                        Function* runtime_function;
+                        if(jobs->find(JobKind::GenerateFunction, function_value.declaration, function_value.body_scope, &job_index)) {
+                            runtime_function = (*jobs)[job_index].generate_function.function;
+                        } else {
                             runtime_function = new Function;
 
                             AnyJob job;
@@ -4182,10 +4107,13 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                             job.generate_function.type = function;
                             job.generate_function.value = function_value;
                             job.generate_function.function = runtime_function;
+                            job.generate_function.generation_state = nullptr;
 
                             jobs->append(job);
                         }
 
+                        jobs->unlock();
+
                         pointer_register = append_reference_static(
                             context,
                             unary_operation->range,
@@ -4202,7 +4130,7 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
 
                         return ok(TypedRuntimeValue(
                             AnyType::AnyType::create_type_type(),
-                            AnyRuntimeValue(AnyConstantValue(AnyType(Pointer(heapify(type)))))
+                            AnyRuntimeValue(AnyConstantValue(AnyType(Pointer(intern_type(type)))))
                         ));
                     } else {
                         error(scope, unary_operation->expression->range, "Cannot take pointers to constants of type '%.*s'", STRING_PRINTF_ARGUMENTS(expression_value.type.get_description()));
@@ -4225,7 +4153,7 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                 }
 
                 return ok(TypedRuntimeValue(
-                    AnyType(Pointer(heapify(expression_value.type))),
+                    AnyType(Pointer(intern_type(expression_value.type))),
                     AnyRuntimeValue(RegisterValue(IRType::create_pointer(), pointer_register))
                 ));
             } break;
@@ -4833,52 +4761,26 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                 }
             }
 
-            for(size_t i = 0; i < jobs->length; i += 1) {
-                auto job = (*jobs)[i];
+            jobs->lock();
 
-                if(job.kind == JobKind::ResolvePolymorphicFunction) {
-                    auto resolve_polymorphic_function = job.resolve_polymorphic_function;
+            size_t job_index;
+            if(jobs->find_polymorphic_function(
+                polymorphic_function_value.declaration,
+                polymorphic_function_value.scope,
+                polymorphic_parameters,
+                &job_index
+            )) {
+                jobs->unlock();
 
-                    if(
-                        resolve_polymorphic_function.declaration == polymorphic_function_value.declaration &&
-                        resolve_polymorphic_function.scope == polymorphic_function_value.scope
-                    ) {
-                        auto matching_polymorphic_parameters = true;
-                        for(size_t i = 0; i < declaration_parameter_count; i += 1) {
-                            auto declaration_parameter = declaration_parameters[i];
-                            auto call_parameter = polymorphic_parameters[i];
-                            auto job_parameter = resolve_polymorphic_function.parameters[i];
-
-                            if(
-                                (declaration_parameter.is_polymorphic_determiner || declaration_parameter.is_constant) &&
-                                job_parameter.type != call_parameter.type
-                            ) {
-                                matching_polymorphic_parameters = false;
-                                break;
-                            }
+                auto job = &(*jobs)[job_index];
 
-                            if(
-                                declaration_parameter.is_constant &&
-                                !constant_values_equal( call_parameter.value, job_parameter.value)
-                            ) {
-                                matching_polymorphic_parameters = false;
-                                break;
-                            }
-                        }
-
-                        if(!matching_polymorphic_parameters) {
-                            continue;
-                        }
-
-                        if(job.state == JobState::Done) {
-                            return ok(TypedRuntimeValue(
-                                AnyType(resolve_polymorphic_function.type),
-                                AnyRuntimeValue(AnyConstantValue(resolve_polymorphic_function.value))
-                            ));
-                        } else {
-                            return wait(i);
-                        }  
-                    }
+                if(get_job_state(job) == JobState::Done) {
+                    return ok(TypedRuntimeValue(
+                        AnyType(job->resolve_polymorphic_function.type),
+                        AnyRuntimeValue(AnyConstantValue(job->resolve_polymorphic_function.value))
+                    ));
+                } else {
+                    return wait(job_index);
                 }
             }
 
@@ -4897,7 +4799,9 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
             job.resolve_polymorphic_function.call_scope = scope;
             job.resolve_polymorphic_function.call_parameter_ranges = call_parameter_ranges;
 
-            auto job_index = jobs->append(job);
+            job_index = jobs->append(job);
+
+            jobs->unlock();
 
             return wait(job_index);
         } else if(expression_value.type.kind == TypeKind::FunctionTypeType) {
@@ -4966,14 +4870,14 @@ static_profiled_function(DelayedResult<TypedRuntimeValue>, generate_expression,
                 AnyType::create_type_type(),
                 AnyRuntimeValue(AnyConstantValue(AnyType(StaticArray(
                     length_integer,
-                    heapify(type)
+                    intern_type(type)
                 ))))
             ));
         } else {
             return ok(TypedRuntimeValue(
                 AnyType::create_type_type(),
                 AnyRuntimeValue(AnyConstantValue(AnyType(ArrayTypeType(
-                    heapify(type)
+                    intern_type(type)
                 ))))
             ));
         }
@@ -5097,7 +5001,7 @@ static void enter_new_block(GenerationContext* context, FileRange range) {
         return;
     }
 
-    auto new_block = new Block;
+    auto new_block = new(context->arena) Block;
 
     auto last_instruction = context->instructions[context->instructions.length - 1];
 
@@ -5106,7 +5010,7 @@ static void enter_new_block(GenerationContext* context, FileRange range) {
     }
 
     context->current_block->instructions = context->instructions;
-    context->blocks.append(context->current_block);
+    context->current_block->index = context->blocks.append(context->current_block);
 
     context->current_block = new_block;
     context->instructions = {};
@@ -5116,7 +5020,7 @@ static void change_block(GenerationContext* context, FileRange range, Block* blo
     assert(!does_current_block_need_finisher(context));
 
     context->current_block->instructions = context->instructions;
-    context->blocks.append(context->current_block);
+    context->current_block->index = context->blocks.append(context->current_block);
 
     context->current_block = block;
     context->instructions = {};
@@ -5133,21 +5037,108 @@ static bool is_runtime_statement(Statement* statement) {
     );
 }
 
+// Taken before each statement of a function body, so a wait only has to repeat the statement that hit it
+struct GenerationCheckpoint {
+    size_t statement_index;
+    bool unreachable;
+
+    bool in_breakable_scope;
+    Block* break_end_block;
+
+    size_t next_child_scope_index;
+
+    size_t variable_scope_count;
+    size_t variable_count;
+
+    size_t debug_scope_count;
+
+    size_t block_count;
+    Block* current_block;
+    size_t instruction_count;
+
+    size_t next_register;
+
+    size_t static_constant_count;
+};
+
+static GenerationCheckpoint create_generation_checkpoint(GenerationContext* context, size_t statement_index, bool unreachable) {
+    assert(context->variable_scope_stack.length != 0);
+
+    GenerationCheckpoint checkpoint {};
+    checkpoint.statement_index = statement_index;
+    checkpoint.unreachable = unreachable;
+    checkpoint.in_breakable_scope = context->in_breakable_scope;
+    checkpoint.break_end_block = context->break_end_block;
+    checkpoint.next_child_scope_index = context->next_child_scope_index;
+    checkpoint.variable_scope_count = context->variable_scope_stack.length;
+    checkpoint.variable_count = context->variable_scope_stack[context->variable_scope_stack.length - 1].variables.length;
+    checkpoint.debug_scope_count = context->debug_scopes.length;
+    checkpoint.block_count = context->blocks.length;
+    checkpoint.current_block = context->current_block;
+    checkpoint.instruction_count = context->instructions.length;
+    checkpoint.next_register = context->next_register;
+    checkpoint.static_constant_count = context->static_constants.length;
+
+    return checkpoint;
+}
+
+static void restore_generation_checkpoint(GenerationContext* context, GenerationCheckpoint checkpoint) {
+    context->in_breakable_scope = checkpoint.in_breakable_scope;
+    context->break_end_block = checkpoint.break_end_block;
+    context->next_child_scope_index = checkpoint.next_child_scope_index;
+
+    context->variable_scope_stack.length = checkpoint.variable_scope_count;
+    context->variable_scope_stack[checkpoint.variable_scope_count - 1].variables.length = checkpoint.variable_count;
+
+    context->debug_scopes.length = checkpoint.debug_scope_count;
+
+    if(context->current_block != checkpoint.current_block) {
+        // The block was finished part way through the statement, so its instructions were handed over to it and
+        // nothing has been appended to them since
+        auto instructions = checkpoint.current_block->instructions;
+
+        context->current_block = checkpoint.current_block;
+        context->instructions.elements = instructions.elements;
+        context->instructions.capacity = instructions.length;
+    }
+
+    context->blocks.length = checkpoint.block_count;
+    context->instructions.length = checkpoint.instruction_count;
+
+    context->next_register = checkpoint.next_register;
+
+    context->static_constants.length = checkpoint.static_constant_count;
+}
+
 static_profiled_function(DelayedResult<void>, generate_runtime_statements, (
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     ConstantScope* scope,
     GenerationContext* context,
-    Array<Statement*> statements
+    Array<Statement*> statements,
+    GenerationCheckpoint* checkpoint
 ), (
     info,
     jobs,
     scope,
     context,
-    statements
+    statements,
+    checkpoint
 )) {
+    size_t first_statement_index = 0;
     auto unreachable = false;
-    for(auto statement : statements) {
+    if(checkpoint != nullptr) {
+        first_statement_index = checkpoint->statement_index;
+        unreachable = checkpoint->unreachable;
+    }
+
+    for(size_t statement_index = first_statement_index; statement_index < statements.length; statement_index += 1) {
+        auto statement = statements[statement_index];
+
+        if(checkpoint != nullptr) {
+            *checkpoint = create_generation_checkpoint(context, statement_index, unreachable);
+        }
+
         if(is_runtime_statement(statement)) {
             if(unreachable) {
                 error(scope, statement->range, "Unreachable code");
@@ -5509,16 +5500,16 @@ static_profiled_function(DelayedResult<void>, generate_runtime_statements, (
             } else if(statement->kind == StatementKind::IfStatement) {
                 auto if_statement = (IfStatement*)statement;
 
-                auto end_block = new Block;
+                auto end_block = new(context->arena) Block;
 
                 Block* next_block;
                 if(if_statement->else_ifs.length == 0 && if_statement->else_statements.length == 0) {
                     next_block = end_block;
                 } else {
-                    next_block = new Block;
+                    next_block = new(context->arena) Block;
                 }
 
-                auto body_block = new Block;
+                auto body_block = new(context->arena) Block;
 
                 expect_delayed(condition, generate_expression(info, jobs, scope, context, if_statement->condition));
 
@@ -5565,7 +5556,7 @@ static_profiled_function(DelayedResult<void>, generate_runtime_statements, (
 
                 context->variable_scope_stack.append(if_variable_scope);
 
-                expect_delayed_void(generate_runtime_statements(info, jobs, if_scope, context, if_statement->statements));
+                expect_delayed_void(generate_runtime_statements(info, jobs, if_scope, context, if_statement->statements, nullptr));
 
                 context->variable_scope_stack.length -= 1;
 
@@ -5579,10 +5570,10 @@ static_profiled_function(DelayedResult<void>, generate_runtime_statements, (
                     if(i == if_statement->else_ifs.length - 1 && if_statement->else_statements.length == 0) {
                         next_block = end_block;
                     } else {
-                        next_block = new Block;
+                        next_block = new(context->arena) Block;
                     }
 
-                    auto body_block = new Block;
+                    auto body_block = new(context->arena) Block;
 
                     expect_delayed(condition, generate_expression(info, jobs, scope, context, if_statement->else_ifs[i].condition));
 
@@ -5626,7 +5617,7 @@ static_profiled_function(DelayedResult<void>, generate_runtime_statements, (
 
                     context->variable_scope_stack.append(else_if_variable_scope);
 
-                    expect_delayed_void(generate_runtime_statements(info, jobs, if_scope, context, if_statement->else_ifs[i].statements));
+                    expect_delayed_void(generate_runtime_statements(info, jobs, if_scope, context, if_statement->else_ifs[i].statements, nullptr));
 
                     context->variable_scope_stack.length -= 1;
 
@@ -5655,7 +5646,7 @@ static_profiled_function(DelayedResult<void>, generate_runtime_statements, (
 
                     context->variable_scope_stack.append(else_variable_scope);
 
-                    expect_delayed_void(generate_runtime_statements(info, jobs, else_scope, context, if_statement->else_statements));
+                    expect_delayed_void(generate_runtime_statements(info, jobs, else_scope, context, if_statement->else_statements, nullptr));
 
                     context->variable_scope_stack.length -= 1;
 
@@ -5668,9 +5659,9 @@ static_profiled_function(DelayedResult<void>, generate_runtime_statements, (
             } else if(statement->kind == StatementKind::WhileLoop) {
                 auto while_loop = (WhileLoop*)statement;
 
-                auto end_block = new Block;
+                auto end_block = new(context->arena) Block;
 
-                auto body_block = new Block;
+                auto body_block = new(context->arena) Block;
 
                 enter_new_block(context, while_loop->condition->range);
 
@@ -5727,7 +5718,7 @@ static_profiled_function(DelayedResult<void>, generate_runtime_statements, (
                 context->in_breakable_scope = true;
                 context->break_end_block = end_block;
 
-                expect_delayed_void(generate_runtime_statements(info, jobs, while_scope, context, while_loop->statements));
+                expect_delayed_void(generate_runtime_statements(info, jobs, while_scope, context, while_loop->statements, nullptr));
 
                 context->in_breakable_scope = old_in_breakable_scope;
                 context->break_end_block = old_break_end_block;
@@ -5746,7 +5737,8 @@ static_profiled_function(DelayedResult<void>, generate_runtime_statements, (
                 if(for_loop->has_index_name) {
                     index_name = for_loop->index_name;
                 } else {
-                    index_name.text = u8"it"_S;
+                    index_name.hash = calculate_string_hash(u8"it"_S);
+                    index_name.text = intern_symbol(u8"it"_S, index_name.hash);
                     index_name.range = for_loop->range;
                 }
 
@@ -5807,9 +5799,9 @@ static_profiled_function(DelayedResult<void>, generate_runtime_statements, (
                     index_pointer_register
                 );
 
-                auto end_block = new Block;
+                auto end_block = new(context->arena) Block;
 
-                auto body_block = new Block;
+                auto body_block = new(context->arena) Block;
 
                 enter_new_block(context, for_loop->range);
 
@@ -5880,7 +5872,7 @@ static_profiled_function(DelayedResult<void>, generate_runtime_statements, (
                     AddressedValue(determined_index_ir_type, index_pointer_register)
                 ));
 
-                expect_delayed_void(generate_runtime_statements(info, jobs, for_scope, context, for_loop->statements));
+                expect_delayed_void(generate_runtime_statements(info, jobs, for_scope, context, for_loop->statements, nullptr));
 
                 context->in_breakable_scope = old_in_breakable_scope;
                 context->break_end_block = old_break_end_block;
@@ -5917,7 +5909,7 @@ static_profiled_function(DelayedResult<void>, generate_runtime_statements, (
                 assert(context->variable_scope_stack.length != 0);
                 auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-                auto return_instruction = new ReturnInstruction;
+                auto return_instruction = new(context->arena) ReturnInstruction;
                 return_instruction->range = return_statement->range;
                 return_instruction->debug_scope_index = current_variable_scope.debug_scope_index;
 
@@ -6074,7 +6066,7 @@ static_profiled_function(DelayedResult<void>, generate_runtime_statements, (
                 assert(context->variable_scope_stack.length != 0);
                 auto current_variable_scope = context->variable_scope_stack[context->variable_scope_stack.length - 1];
 
-                auto assembly_instruction = new AssemblyInstruction;
+                auto assembly_instruction = new(context->arena) AssemblyInstruction;
                 assembly_instruction->range = inline_assembly->range;
                 assembly_instruction->debug_scope_index = current_variable_scope.debug_scope_index;
                 assembly_instruction->assembly = inline_assembly->assembly;
@@ -6090,18 +6082,249 @@ static_profiled_function(DelayedResult<void>, generate_runtime_statements, (
     return ok();
 }
 
+static void find_expression_references(Expression* expression, List<NamedReference*>* references) {
+    if(expression->kind == ExpressionKind::NamedReference) {
+        references->append((NamedReference*)expression);
+    } else if(expression->kind == ExpressionKind::MemberReference) {
+        auto member_reference = (MemberReference*)expression;
+
+        find_expression_references(member_reference->expression, references);
+    } else if(expression->kind == ExpressionKind::IndexReference) {
+        auto index_reference = (IndexReference*)expression;
+
+        find_expression_references(index_reference->expression, references);
+        find_expression_references(index_reference->index, references);
+    } else if(expression->kind == ExpressionKind::ArrayLiteral) {
+        auto array_literal = (ArrayLiteral*)expression;
+
+        for(auto element : array_literal->elements) {
+            find_expression_references(element, references);
+        }
+    } else if(expression->kind == ExpressionKind::StructLiteral) {
+        auto struct_literal = (StructLiteral*)expression;
+
+        for(auto member : struct_literal->members) {
+            find_expression_references(member.value, references);
+        }
+    } else if(expression->kind == ExpressionKind::FunctionCall) {
+        auto function_call = (FunctionCall*)expression;
+
+        find_expression_references(function_call->expression, references);
+
+        for(auto parameter : function_call->parameters) {
+            find_expression_references(parameter, references);
+        }
+    } else if(expression->kind == ExpressionKind::BinaryOperation) {
+        auto binary_operation = (BinaryOperation*)expression;
+
+        find_expression_references(binary_operation->left, references);
+        find_expression_references(binary_operation->right, references);
+    } else if(expression->kind == ExpressionKind::UnaryOperation) {
+        auto unary_operation = (UnaryOperation*)expression;
+
+        find_expression_references(unary_operation->expression, references);
+    } else if(expression->kind == ExpressionKind::Cast) {
+        auto cast = (Cast*)expression;
+
+        find_expression_references(cast->expression, references);
+        find_expression_references(cast->type, references);
+    } else if(expression->kind == ExpressionKind::Bake) {
+        auto bake = (Bake*)expression;
+
+        find_expression_references(bake->function_call, references);
+    } else if(expression->kind == ExpressionKind::ArrayType) {
+        auto array_type = (ArrayType*)expression;
+
+        find_expression_references(array_type->expression, references);
+
+        if(array_type->length != nullptr) {
+            find_expression_references(array_type->length, references);
+        }
+    } else if(expression->kind == ExpressionKind::FunctionType) {
+        auto function_type = (FunctionType*)expression;
+
+        for(auto parameter : function_type->parameters) {
+            find_expression_references(parameter.type, references);
+        }
+
+        for(auto return_type : function_type->return_types) {
+            find_expression_references(return_type, references);
+        }
+    }
+}
+
+// Only looks into runtime statements, declarations nested in a function body are resolved by their own jobs
+static void find_statement_references(Array<Statement*> statements, List<NamedReference*>* references) {
+    for(auto statement : statements) {
+        if(statement->kind == StatementKind::ExpressionStatement) {
+            auto expression_statement = (ExpressionStatement*)statement;
+
+            find_expression_references(expression_statement->expression, references);
+        } else if(statement->kind == StatementKind::VariableDeclaration) {
+            auto variable_declaration = (VariableDeclaration*)statement;
+
+            if(variable_declaration->type != nullptr) {
+                find_expression_references(variable_declaration->type, references);
+            }
+
+            if(variable_declaration->initializer != nullptr) {
+                find_expression_references(variable_declaration->initializer, references);
+            }
+        } else if(statement->kind == StatementKind::MultiReturnVariableDeclaration) {
+            auto variable_declaration = (MultiReturnVariableDeclaration*)statement;
+
+            find_expression_references(variable_declaration->initializer, references);
+        } else if(statement->kind == StatementKind::Assignment) {
+            auto assignment = (Assignment*)statement;
+
+            find_expression_references(assignment->target, references);
+            find_expression_references(assignment->value, references);
+        } else if(statement->kind == StatementKind::MultiReturnAssignment) {
+            auto assignment = (MultiReturnAssignment*)statement;
+
+            for(auto target : assignment->targets) {
+                find_expression_references(target, references);
+            }
+
+            find_expression_references(assignment->value, references);
+        } else if(statement->kind == StatementKind::BinaryOperationAssignment) {
+            auto assignment = (BinaryOperationAssignment*)statement;
+
+            find_expression_references(assignment->target, references);
+            find_expression_references(assignment->value, references);
+        } else if(statement->kind == StatementKind::IfStatement) {
+            auto if_statement = (IfStatement*)statement;
+
+            find_expression_references(if_statement->condition, references);
+            find_statement_references(if_statement->statements, references);
+
+            for(auto else_if : if_statement->else_ifs) {
+                find_expression_references(else_if.condition, references);
+                find_statement_references(else_if.statements, references);
+            }
+
+            find_statement_references(if_statement->else_statements, references);
+        } else if(statement->kind == StatementKind::WhileLoop) {
+            auto while_loop = (WhileLoop*)statement;
+
+            find_expression_references(while_loop->condition, references);
+            find_statement_references(while_loop->statements, references);
+        } else if(statement->kind == StatementKind::ForLoop) {
+            auto for_loop = (ForLoop*)statement;
+
+            find_expression_references(for_loop->from, references);
+            find_expression_references(for_loop->to, references);
+            find_statement_references(for_loop->statements, references);
+        } else if(statement->kind == StatementKind::ReturnStatement) {
+            auto return_statement = (ReturnStatement*)statement;
+
+            for(auto value : return_statement->values) {
+                find_expression_references(value, references);
+            }
+        } else if(statement->kind == StatementKind::InlineAssembly) {
+            auto inline_assembly = (InlineAssembly*)statement;
+
+            for(auto binding : inline_assembly->bindings) {
+                find_expression_references(binding.value, references);
+            }
+        }
+    }
+}
+
+// Finds the job that resolves the declaration a name in a function body would most likely refer to. Names declared
+// in nested blocks or brought in through 'using' or static ifs are left for the generator to find.
+static bool find_reference_job(JobList* jobs, ConstantScope* scope, Identifier name, size_t* job_index) {
+    auto current_scope = scope;
+    while(true) {
+        auto declaration = search_in_declaration_hash_table(&current_scope->declarations, name.hash, name.text);
+
+        if(declaration != nullptr) {
+            switch(declaration->kind) {
+                case StatementKind::FunctionDeclaration: {
+                    return jobs->find(JobKind::ResolveFunctionDeclaration, declaration, current_scope, job_index);
+                } break;
+
+                case StatementKind::ConstantDefinition: {
+                    return jobs->find(JobKind::ResolveConstantDefinition, declaration, current_scope, job_index);
+                } break;
+
+                case StatementKind::StructDefinition: {
+                    return jobs->find(JobKind::ResolveStructDefinition, declaration, current_scope, job_index);
+                } break;
+
+                case StatementKind::UnionDefinition: {
+                    return jobs->find(JobKind::ResolveUnionDefinition, declaration, current_scope, job_index);
+                } break;
+
+                case StatementKind::EnumDefinition: {
+                    return jobs->find(JobKind::ResolveEnumDefinition, declaration, current_scope, job_index);
+                } break;
+
+                case StatementKind::Import: {
+                    auto import = (Import*)declaration;
+
+                    return jobs->find_parse_file(import->absolute_path, job_index);
+                } break;
+
+                default: {
+                    return false;
+                } break;
+            }
+        }
+
+        if(current_scope->is_top_level) {
+            return false;
+        } else {
+            current_scope = current_scope->parent;
+        }
+    }
+}
+
+struct FunctionGenerationState {
+    GenerationContext context;
+
+    size_t debug_scope_index;
+
+    GenerationCheckpoint checkpoint;
+
+    // Holds the function's blocks and instructions
+    Arena arena;
+
+    // Names the body refers to, whose resolve jobs are waited on before any instructions are generated
+    Array<NamedReference*> references;
+    size_t next_reference_index;
+
+    size_t restart_count;
+};
+
+size_t get_generation_restart_count(FunctionGenerationState* state) {
+    if(state == nullptr) {
+        return 0;
+    }
+
+    return state->restart_count;
+}
+
+void free_generated_function(FunctionGenerationState* state) {
+    if(state != nullptr) {
+        free_arena(&state->arena);
+    }
+}
+
 profiled_function(DelayedResult<Array<StaticConstant*>>, do_generate_function, (
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     FunctionTypeType type,
     FunctionConstant value,
-    Function* function
+    Function* function,
+    FunctionGenerationState** generation_state
 ), (
     info,
     jobs,
     type,
     value,
-    function
+    function,
+    generation_state
 )) {
     auto declaration = value.declaration;
 
@@ -6163,71 +6386,114 @@ profiled_function(DelayedResult<Array<StaticConstant*>>, do_generate_function, (
         function->is_external = false;
         function->is_no_mangle = value.is_no_mangle;
 
-        GenerationContext context {};
+        auto state = *generation_state;
+        if(state == nullptr) {
+            state = new FunctionGenerationState;
+            *state = {};
 
-        context.return_types = type.return_types;
+            *generation_state = state;
 
-        context.next_register = runtime_parameter_count;
+            auto context = &state->context;
 
-        DebugScope debug_scope {};
-        debug_scope.range = declaration->range;
+            context->arena = &state->arena;
 
-        auto debug_scope_index = context.debug_scopes.append(debug_scope);
+            context->return_types = type.return_types;
 
-        VariableScope body_variable_scope {};
-        body_variable_scope.constant_scope = value.body_scope;
-        body_variable_scope.debug_scope_index = debug_scope_index;
+            context->next_register = runtime_parameter_count;
 
-        context.variable_scope_stack.append(body_variable_scope);
+            DebugScope debug_scope {};
+            debug_scope.range = declaration->range;
 
-        context.child_scopes = value.child_scopes;
+            state->debug_scope_index = context->debug_scopes.append(debug_scope);
 
-        context.current_block = new Block;
+            VariableScope body_variable_scope {};
+            body_variable_scope.constant_scope = value.body_scope;
+            body_variable_scope.debug_scope_index = state->debug_scope_index;
 
-        List<Instruction*> first_block_instructions {};
+            context->variable_scope_stack.append(body_variable_scope);
 
-        size_t runtime_parameter_index = 0;
-        for(size_t i = 0; i < declaration->parameters.length; i += 1) {
-            if(!declaration->parameters[i].is_constant) {
-                auto parameter_type = type.parameters[i];
+            context->child_scopes = value.child_scopes;
 
-                auto pointer_register = append_allocate_local(
-                    &context,
-                    declaration->parameters[i].name.range,
-                    ir_parameters[runtime_parameter_index],
-                    declaration->parameters[i].name.text,
-                    parameter_type
-                );
+            context->current_block = new(context->arena) Block;
 
-                append_store(
-                    &context,
-                    declaration->parameters[i].name.range,
-                    runtime_parameter_index,
-                    pointer_register
-                );
+            size_t runtime_parameter_index = 0;
+            for(size_t i = 0; i < declaration->parameters.length; i += 1) {
+                if(!declaration->parameters[i].is_constant) {
+                    auto parameter_type = type.parameters[i];
 
-                add_new_variable(
-                    &context,
-                    declaration->parameters[i].name,
-                    parameter_type,
-                    AddressedValue(ir_parameters[runtime_parameter_index], pointer_register)
-                );
+                    auto pointer_register = append_allocate_local(
+                        context,
+                        declaration->parameters[i].name.range,
+                        ir_parameters[runtime_parameter_index],
+                        declaration->parameters[i].name.text,
+                        parameter_type
+                    );
+
+                    append_store(
+                        context,
+                        declaration->parameters[i].name.range,
+                        runtime_parameter_index,
+                        pointer_register
+                    );
+
+                    add_new_variable(
+                        context,
+                        declaration->parameters[i].name,
+                        parameter_type,
+                        AddressedValue(ir_parameters[runtime_parameter_index], pointer_register)
+                    );
 
-                runtime_parameter_index += 1;
+                    runtime_parameter_index += 1;
+                }
             }
+
+            assert(runtime_parameter_index == runtime_parameter_count);
+
+            List<NamedReference*> references {};
+            find_statement_references(declaration->statements, &references);
+
+            state->references = references;
         }
 
-        assert(runtime_parameter_index == runtime_parameter_count);
+        while(state->next_reference_index < state->references.length) {
+            auto reference = state->references[state->next_reference_index];
 
-        expect_delayed_void(generate_runtime_statements(
+            size_t job_index;
+            if(
+                find_reference_job(jobs, value.body_scope, reference->name, &job_index) &&
+                get_job_state(&(*jobs)[job_index]) != JobState::Done
+            ) {
+                return wait(job_index);
+            }
+
+            state->next_reference_index += 1;
+        }
+
+        auto context = &state->context;
+        auto debug_scope_index = state->debug_scope_index;
+
+        auto result = generate_runtime_statements(
             info,
             jobs,
             value.body_scope,
-            &context,
-            declaration->statements
-        ));
+            context,
+            declaration->statements,
+            &state->checkpoint
+        );
+
+        if(!result.has_value) {
+            restore_generation_checkpoint(context, state->checkpoint);
 
-        assert(context.next_child_scope_index == value.child_scopes.length);
+            state->restart_count += 1;
+
+            return wait(result.waiting_for);
+        }
+
+        if(!result.status) {
+            return err();
+        }
+
+        assert(context->next_child_scope_index == value.child_scopes.length);
 
         bool has_return_at_end;
         if(declaration->statements.length > 0) {
@@ -6244,28 +6510,29 @@ profiled_function(DelayedResult<Array<StaticConstant*>>, do_generate_function, (
 
                 return err();
             } else {
-                auto return_instruction = new ReturnInstruction;
+                auto return_instruction = new(context->arena) ReturnInstruction;
                 return_instruction->range = declaration->range;
                 return_instruction->debug_scope_index = debug_scope_index;
 
-                context.instructions.append(return_instruction);
+                context->instructions.append(return_instruction);
             }
         }
 
-        function->debug_scopes = context.debug_scopes;
+        function->debug_scopes = context->debug_scopes;
 
-        context.current_block->instructions = context.instructions;
-        context.blocks.append(context.current_block);
+        context->current_block->instructions = context->instructions;
+        context->current_block->index = context->blocks.append(context->current_block);
 
-        function->blocks = context.blocks;
+        function->blocks = context->blocks;
+        function->register_count = context->next_register;
 
-        return ok((Array<StaticConstant*>)context.static_constants);
+        return ok((Array<StaticConstant*>)context->static_constants);
     }
 }
 
 profiled_function(DelayedResult<StaticVariableResult>, do_generate_static_variable, (
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     VariableDeclaration* declaration,
     ConstantScope* scope
 ), (
@@ -6304,8 +6571,8 @@ profiled_function(DelayedResult<StaticVariableResult>, do_generate_static_variab
                         } else {
                             auto static_array_value = parameter.value.unwrap_static_array();
 
-                            for(auto element : static_array_value.elements) {
-                                expect(library_path, array_to_string(scope, tag.parameters[i]->range, *array.element_type, element));
+                            for(size_t j = 0; j < static_array_value.length; j += 1) {
+                                expect(library_path, array_to_string(scope, tag.parameters[i]->range, *array.element_type, static_array_value.elements[j]));
 
                                 libraries.append(library_path);
                             }
@@ -6324,10 +6591,10 @@ profiled_function(DelayedResult<StaticVariableResult>, do_generate_static_variab
                     ) {
                         auto static_array_value = parameter.value.unwrap_static_array();
 
-                        assert(static_array.length == static_array_value.elements.length);
+                        assert(static_array.length == static_array_value.length);
 
-                        for(auto element : static_array_value.elements) {
-                            expect(library_path, array_to_string(scope, tag.parameters[i]->range, *static_array.element_type, element));
+                        for(size_t j = 0; j < static_array_value.length; j += 1) {
+                            expect(library_path, array_to_string(scope, tag.parameters[i]->range, *static_array.element_type, static_array_value.elements[j]));
 
                             libraries.append(library_path);
                         }
@@ -4,16 +4,26 @@
 #include "hlir.h"
 #include "constant.h"
 
-struct AnyJob;
+struct JobList;
+
+// A function body that had to wait on another job, kept so generation can carry on from the statement that waited
+struct FunctionGenerationState;
 
 DelayedResult<Array<StaticConstant*>> do_generate_function(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     FunctionTypeType type,
     FunctionConstant value,
-    Function* function
+    Function* function,
+    FunctionGenerationState** generation_state
 );
 
+// Number of times the generator stopped part way through a function body to wait on another job
+size_t get_generation_restart_count(FunctionGenerationState* state);
+
+// Frees the blocks and instructions of a generated function, once nothing needs them anymore
+void free_generated_function(FunctionGenerationState* state);
+
 struct StaticVariableResult {
     StaticVariable* static_variable;
 
@@ -22,7 +32,7 @@ struct StaticVariableResult {
 
 DelayedResult<StaticVariableResult> do_generate_static_variable(
     GlobalInfo info,
-    List<AnyJob>* jobs,
+    JobList* jobs,
     VariableDeclaration* declaration,
     ConstantScope* scope
 );
\ No newline at end of file
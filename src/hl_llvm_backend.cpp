@@ -4,6 +4,7 @@
 #include <llvm-c/Target.h>
 #include <llvm-c/TargetMachine.h>
 #include <llvm-c/Analysis.h>
+#include <llvm-c/Transforms/PassBuilder.h>
 #include <llvm/IR/LLVMContext.h>
 #include <stdio.h>
 #include <string.h>
@@ -13,29 +14,30 @@
 #include "types.h"
 #include "util.h"
 #include "list.h"
+#include "arena.h"
 #include "platform.h"
 #include "profiler.h"
 #include "path.h"
+#include "symbols.h"
+#include "threading.h"
 #include "llvm-c/Types.h"
 
-static LLVMTypeRef get_llvm_type(ArchitectureSizes architecture_sizes, IRType type);
-
-inline LLVMTypeRef get_llvm_integer_type(RegisterSize size) {
+inline LLVMTypeRef get_llvm_integer_type(LLVMContextRef context, RegisterSize size) {
     switch(size) {
         case RegisterSize::Size8: {
-            return LLVMInt8Type();
+            return LLVMInt8TypeInContext(context);
         } break;
 
         case RegisterSize::Size16: {
-            return LLVMInt16Type();
+            return LLVMInt16TypeInContext(context);
         } break;
 
         case RegisterSize::Size32: {
-            return LLVMInt32Type();
+            return LLVMInt32TypeInContext(context);
         } break;
 
         case RegisterSize::Size64: {
-            return LLVMInt64Type();
+            return LLVMInt64TypeInContext(context);
         } break;
 
         default: {
@@ -44,14 +46,14 @@ inline LLVMTypeRef get_llvm_integer_type(RegisterSize size) {
     }
 }
 
-inline LLVMTypeRef get_llvm_float_type(RegisterSize size) {
+inline LLVMTypeRef get_llvm_float_type(LLVMContextRef context, RegisterSize size) {
     switch(size) {
         case RegisterSize::Size32: {
-            return LLVMFloatType();
+            return LLVMFloatTypeInContext(context);
         } break;
 
         case RegisterSize::Size64: {
-            return LLVMDoubleType();
+            return LLVMDoubleTypeInContext(context);
         } break;
 
         default: {
@@ -60,38 +62,143 @@ inline LLVMTypeRef get_llvm_float_type(RegisterSize size) {
     }
 }
 
-inline LLVMTypeRef get_llvm_pointer_type(ArchitectureSizes architecture_sizes) {
-    return LLVMPointerTypeInContext(LLVMGetGlobalContext(), 0);
+inline LLVMTypeRef get_llvm_pointer_type(LLVMContextRef context, ArchitectureSizes architecture_sizes) {
+    return LLVMPointerTypeInContext(context, 0);
+}
+
+struct LLVMTypeCacheEntry {
+    IRType type;
+    uint64_t hash;
+
+    LLVMTypeRef llvm_type;
+};
+
+// Aggregate IR types are lowered once per module, looked up by their structure
+struct LLVMTypeCache {
+    LLVMContextRef context;
+    ArchitectureSizes architecture_sizes;
+
+    // Holds copies of the IR types used as keys, the originals may be freed before the cache is
+    Arena arena;
+
+    LLVMTypeCacheEntry* entries;
+    size_t capacity;
+    size_t count;
+};
+
+static IRType copy_ir_type(Arena* arena, IRType type) {
+    auto result = type;
+
+    if(type.kind == IRTypeKind::StaticArray) {
+        result.static_array.element_type = heapify(arena, copy_ir_type(arena, *type.static_array.element_type));
+    } else if(type.kind == IRTypeKind::Struct) {
+        auto members = allocate<IRType>(arena, type.struct_.members.length);
+
+        for(size_t i = 0; i < type.struct_.members.length; i += 1) {
+            members[i] = copy_ir_type(arena, type.struct_.members[i]);
+        }
+
+        result.struct_.members = Array(type.struct_.members.length, members);
+    }
+
+    return result;
 }
 
-static LLVMTypeRef get_llvm_type(ArchitectureSizes architecture_sizes, IRType type) {
+static void insert_llvm_type_cache_entry(LLVMTypeCacheEntry* entries, size_t capacity, LLVMTypeCacheEntry entry) {
+    auto entry_index = (size_t)entry.hash & (capacity - 1);
+
+    while(entries[entry_index].llvm_type != nullptr) {
+        entry_index = (entry_index + 1) & (capacity - 1);
+    }
+
+    entries[entry_index] = entry;
+}
+
+static LLVMTypeRef get_llvm_type(LLVMTypeCache* type_cache, IRType type) {
+    auto context = type_cache->context;
+
     if(type.kind == IRTypeKind::Boolean) {
-        return get_llvm_integer_type(architecture_sizes.boolean_size);
+        return get_llvm_integer_type(context, type_cache->architecture_sizes.boolean_size);
     } else if(type.kind == IRTypeKind::Integer) {
-        return get_llvm_integer_type(type.integer.size);
+        return get_llvm_integer_type(context, type.integer.size);
     } else if(type.kind == IRTypeKind::Float) {
-        return get_llvm_float_type(type.float_.size);
+        return get_llvm_float_type(context, type.float_.size);
     } else if(type.kind == IRTypeKind::Pointer) {
-        return get_llvm_pointer_type(architecture_sizes);
-    } else if(type.kind == IRTypeKind::StaticArray) {
+        return get_llvm_pointer_type(context, type_cache->architecture_sizes);
+    }
+
+    auto hash = type.get_hash();
+
+    if(type_cache->capacity != 0) {
+        auto entry_index = (size_t)hash & (type_cache->capacity - 1);
+
+        while(type_cache->entries[entry_index].llvm_type != nullptr) {
+            auto entry = &type_cache->entries[entry_index];
+
+            if(entry->hash == hash && entry->type == type) {
+                return entry->llvm_type;
+            }
+
+            entry_index = (entry_index + 1) & (type_cache->capacity - 1);
+        }
+    }
+
+    LLVMTypeRef llvm_type;
+    if(type.kind == IRTypeKind::StaticArray) {
         auto static_array = type.static_array;
 
-        auto element_llvm_type = get_llvm_type(architecture_sizes, *static_array.element_type);
+        auto element_llvm_type = get_llvm_type(type_cache, *static_array.element_type);
 
-        return LLVMArrayType2(element_llvm_type, static_array.length);
+        llvm_type = LLVMArrayType2(element_llvm_type, static_array.length);
     } else if(type.kind == IRTypeKind::Struct) {
         auto struct_ = type.struct_;
 
         auto members = allocate<LLVMTypeRef>(struct_.members.length);
 
         for(size_t i = 0; i < struct_.members.length; i += 1) {
-            members[i] = get_llvm_type(architecture_sizes, struct_.members[i]);
+            members[i] = get_llvm_type(type_cache, struct_.members[i]);
         }
 
-        return LLVMStructType(members, struct_.members.length, false);
+        llvm_type = LLVMStructTypeInContext(context, members, struct_.members.length, false);
+
+        free(members);
     } else {
         abort();
     }
+
+    if((type_cache->count + 1) * 2 > type_cache->capacity) {
+        size_t new_capacity;
+        if(type_cache->capacity == 0) {
+            new_capacity = 64;
+        } else {
+            new_capacity = type_cache->capacity * 2;
+        }
+
+        auto new_entries = allocate<LLVMTypeCacheEntry>(new_capacity);
+        memset(new_entries, 0, new_capacity * sizeof(LLVMTypeCacheEntry));
+
+        for(size_t i = 0; i < type_cache->capacity; i += 1) {
+            if(type_cache->entries[i].llvm_type != nullptr) {
+                insert_llvm_type_cache_entry(new_entries, new_capacity, type_cache->entries[i]);
+            }
+        }
+
+        free(type_cache->entries);
+
+        type_cache->entries = new_entries;
+        type_cache->capacity = new_capacity;
+    }
+
+    LLVMTypeCacheEntry entry {};
+    entry.type = copy_ir_type(&type_cache->arena, type);
+    entry.hash = hash;
+    entry.llvm_type = llvm_type;
+
+    insert_llvm_type_cache_entry(type_cache->entries, type_cache->capacity, entry);
+
+    type_cache->count += 1;
+
+    return llvm_type;
 }
 
 struct FileDebugScope {
@@ -151,9 +258,175 @@ const LLVMDWARFTypeEncoding DW_ATE_UTF = 0x10;
 const LLVMDWARFTypeEncoding DW_ATE_lo_user = 0x80;
 const LLVMDWARFTypeEncoding DW_ATE_hi_user = 0xFF;
 
+struct DebugTypeCacheEntry {
+    AnyType type;
+    LLVMMetadataRef file_scope;
+    uint64_t hash;
+
+    // Null while the type is still being built
+    LLVMMetadataRef debug_type;
+
+    // Stands in for a struct or union that is referenced while it is being built
+    LLVMMetadataRef forward_declaration;
+};
+
+// Debug types are built once per module for each type and scope they are requested with
+struct DebugTypeCache {
+    List<DebugTypeCacheEntry> entries;
+
+    // Indices into entries plus one, zero marks an empty bucket
+    size_t* buckets;
+    size_t capacity;
+};
+
+static void insert_debug_type_cache_bucket(size_t* buckets, size_t capacity, uint64_t hash, size_t entry_index) {
+    auto bucket_index = (size_t)hash & (capacity - 1);
+
+    while(buckets[bucket_index] != 0) {
+        bucket_index = (bucket_index + 1) & (capacity - 1);
+    }
+
+    buckets[bucket_index] = entry_index + 1;
+}
+
+static Result<LLVMMetadataRef> create_llvm_debug_type(
+    LLVMDIBuilderRef debug_builder,
+    List<FileDebugScope>* file_debug_scopes,
+    DebugTypeCache* debug_type_cache,
+    LLVMMetadataRef file_scope,
+    ArchitectureSizes architecture_sizes,
+    AnyType type
+);
+
 static Result<LLVMMetadataRef> get_llvm_debug_type(
     LLVMDIBuilderRef debug_builder,
     List<FileDebugScope>* file_debug_scopes,
+    DebugTypeCache* debug_type_cache,
+    LLVMMetadataRef file_scope,
+    ArchitectureSizes architecture_sizes,
+    AnyType type
+) {
+    auto hash = combine_hash(type.get_hash(), (uint64_t)file_scope);
+
+    if(debug_type_cache->capacity != 0) {
+        auto bucket_index = (size_t)hash & (debug_type_cache->capacity - 1);
+
+        while(debug_type_cache->buckets[bucket_index] != 0) {
+            auto entry = &debug_type_cache->entries[debug_type_cache->buckets[bucket_index] - 1];
+
+            if(entry->hash == hash && entry->file_scope == file_scope && entry->type == type) {
+                if(entry->debug_type != nullptr) {
+                    return ok(entry->debug_type);
+                }
+
+                // Only structs and unions can refer back to themselves, anything else in the cycle is built again
+                if(type.kind == TypeKind::StructType || type.kind == TypeKind::UnionType) {
+                    if(entry->forward_declaration == nullptr) {
+                        unsigned int tag;
+                        String name;
+                        unsigned int line;
+                        String definition_file_path;
+                        size_t size;
+                        size_t alignment;
+                        if(type.kind == TypeKind::StructType) {
+                            tag = 0x13; // DW_TAG_structure_type
+                            name = type.struct_.definition->name.text;
+                            line = type.struct_.definition->range.first_line;
+                            definition_file_path = type.struct_.definition_file_path;
+                            size = type.struct_.get_size(architecture_sizes);
+                            alignment = type.struct_.get_alignment(architecture_sizes);
+                        } else {
+                            tag = 0x17; // DW_TAG_union_type
+                            name = type.union_.definition->name.text;
+                            line = type.union_.definition->range.first_line;
+                            definition_file_path = type.union_.definition_file_path;
+                            size = type.union_.get_size(architecture_sizes);
+                            alignment = type.union_.get_alignment(architecture_sizes);
+                        }
+
+                        expect(definition_file_scope, get_file_debug_scope(debug_builder, file_debug_scopes, definition_file_path));
+
+                        entry->forward_declaration = LLVMDIBuilderCreateReplaceableCompositeType(
+                            debug_builder,
+                            tag,
+                            (char*)name.elements,
+                            name.length,
+                            definition_file_scope,
+                            definition_file_scope,
+                            line,
+                            0,
+                            size * 8,
+                            alignment * 8,
+                            LLVMDIFlagZero,
+                            nullptr,
+                            0
+                        );
+                    }
+
+                    return ok(entry->forward_declaration);
+                }
+
+                break;
+            }
+
+            bucket_index = (bucket_index + 1) & (debug_type_cache->capacity - 1);
+        }
+    }
+
+    if((debug_type_cache->entries.length + 1) * 2 > debug_type_cache->capacity) {
+        size_t new_capacity;
+        if(debug_type_cache->capacity == 0) {
+            new_capacity = 64;
+        } else {
+            new_capacity = debug_type_cache->capacity * 2;
+        }
+
+        auto new_buckets = allocate<size_t>(new_capacity);
+        memset(new_buckets, 0, new_capacity * sizeof(size_t));
+
+        for(size_t i = 0; i < debug_type_cache->entries.length; i += 1) {
+            insert_debug_type_cache_bucket(new_buckets, new_capacity, debug_type_cache->entries[i].hash, i);
+        }
+
+        free(debug_type_cache->buckets);
+
+        debug_type_cache->buckets = new_buckets;
+        debug_type_cache->capacity = new_capacity;
+    }
+
+    DebugTypeCacheEntry new_entry {};
+    new_entry.type = type;
+    new_entry.file_scope = file_scope;
+    new_entry.hash = hash;
+
+    auto entry_index = debug_type_cache->entries.append(new_entry);
+
+    insert_debug_type_cache_bucket(debug_type_cache->buckets, debug_type_cache->capacity, hash, entry_index);
+
+    expect(debug_type, create_llvm_debug_type(
+        debug_builder,
+        file_debug_scopes,
+        debug_type_cache,
+        file_scope,
+        architecture_sizes,
+        type
+    ));
+
+    auto entry = &debug_type_cache->entries[entry_index];
+
+    if(entry->forward_declaration != nullptr) {
+        LLVMMetadataReplaceAllUsesWith(entry->forward_declaration, debug_type);
+    }
+
+    entry->debug_type = debug_type;
+
+    return ok(debug_type);
+}
+
+static Result<LLVMMetadataRef> create_llvm_debug_type(
+    LLVMDIBuilderRef debug_builder,
+    List<FileDebugScope>* file_debug_scopes,
+    DebugTypeCache* debug_type_cache,
     LLVMMetadataRef file_scope,
     ArchitectureSizes architecture_sizes,
     AnyType type
@@ -164,7 +437,7 @@ static Result<LLVMMetadataRef> get_llvm_debug_type(
         auto parameters = allocate<LLVMMetadataRef>(function.parameters.length);
 
         for(size_t i = 0; i < function.parameters.length; i += 1) {
-            expect(debug_type, get_llvm_debug_type(debug_builder, file_debug_scopes, file_scope, architecture_sizes, function.parameters[i]));
+            expect(debug_type, get_llvm_debug_type(debug_builder, file_debug_scopes, debug_type_cache, file_scope, architecture_sizes, function.parameters[i]));
 
             parameters[i] = debug_type;
         }
@@ -177,6 +450,7 @@ static Result<LLVMMetadataRef> get_llvm_debug_type(
             expect(debug_type, get_llvm_debug_type(
                 debug_builder,
                 file_debug_scopes,
+                debug_type_cache,
                 file_scope,
                 architecture_sizes,
                 function.return_types[0]
@@ -193,6 +467,7 @@ static Result<LLVMMetadataRef> get_llvm_debug_type(
                 expect(return_debug_type, get_llvm_debug_type(
                     debug_builder,
                     file_debug_scopes,
+                    debug_type_cache,
                     file_scope,
                     architecture_sizes,
                     function.return_types[i]
@@ -290,6 +565,7 @@ static Result<LLVMMetadataRef> get_llvm_debug_type(
         expect(pointed_to_llvm_debug_type, get_llvm_debug_type(
             debug_builder,
             file_debug_scopes,
+            debug_type_cache,
             file_scope,
             architecture_sizes,
             *type.pointer.pointed_to_type
@@ -316,6 +592,7 @@ static Result<LLVMMetadataRef> get_llvm_debug_type(
         expect(length_debug_type, get_llvm_debug_type(
             debug_builder,
             file_debug_scopes,
+            debug_type_cache,
             file_scope,
             architecture_sizes,
             AnyType(Integer(architecture_sizes.address_size, false))
@@ -324,6 +601,7 @@ static Result<LLVMMetadataRef> get_llvm_debug_type(
         expect(pointer_debug_type, get_llvm_debug_type(
             debug_builder,
             file_debug_scopes,
+            debug_type_cache,
             file_scope,
             architecture_sizes,
             AnyType(Pointer(array.element_type))
@@ -387,6 +665,7 @@ static Result<LLVMMetadataRef> get_llvm_debug_type(
         expect(element_llvm_debug_type, get_llvm_debug_type(
             debug_builder,
             file_debug_scopes,
+            debug_type_cache,
             file_scope,
             architecture_sizes,
             *static_array.element_type
@@ -422,6 +701,7 @@ static Result<LLVMMetadataRef> get_llvm_debug_type(
             expect(member_debug_type, get_llvm_debug_type(
                 debug_builder,
                 file_debug_scopes,
+                debug_type_cache,
                 file_scope,
                 architecture_sizes,
                 struct_.members[i].type
@@ -482,6 +762,7 @@ static Result<LLVMMetadataRef> get_llvm_debug_type(
             expect(member_debug_type, get_llvm_debug_type(
                 debug_builder,
                 file_debug_scopes,
+                debug_type_cache,
                 union_file_scope,
                 architecture_sizes,
                 union_.members[i].type
@@ -570,11 +851,14 @@ struct GetLLVMConstantResult {
     LLVMValueRef value;
 };
 
-static GetLLVMConstantResult get_llvm_constant(ArchitectureSizes architecture_sizes, IRType type, IRConstantValue value) {
+static GetLLVMConstantResult get_llvm_constant(LLVMTypeCache* type_cache, IRType type, IRConstantValue value) {
+    auto context = type_cache->context;
+    auto architecture_sizes = type_cache->architecture_sizes;
+
     LLVMTypeRef result_type;
     LLVMValueRef result_value;
     if(type.kind == IRTypeKind::Boolean) {
-        result_type = get_llvm_integer_type(architecture_sizes.boolean_size);
+        result_type = get_llvm_integer_type(context, architecture_sizes.boolean_size);
 
         if(value.kind == IRConstantValueKind::BooleanConstant) {
             result_value = LLVMConstInt(result_type, value.boolean, false);
@@ -584,7 +868,7 @@ static GetLLVMConstantResult get_llvm_constant(ArchitectureSizes architecture_si
             result_value = LLVMGetUndef(result_type);
         }
     } else if(type.kind == IRTypeKind::Integer) {
-        result_type = get_llvm_integer_type(type.integer.size);
+        result_type = get_llvm_integer_type(context, type.integer.size);
 
         if(value.kind == IRConstantValueKind::IntegerConstant) {
             result_value = LLVMConstInt(result_type, value.integer, false);
@@ -594,7 +878,7 @@ static GetLLVMConstantResult get_llvm_constant(ArchitectureSizes architecture_si
             result_value = LLVMGetUndef(result_type);
         }
     } else if(type.kind == IRTypeKind::Float) {
-        result_type = get_llvm_float_type(type.float_.size);
+        result_type = get_llvm_float_type(context, type.float_.size);
 
         if(value.kind == IRConstantValueKind::FloatConstant) {
             result_value = LLVMConstReal(result_type, value.float_);
@@ -604,10 +888,10 @@ static GetLLVMConstantResult get_llvm_constant(ArchitectureSizes architecture_si
             result_value = LLVMGetUndef(result_type);
         }
     } else if(type.kind == IRTypeKind::Pointer) {
-        result_type = get_llvm_pointer_type(architecture_sizes);
+        result_type = get_llvm_pointer_type(context, architecture_sizes);
 
         if(value.kind == IRConstantValueKind::IntegerConstant) {
-            auto integer_llvm_type = get_llvm_integer_type(architecture_sizes.address_size);
+            auto integer_llvm_type = get_llvm_integer_type(context, architecture_sizes.address_size);
 
             auto integer_constant = LLVMConstInt(integer_llvm_type, value.integer, false);
 
@@ -620,20 +904,34 @@ static GetLLVMConstantResult get_llvm_constant(ArchitectureSizes architecture_si
     } else if(type.kind == IRTypeKind::StaticArray) {
         auto static_array = type.static_array;
 
-        auto element_llvm_type = get_llvm_type(architecture_sizes, *static_array.element_type);
-
-        result_type = LLVMArrayType2(element_llvm_type, static_array.length);
+        result_type = get_llvm_type(type_cache, type);
 
         if(value.kind == IRConstantValueKind::StaticArrayConstant) {
-            assert(static_array.length == value.static_array.elements.length);
+            assert(static_array.length == value.static_array.length);
 
-            auto elements = allocate<LLVMValueRef>(static_array.length);
+            auto packed = value.static_array.packed;
 
-            for(size_t i = 0; i < static_array.length; i += 1) {
-                elements[i] = get_llvm_constant(architecture_sizes, *static_array.element_type, value.static_array.elements[i]).value;
-            }
+            if(value.static_array.is_packed && packed.element_size == RegisterSize::Size8) {
+                result_value = LLVMConstStringInContext(context, (char*)packed.bytes, (unsigned int)static_array.length, true);
+            } else {
+                auto element_llvm_type = get_llvm_type(type_cache, *static_array.element_type);
+
+                auto elements = allocate<LLVMValueRef>(static_array.length);
+
+                for(size_t i = 0; i < static_array.length; i += 1) {
+                    if(value.static_array.is_packed) {
+                        auto element_value = read_packed_integer(packed.bytes, packed.element_size, packed.is_signed, i);
+
+                        elements[i] = LLVMConstInt(element_llvm_type, element_value, false);
+                    } else {
+                        elements[i] = get_llvm_constant(type_cache, *static_array.element_type, value.static_array.elements[i]).value;
+                    }
+                }
+
+                result_value = LLVMConstArray2(element_llvm_type, elements, type.static_array.length);
 
-            result_value = LLVMConstArray2(element_llvm_type, elements, type.static_array.length);
+                free(elements);
+            }
         } else {
             assert(value.kind == IRConstantValueKind::UndefConstant);
 
@@ -642,33 +940,23 @@ static GetLLVMConstantResult get_llvm_constant(ArchitectureSizes architecture_si
     } else if(type.kind == IRTypeKind::Struct) {
         auto struct_ = type.struct_;
 
-        auto member_types = allocate<LLVMTypeRef>(struct_.members.length);
-        auto member_values = allocate<LLVMValueRef>(struct_.members.length);
+        result_type = get_llvm_type(type_cache, type);
 
         if(value.kind == IRConstantValueKind::StructConstant) {
             assert(struct_.members.length == value.struct_.members.length);
 
-            for(size_t i = 0; i < struct_.members.length; i += 1) {
-                auto result = get_llvm_constant(architecture_sizes, struct_.members[i], value.struct_.members[i]);
+            auto member_values = allocate<LLVMValueRef>(struct_.members.length);
 
-                member_types[i] = result.llvm_type;
-                member_values[i] = result.value;
+            for(size_t i = 0; i < struct_.members.length; i += 1) {
+                member_values[i] = get_llvm_constant(type_cache, struct_.members[i], value.struct_.members[i]).value;
             }
 
-            result_type = LLVMStructType(member_types, struct_.members.length, false);
-            result_value = LLVMConstStruct(member_values, struct_.members.length, false);
+            result_value = LLVMConstStructInContext(context, member_values, struct_.members.length, false);
+
+            free(member_values);
         } else {
             assert(value.kind == IRConstantValueKind::UndefConstant);
 
-            auto member_types = allocate<LLVMTypeRef>(struct_.members.length);
-            for(size_t i = 0; i < struct_.members.length; i += 1) {
-                auto result = get_llvm_type(architecture_sizes, struct_.members[i]);
-
-                member_types[i] = result;
-            }
-
-            result_type = LLVMStructType(member_types, struct_.members.length, false);
-
             result_value = LLVMGetUndef(result_type);
         }
     } else {
@@ -756,260 +1044,124 @@ struct TypedValue {
     LLVMValueRef value;
 };
 
-struct Register {
-    inline Register() = default;
-    explicit inline Register(size_t index, TypedValue value) : index(index), value(value) {}
-
-    size_t index;
-
-    TypedValue value;
-};
-
-static TypedValue get_register_value(Function function, LLVMValueRef function_value, List<Register> registers, size_t register_index) {
-    if(register_index < function.parameters.length) {
-        auto parameter_value = LLVMGetParam(function_value, (unsigned int)register_index);
-        assert(parameter_value != nullptr);
-
-        return TypedValue(function.parameters[register_index], parameter_value);
-    }
+// Registers are numbered densely from zero within a function, starting with its parameters
+static TypedValue get_register_value(Array<TypedValue> registers, size_t register_index) {
+    auto value = registers[register_index];
+    assert(value.value != nullptr);
 
-    for(auto register_ : registers) {
-        if(register_.index == register_index) {
-            return register_.value;
-        }
-    }
-
-    abort();
+    return value;
 }
 
-#define llvm_instruction(variable_name, call) auto variable_name=(call);if(LLVMIsAInstruction(variable_name))LLVMInstructionSetDebugLoc(variable_name, debug_location)
-#define llvm_instruction_ignore(call) { auto value=(call);if(LLVMIsAInstruction(value))LLVMInstructionSetDebugLoc(value, debug_location); }
-
-profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
-    String top_level_source_file_path,
-    Array<RuntimeStatic*> statics,
-    String architecture,
-    String os,
-    String toolchain,
-    String config,
-    String object_file_path,
-    Array<String> reserved_names,
-    bool print
-), (
-    top_level_source_file_path,
-    statics,
-    architecture,
-    os,
-    config,
-    object_file_path,
-    reserved_names,
-    print
-)) {
-    List<NameMapping> name_mappings {};
-
-    for(auto runtime_static : statics) {
-        if(runtime_static->is_no_mangle) {
-            for(auto name_mapping : name_mappings) {
-                if(name_mapping.name == runtime_static->name) {
-                    error(runtime_static->path, runtime_static->range, "Conflicting no_mangle name '%.*s'", STRING_PRINTF_ARGUMENTS(name_mapping.name));
-                    error(name_mapping.runtime_static->path, name_mapping.runtime_static->range, "Conflicing declaration here");
+struct TakenName {
+    String name;
+    uint32_t hash;
 
-                    return err();
-                }
-            }
+    // Null for reserved names
+    RuntimeStatic* runtime_static;
 
-            for(auto reserved_name : reserved_names) {
-                if(reserved_name == runtime_static->name) {
-                    error(runtime_static->path, runtime_static->range, "Runtime name '%.*s' is reserved", STRING_PRINTF_ARGUMENTS(reserved_name));
+    // The next number to try when mangling another static with this as its base name
+    size_t next_suffix;
+};
 
-                    return err();
-                }
-            }
+// Open addressing set of the link names in use, sized up front to hold every static and reserved name
+struct TakenNameTable {
+    TakenName* entries;
+    size_t capacity;
+};
 
-            NameMapping mapping {};
-            mapping.runtime_static = runtime_static;
-            mapping.name = runtime_static->name;
+static TakenName* find_taken_name(TakenNameTable* table, String name, uint32_t hash) {
+    auto entry_index = (size_t)hash & (table->capacity - 1);
+    while(true) {
+        auto entry = &table->entries[entry_index];
 
-            name_mappings.append(mapping);
+        if(entry->name.elements == nullptr) {
+            return nullptr;
         }
-    }
-
-    for(auto runtime_static : statics) {
-        if(!runtime_static->is_no_mangle) {
-            StringBuffer name_buffer {};
-
-            size_t number = 0;
-            while(true) {
-                name_buffer.append(runtime_static->name);
-                if(number != 0) {
-                    name_buffer.append(u8"_"_S);
-                    name_buffer.append_integer(number);
-                }
-
-                auto name_taken = false;
 
-                for(auto name_mapping : name_mappings) {
-                    if(name_mapping.name == name_buffer) {
-                        name_taken = true;
-                        break;
-                    }
-                }
-
-                for(auto reserved_name : reserved_names) {
-                    if(reserved_name == name_buffer) {
-                        name_taken = true;
-                        break;
-                    }
-                }
-
-                if(name_taken) {
-                    name_buffer.length = 0;
-                    number += 1;
-                } else {
-                    NameMapping mapping {};
-                    mapping.runtime_static = runtime_static;
-                    mapping.name = name_buffer;
-
-                    name_mappings.append(mapping);
-
-                    break;
-                }
-            }
+        if(entry->hash == hash && entry->name == name) {
+            return entry;
         }
-    }
-
-    assert(name_mappings.length == statics.length);
-
-    auto architecture_sizes = get_architecture_sizes(architecture);
-
-    auto builder = LLVMCreateBuilder();
-
-    auto module = LLVMModuleCreateWithName("module");
 
-    auto debug_builder = LLVMCreateDIBuilder(module);
-
-    List<FileDebugScope> file_debug_scopes {};
-
-    expect(top_level_source_file_directory, path_get_directory_component(top_level_source_file_path));
-
-    auto top_level_file_debug_scope = LLVMDIBuilderCreateFile(
-        debug_builder,
-        (char*)top_level_source_file_path.elements,
-        top_level_source_file_path.length,
-        (char*)top_level_source_file_directory.elements,
-        top_level_source_file_directory.length
-    );
-
-    {
-        FileDebugScope entry {};
-        entry.path = top_level_source_file_path;
-        entry.scope = top_level_file_debug_scope;
-
-        file_debug_scopes.append(entry);
-    }
-
-    bool should_generate_debug_types;
-    if(config == u8"debug"_S) {
-        should_generate_debug_types = true;
-    } else if(config == u8"release"_S) {
-        should_generate_debug_types = false;
-    } else {
-        abort();
+        entry_index = (entry_index + 1) & (table->capacity - 1);
     }
+}
 
-    LLVMDWARFEmissionKind emission_kind;
-    if(should_generate_debug_types) {
-        emission_kind = LLVMDWARFEmissionFull;
-    } else {
-        emission_kind = LLVMDWARFEmissionLineTablesOnly;
+static void add_taken_name(TakenNameTable* table, String name, uint32_t hash, RuntimeStatic* runtime_static) {
+    auto entry_index = (size_t)hash & (table->capacity - 1);
+    while(table->entries[entry_index].name.elements != nullptr) {
+        entry_index = (entry_index + 1) & (table->capacity - 1);
     }
 
-    auto producer_name = u8"simple-compiler"_S;
-    auto debug_compile_unit = LLVMDIBuilderCreateCompileUnit(
-        debug_builder,
-        LLVMDWARFSourceLanguageC_plus_plus,
-        top_level_file_debug_scope,
-        (char*)producer_name.elements,
-        producer_name.length,
-        false,
-        nullptr,
-        0,
-        0,
-        nullptr, 
-        0,
-        emission_kind,
-        0,
-        false,
-        false,
-        nullptr,
-        0,
-        nullptr,
-        0
-    );
+    auto entry = &table->entries[entry_index];
+    entry->name = name;
+    entry->hash = hash;
+    entry->runtime_static = runtime_static;
+    entry->next_suffix = 1;
+}
 
-    auto global_values = allocate<LLVMValueRef>(statics.length);
+// Adds a global for a static to the module, statics that another partition defines only get a declaration
+static Result<LLVMValueRef> add_llvm_global(
+    LLVMTypeCache* type_cache,
+    LLVMModuleRef module,
+    LLVMDIBuilderRef debug_builder,
+    List<FileDebugScope>* file_debug_scopes,
+    DebugTypeCache* debug_type_cache,
+    ArchitectureSizes architecture_sizes,
+    String architecture,
+    String os,
+    RuntimeStatic* runtime_static,
+    String name,
+    bool is_definition
+) {
+    expect(file_debug_scope, get_file_debug_scope(debug_builder, file_debug_scopes, runtime_static->path));
 
-    for(size_t i = 0; i < statics.length; i += 1) {
-        auto runtime_static = statics[i];
+    LLVMValueRef global_value;
+    if(runtime_static->kind == RuntimeStaticKind::Function) {
+        auto function = (Function*)runtime_static;
 
-        String name;
-        auto found = false;
-        for(auto name_mapping : name_mappings) {
-            if(name_mapping.runtime_static == runtime_static) {
-                name = name_mapping.name;
-                found = true;
+        auto parameter_count = function->parameters.length;
+        auto parameter_llvm_types = allocate<LLVMTypeRef>(parameter_count);
+        for(size_t i = 0; i < parameter_count; i += 1) {
+            auto parameter = function->parameters[i];
 
-                break;
-            }
+            parameter_llvm_types[i] = get_llvm_type(type_cache, parameter);
         }
-        assert(found);
 
-        expect(file_debug_scope, get_file_debug_scope(debug_builder, &file_debug_scopes, runtime_static->path));
-
-        LLVMValueRef global_value;
-        if(runtime_static->kind == RuntimeStaticKind::Function) {
-            auto function = (Function*)runtime_static;
-
-            auto parameter_count = function->parameters.length;
-            auto parameter_llvm_types = allocate<LLVMTypeRef>(parameter_count);
-            for(size_t i = 0; i < parameter_count; i += 1) {
-                auto parameter = function->parameters[i];
-
-                parameter_llvm_types[i] = get_llvm_type(architecture_sizes, parameter);
-            }
-
-            LLVMTypeRef return_llvm_type;
-            if(function->has_return) {
-                return_llvm_type = get_llvm_type(architecture_sizes, function->return_type);
-            } else {
-                return_llvm_type = LLVMVoidType();
-            }
+        LLVMTypeRef return_llvm_type;
+        if(function->has_return) {
+            return_llvm_type = get_llvm_type(type_cache, function->return_type);
+        } else {
+            return_llvm_type = LLVMVoidTypeInContext(type_cache->context);
+        }
 
-            auto function_llvm_type = LLVMFunctionType(return_llvm_type, parameter_llvm_types, (unsigned int)parameter_count, false);
+        auto function_llvm_type = LLVMFunctionType(return_llvm_type, parameter_llvm_types, (unsigned int)parameter_count, false);
 
-            global_value = LLVMAddFunction(module, name.to_c_string(), function_llvm_type);
+        global_value = LLVMAddFunction(module, name.to_c_string(), function_llvm_type);
 
-            if(function->is_external) {
-                LLVMSetLinkage(global_value, LLVMLinkage::LLVMExternalLinkage);
-            }
+        if(function->is_external) {
+            LLVMSetLinkage(global_value, LLVMLinkage::LLVMExternalLinkage);
+        }
 
-            expect(calling_convention, get_llvm_calling_convention(function->path, function->range, os, architecture, function->calling_convention));
+        expect(calling_convention, get_llvm_calling_convention(function->path, function->range, os, architecture, function->calling_convention));
 
-            LLVMSetFunctionCallConv(global_value, calling_convention);
-        } else if(runtime_static->kind == RuntimeStaticKind::StaticConstant) {
-            auto constant = (StaticConstant*)runtime_static;
+        LLVMSetFunctionCallConv(global_value, calling_convention);
+    } else if(runtime_static->kind == RuntimeStaticKind::StaticConstant) {
+        auto constant = (StaticConstant*)runtime_static;
 
-            auto llvm_type = get_llvm_type(architecture_sizes, constant->type);
+        auto llvm_type = get_llvm_type(type_cache, constant->type);
 
-            global_value = LLVMAddGlobal(module, llvm_type, name.to_c_string());
-            LLVMSetGlobalConstant(global_value, true);
+        global_value = LLVMAddGlobal(module, llvm_type, name.to_c_string());
+        LLVMSetGlobalConstant(global_value, true);
+        LLVMSetUnnamedAddress(global_value, LLVMGlobalUnnamedAddr);
 
-            auto constant_value_llvm = get_llvm_constant(architecture_sizes, constant->type, constant->value).value;
+        if(is_definition) {
+            auto constant_value_llvm = get_llvm_constant(type_cache, constant->type, constant->value).value;
             LLVMSetInitializer(global_value, constant_value_llvm);
 
             expect(debug_type, get_llvm_debug_type(
                 debug_builder,
-                &file_debug_scopes,
+                file_debug_scopes,
+                debug_type_cache,
                 file_debug_scope,
                 architecture_sizes,
                 constant->debug_type
@@ -1034,24 +1186,27 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
             );
 
             LLVMGlobalSetMetadata(global_value, llvm::LLVMContext::MD_dbg, debug_variable_expression);
-        } else if(runtime_static->kind == RuntimeStaticKind::StaticVariable) {
-            auto variable = (StaticVariable*)runtime_static;
+        }
+    } else if(runtime_static->kind == RuntimeStaticKind::StaticVariable) {
+        auto variable = (StaticVariable*)runtime_static;
 
-            auto llvm_type = get_llvm_type(architecture_sizes, variable->type);
+        auto llvm_type = get_llvm_type(type_cache, variable->type);
 
-            global_value = LLVMAddGlobal(module, llvm_type, name.to_c_string());
+        global_value = LLVMAddGlobal(module, llvm_type, name.to_c_string());
 
-            if(variable->is_external) {
-                LLVMSetLinkage(global_value, LLVMLinkage::LLVMExternalLinkage);
-            } else if(variable->has_initial_value) {
-                auto initial_value_llvm = get_llvm_constant(architecture_sizes, variable->type, variable->initial_value).value;
+        if(variable->is_external) {
+            LLVMSetLinkage(global_value, LLVMLinkage::LLVMExternalLinkage);
+        } else if(is_definition && variable->has_initial_value) {
+            auto initial_value_llvm = get_llvm_constant(type_cache, variable->type, variable->initial_value).value;
 
-                LLVMSetInitializer(global_value, initial_value_llvm);
-            }
+            LLVMSetInitializer(global_value, initial_value_llvm);
+        }
 
+        if(is_definition) {
             expect(debug_type, get_llvm_debug_type(
                 debug_builder,
-                &file_debug_scopes,
+                file_debug_scopes,
+                debug_type_cache,
                 file_debug_scope,
                 architecture_sizes,
                 variable->debug_type
@@ -1076,37 +1231,166 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
             );
 
             LLVMGlobalSetMetadata(global_value, llvm::LLVMContext::MD_dbg, debug_variable_expression);
-        } else {
-            abort();
         }
+    } else {
+        abort();
+    }
+
+    return ok(global_value);
+}
+
+#define llvm_instruction(variable_name, call) auto variable_name=(call);if(LLVMIsAInstruction(variable_name))LLVMInstructionSetDebugLoc(variable_name, debug_location)
+#define llvm_instruction_ignore(call) { auto value=(call);if(LLVMIsAInstruction(value))LLVMInstructionSetDebugLoc(value, debug_location); }
+
+struct LLVMObjectInfo {
+    String top_level_source_file_path;
+    Array<RuntimeStatic*> statics;
+    String* link_names;
+
+    String architecture;
+    String os;
+    String config;
+    String optimization_level;
+    ArchitectureSizes architecture_sizes;
+
+    LLVMTargetRef target;
+    String triple;
+    String features;
+    LLVMCodeGenOptLevel code_generation_level;
+
+    bool print;
+};
+
+struct LLVMPartition {
+    LLVMObjectInfo* info;
+
+    // Statics this partition defines, any others it references are only declared
+    List<RuntimeStatic*> statics;
+
+    String object_file_path;
+
+    char* module_text;
+
+    bool succeeded;
+};
+
+// Each partition gets its own LLVM context, so partitions can be lowered and compiled on separate threads
+static Result<void> generate_llvm_partition(LLVMPartition* partition) {
+    auto info = partition->info;
+
+    auto top_level_source_file_path = info->top_level_source_file_path;
+    auto architecture_sizes = info->architecture_sizes;
+
+    auto context = LLVMContextCreate();
+
+    auto builder = LLVMCreateBuilderInContext(context);
+
+    auto module = LLVMModuleCreateWithNameInContext("module", context);
+
+    LLVMTypeCache type_cache {};
+    type_cache.context = context;
+    type_cache.architecture_sizes = architecture_sizes;
+
+    auto debug_builder = LLVMCreateDIBuilder(module);
+
+    List<FileDebugScope> file_debug_scopes {};
+
+    DebugTypeCache debug_type_cache {};
+
+    expect(top_level_source_file_directory, path_get_directory_component(top_level_source_file_path));
+
+    auto top_level_file_debug_scope = LLVMDIBuilderCreateFile(
+        debug_builder,
+        (char*)top_level_source_file_path.elements,
+        top_level_source_file_path.length,
+        (char*)top_level_source_file_directory.elements,
+        top_level_source_file_directory.length
+    );
+
+    {
+        FileDebugScope entry {};
+        entry.path = top_level_source_file_path;
+        entry.scope = top_level_file_debug_scope;
+
+        file_debug_scopes.append(entry);
+    }
+
+    bool should_generate_debug_types;
+    if(info->config == u8"debug"_S) {
+        should_generate_debug_types = true;
+    } else if(info->config == u8"release"_S) {
+        should_generate_debug_types = false;
+    } else {
+        abort();
+    }
+
+    LLVMDWARFEmissionKind emission_kind;
+    if(should_generate_debug_types) {
+        emission_kind = LLVMDWARFEmissionFull;
+    } else {
+        emission_kind = LLVMDWARFEmissionLineTablesOnly;
+    }
+
+    auto producer_name = u8"simple-compiler"_S;
+    auto debug_compile_unit = LLVMDIBuilderCreateCompileUnit(
+        debug_builder,
+        LLVMDWARFSourceLanguageC_plus_plus,
+        top_level_file_debug_scope,
+        (char*)producer_name.elements,
+        producer_name.length,
+        false,
+        nullptr,
+        0,
+        0,
+        nullptr, 
+        0,
+        emission_kind,
+        0,
+        false,
+        false,
+        nullptr,
+        0,
+        nullptr,
+        0
+    );
 
-        global_values[i] = global_value;
-    }
+    // Statics from other partitions are declared the first time they are referenced
+    auto global_values = allocate<LLVMValueRef>(info->statics.length);
+    memset(global_values, 0, info->statics.length * sizeof(LLVMValueRef));
 
-    for(size_t i = 0; i < statics.length; i += 1) {
-        auto runtime_static = statics[i];
+    for(auto runtime_static : partition->statics) {
+        expect(global_value, add_llvm_global(
+            &type_cache,
+            module,
+            debug_builder,
+            &file_debug_scopes,
+            &debug_type_cache,
+            architecture_sizes,
+            info->architecture,
+            info->os,
+            runtime_static,
+            info->link_names[runtime_static->index],
+            true
+        ));
 
-        String link_name;
-        auto found = false;
-        for(auto name_mapping : name_mappings) {
-            if(name_mapping.runtime_static == runtime_static) {
-                link_name = name_mapping.name;
-                found = true;
+        global_values[runtime_static->index] = global_value;
+    }
 
-                break;
-            }
-        }
-        assert(found);
+    for(auto runtime_static : partition->statics) {
+        auto link_name = info->link_names[runtime_static->index];
 
         if(runtime_static->kind == RuntimeStaticKind::Function) {
             auto function = (Function*)runtime_static;
 
-            auto function_value = global_values[i];
+            auto function_value = global_values[runtime_static->index];
 
             if(!function->is_external) {
-                auto entry_llvm_block = LLVMAppendBasicBlock(function_value, "entry");
+                // Holds temporary data for generating this function
+                Arena scratch_arena {};
+
+                auto entry_llvm_block = LLVMAppendBasicBlockInContext(context, function_value, "entry");
 
-                auto llvm_blocks = allocate<LLVMBasicBlockRef>(function->blocks.length);
+                auto llvm_blocks = allocate<LLVMBasicBlockRef>(&scratch_arena, function->blocks.length);
 
                 for(size_t i = 0; i < function->blocks.length; i += 1) {
                     auto block = function->blocks[i];
@@ -1115,24 +1399,22 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                     block_name.append(u8"block_"_S);
                     block_name.append_integer(i);
 
-                    llvm_blocks[i] = LLVMAppendBasicBlock(function_value, block_name.to_c_string());
+                    llvm_blocks[i] = LLVMAppendBasicBlockInContext(context, function_value, block_name.to_c_string());
                 }
 
-                List<Register> registers {};
-
-                struct Local {
-                    AllocateLocal* allocate_local;
-
-                    LLVMValueRef pointer_value;
-                };
+                auto registers = Array(function->register_count, allocate<TypedValue>(&scratch_arena, function->register_count));
+                memset(registers.elements, 0, function->register_count * sizeof(TypedValue));
 
-                List<Local> locals {};
+                for(size_t i = 0; i < function->parameters.length; i += 1) {
+                    registers[i] = TypedValue(function->parameters[i], LLVMGetParam(function_value, (unsigned int)i));
+                }
 
                 expect(file_debug_scope, get_file_debug_scope(debug_builder, &file_debug_scopes, function->path));
 
                 expect(function_debug_type, get_llvm_debug_type(
                     debug_builder,
                     &file_debug_scopes,
+                    &debug_type_cache,
                     file_debug_scope,
                     architecture_sizes,
                     function->debug_type
@@ -1157,45 +1439,27 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
 
                 LLVMSetSubprogram(function_value, function_debug_scope);
 
-                auto debug_variable_scopes = allocate<LLVMMetadataRef>(function->debug_scopes.length);
+                auto debug_variable_scopes = allocate<LLVMMetadataRef>(&scratch_arena, function->debug_scopes.length);
 
                 for(size_t i = 0; i < function->debug_scopes.length; i += 1) {
-                    debug_variable_scopes[i] = nullptr;
-                }
-
-                while(true) {
-                    auto work_done = false;
-                    for(size_t i = 0; i < function->debug_scopes.length; i += 1) {
-                        if(debug_variable_scopes[i] == nullptr) {
-                            auto debug_scope = function->debug_scopes[i];
-
-                            if(!debug_scope.has_parent) {
-                                debug_variable_scopes[i] = LLVMDIBuilderCreateLexicalBlock(
-                                    debug_builder,
-                                    function_debug_scope,
-                                    file_debug_scope,
-                                    debug_scope.range.first_line,
-                                    debug_scope.range.first_column
-                                );
+                    auto debug_scope = function->debug_scopes[i];
 
-                                work_done = true;
-                            } else if(debug_variable_scopes[debug_scope.parent_scope_index] != nullptr) {
-                                debug_variable_scopes[i] = LLVMDIBuilderCreateLexicalBlock(
-                                    debug_builder,
-                                    debug_variable_scopes[debug_scope.parent_scope_index],
-                                    file_debug_scope,
-                                    debug_scope.range.first_line,
-                                    debug_scope.range.first_column
-                                );
+                    LLVMMetadataRef parent_debug_scope;
+                    if(debug_scope.has_parent) {
+                        assert(debug_scope.parent_scope_index < i);
 
-                                work_done = true;
-                            }
-                        }
+                        parent_debug_scope = debug_variable_scopes[debug_scope.parent_scope_index];
+                    } else {
+                        parent_debug_scope = function_debug_scope;
                     }
 
-                    if(!work_done) {
-                        break;
-                    }
+                    debug_variable_scopes[i] = LLVMDIBuilderCreateLexicalBlock(
+                        debug_builder,
+                        parent_debug_scope,
+                        file_debug_scope,
+                        debug_scope.range.first_line,
+                        debug_scope.range.first_column
+                    );
                 }
 
                 LLVMPositionBuilderAtEnd(builder, entry_llvm_block);
@@ -1208,14 +1472,14 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                             auto debug_variable_scope = debug_variable_scopes[instruction->debug_scope_index];
 
                             auto debug_location = LLVMDIBuilderCreateDebugLocation(
-                                LLVMGetGlobalContext(),
+                                context,
                                 allocate_local->range.first_line,
                                 allocate_local->range.first_column,
                                 debug_variable_scope,
                                 nullptr
                             );
 
-                            auto llvm_type = get_llvm_type(architecture_sizes, allocate_local->type);
+                            auto llvm_type = get_llvm_type(&type_cache, allocate_local->type);
 
                             auto pointer_value = LLVMBuildAlloca(builder, llvm_type, "allocate_local");
                             if(!allocate_local->has_debug_info) {
@@ -1224,6 +1488,7 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                                 expect(debug_type, get_llvm_debug_type(
                                     debug_builder,
                                     &file_debug_scopes,
+                                    &debug_type_cache,
                                     file_debug_scope,
                                     architecture_sizes,
                                     allocate_local->debug_type
@@ -1254,11 +1519,8 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                                 );
                             }
 
-                            Local local {};
-                            local.allocate_local = allocate_local;
-                            local.pointer_value = pointer_value;
-
-                            locals.append(local);
+                            // Locals are all allocated in the entry block, before any code that uses them
+                            registers[allocate_local->destination_register] = TypedValue(IRType::create_pointer(), pointer_value);
                         }
                     }
                 }
@@ -1276,7 +1538,7 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                         auto debug_variable_scope = debug_variable_scopes[instruction->debug_scope_index];
 
                         auto debug_location = LLVMDIBuilderCreateDebugLocation(
-                            LLVMGetGlobalContext(),
+                            context,
                             instruction->range.first_line,
                             instruction->range.first_column,
                             debug_variable_scope,
@@ -1286,8 +1548,8 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                         if(instruction->kind == InstructionKind::IntegerArithmeticOperation) {
                             auto integer_arithmetic_operation = (IntegerArithmeticOperation*)instruction;
 
-                            auto source_value_a = get_register_value(*function, function_value, registers, integer_arithmetic_operation->source_register_a);
-                            auto source_value_b = get_register_value(*function, function_value, registers, integer_arithmetic_operation->source_register_b);
+                            auto source_value_a = get_register_value(registers, integer_arithmetic_operation->source_register_a);
+                            auto source_value_b = get_register_value(registers, integer_arithmetic_operation->source_register_b);
 
                             assert(source_value_a.type.kind == IRTypeKind::Integer);
                             assert(source_value_b.type.kind == IRTypeKind::Integer);
@@ -1355,15 +1617,12 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                                 } break;
                             }
 
-                            registers.append(Register(
-                                integer_arithmetic_operation->destination_register,
-                                TypedValue(source_value_a.type, value)
-                            ));
+                            registers[integer_arithmetic_operation->destination_register] = TypedValue(source_value_a.type, value);
                         } else if(instruction->kind == InstructionKind::IntegerComparisonOperation) {
                             auto integer_comparison_operation = (IntegerComparisonOperation*)instruction;
 
-                            auto source_value_a = get_register_value(*function, function_value, registers, integer_comparison_operation->source_register_a);
-                            auto source_value_b = get_register_value(*function, function_value, registers, integer_comparison_operation->source_register_b);
+                            auto source_value_a = get_register_value(registers, integer_comparison_operation->source_register_a);
+                            auto source_value_b = get_register_value(registers, integer_comparison_operation->source_register_b);
 
                             assert(source_value_a.type.kind == IRTypeKind::Integer);
                             assert(source_value_b.type.kind == IRTypeKind::Integer);
@@ -1407,21 +1666,18 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
 
                             llvm_instruction(value, LLVMBuildICmp(builder, predicate, value_a, value_b, name));
 
-                            llvm_instruction(extended_value, LLVMBuildZExt(builder, value, get_llvm_integer_type(architecture_sizes.boolean_size), "extend"));
+                            llvm_instruction(extended_value, LLVMBuildZExt(builder, value, get_llvm_integer_type(context, architecture_sizes.boolean_size), "extend"));
 
-                            registers.append(Register(
-                                integer_comparison_operation->destination_register,
-                                TypedValue(IRType::create_boolean(), extended_value)
-                            ));
+                            registers[integer_comparison_operation->destination_register] = TypedValue(IRType::create_boolean(), extended_value);
                         } else if(instruction->kind == InstructionKind::IntegerExtension) {
                             auto integer_extension = (IntegerExtension*)instruction;
 
-                            auto source_value = get_register_value(*function, function_value, registers, integer_extension->source_register);
+                            auto source_value = get_register_value(registers, integer_extension->source_register);
 
                             assert(source_value.type.kind == IRTypeKind::Integer);
 
                             auto destination_ir_type = IRType::create_integer(integer_extension->destination_size);
-                            auto destination_llvm_type = get_llvm_integer_type(integer_extension->destination_size);
+                            auto destination_llvm_type = get_llvm_integer_type(context, integer_extension->destination_size);
 
                             assert(integer_extension->destination_size > source_value.type.integer.size);
 
@@ -1436,19 +1692,16 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                                 LLVMInstructionSetDebugLoc(value, debug_location);
                             }
 
-                            registers.append(Register(
-                                integer_extension->destination_register,
-                                TypedValue(destination_ir_type, value)
-                            ));
+                            registers[integer_extension->destination_register] = TypedValue(destination_ir_type, value);
                         } else if(instruction->kind == InstructionKind::IntegerTruncation) {
                             auto integer_truncation = (IntegerTruncation*)instruction;
 
-                            auto source_value = get_register_value(*function, function_value, registers, integer_truncation->source_register);
+                            auto source_value = get_register_value(registers, integer_truncation->source_register);
 
                             assert(source_value.type.kind == IRTypeKind::Integer);
 
                             auto destination_ir_type = IRType::create_integer(integer_truncation->destination_size);
-                            auto destination_llvm_type = get_llvm_integer_type(integer_truncation->destination_size);
+                            auto destination_llvm_type = get_llvm_integer_type(context, integer_truncation->destination_size);
 
                             assert(integer_truncation->destination_size < source_value.type.integer.size);
 
@@ -1459,15 +1712,12 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                                 "truncate"
                             ));
 
-                            registers.append(Register(
-                                integer_truncation->destination_register,
-                                TypedValue(destination_ir_type, value)
-                            ));
+                            registers[integer_truncation->destination_register] = TypedValue(destination_ir_type, value);
                         } else if(instruction->kind == InstructionKind::FloatArithmeticOperation) {
                             auto float_arithmetic_operation = (FloatArithmeticOperation*)instruction;
 
-                            auto source_value_a = get_register_value(*function, function_value, registers, float_arithmetic_operation->source_register_a);
-                            auto source_value_b = get_register_value(*function, function_value, registers, float_arithmetic_operation->source_register_b);
+                            auto source_value_a = get_register_value(registers, float_arithmetic_operation->source_register_a);
+                            auto source_value_b = get_register_value(registers, float_arithmetic_operation->source_register_b);
 
                             assert(source_value_a.type.kind == IRTypeKind::Float);
                             assert(source_value_b.type.kind == IRTypeKind::Float);
@@ -1507,15 +1757,12 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                                 LLVMInstructionSetDebugLoc(value, debug_location);
                             }
 
-                            registers.append(Register(
-                                float_arithmetic_operation->destination_register,
-                                TypedValue(source_value_a.type, value)
-                            ));
+                            registers[float_arithmetic_operation->destination_register] = TypedValue(source_value_a.type, value);
                         } else if(instruction->kind == InstructionKind::FloatComparisonOperation) {
                             auto float_comparison_operation = (FloatComparisonOperation*)instruction;
 
-                            auto source_value_a = get_register_value(*function, function_value, registers, float_comparison_operation->source_register_a);
-                            auto source_value_b = get_register_value(*function, function_value, registers, float_comparison_operation->source_register_b);
+                            auto source_value_a = get_register_value(registers, float_comparison_operation->source_register_a);
+                            auto source_value_b = get_register_value(registers, float_comparison_operation->source_register_b);
 
                             assert(source_value_a.type.kind == IRTypeKind::Float);
                             assert(source_value_b.type.kind == IRTypeKind::Float);
@@ -1549,64 +1796,52 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
 
                             llvm_instruction(value, LLVMBuildFCmp(builder, predicate, value_a, value_b, name));
 
-                            llvm_instruction(extended_value, LLVMBuildZExt(builder, value, get_llvm_integer_type(architecture_sizes.boolean_size), "extend"));
+                            llvm_instruction(extended_value, LLVMBuildZExt(builder, value, get_llvm_integer_type(context, architecture_sizes.boolean_size), "extend"));
 
-                            registers.append(Register(
-                                float_comparison_operation->destination_register,
-                                TypedValue(IRType::create_boolean(), extended_value)
-                            ));
+                            registers[float_comparison_operation->destination_register] = TypedValue(IRType::create_boolean(), extended_value);
                         } else if(instruction->kind == InstructionKind::FloatConversion) {
                             auto float_conversion = (FloatConversion*)instruction;
 
-                            auto source_value = get_register_value(*function, function_value, registers, float_conversion->source_register);
+                            auto source_value = get_register_value(registers, float_conversion->source_register);
 
                             assert(source_value.type.kind == IRTypeKind::Float);
 
-                            auto destination_llvm_type = get_llvm_float_type(float_conversion->destination_size);
+                            auto destination_llvm_type = get_llvm_float_type(context, float_conversion->destination_size);
 
                             llvm_instruction(value, LLVMBuildFPCast(builder, source_value.value, destination_llvm_type, "float_conversion"));
 
-                            registers.append(Register(
-                                float_conversion->destination_register,
-                                TypedValue(source_value.type, value)
-                            ));
+                            registers[float_conversion->destination_register] = TypedValue(source_value.type, value);
                         } else if(instruction->kind == InstructionKind::IntegerFromFloat) {
                             auto integer_from_float = (IntegerFromFloat*)instruction;
 
-                            auto source_value = get_register_value(*function, function_value, registers, integer_from_float->source_register);
+                            auto source_value = get_register_value(registers, integer_from_float->source_register);
 
                             assert(source_value.type.kind == IRTypeKind::Float);
 
                             auto destination_ir_type = IRType::create_integer(integer_from_float->destination_size);
-                            auto destination_llvm_type = get_llvm_integer_type(integer_from_float->destination_size);
+                            auto destination_llvm_type = get_llvm_integer_type(context, integer_from_float->destination_size);
 
                             llvm_instruction(value, LLVMBuildFPToSI(builder, source_value.value, destination_llvm_type, "integer_from_float"));
 
-                            registers.append(Register(
-                                integer_from_float->destination_register,
-                                TypedValue(destination_ir_type, value)
-                            ));
+                            registers[integer_from_float->destination_register] = TypedValue(destination_ir_type, value);
                         } else if(instruction->kind == InstructionKind::FloatFromInteger) {
                             auto float_from_integer = (FloatFromInteger*)instruction;
 
-                            auto source_value = get_register_value(*function, function_value, registers, float_from_integer->source_register);
+                            auto source_value = get_register_value(registers, float_from_integer->source_register);
 
                             assert(source_value.type.kind == IRTypeKind::Integer);
 
                             auto destination_ir_type = IRType::create_float(float_from_integer->destination_size);
-                            auto destination_llvm_type = get_llvm_float_type(float_from_integer->destination_size);
+                            auto destination_llvm_type = get_llvm_float_type(context, float_from_integer->destination_size);
 
                             llvm_instruction(value, LLVMBuildSIToFP(builder, source_value.value, destination_llvm_type, "float_from_integer"));
 
-                            registers.append(Register(
-                                float_from_integer->destination_register,
-                                TypedValue(destination_ir_type, value)
-                            ));
+                            registers[float_from_integer->destination_register] = TypedValue(destination_ir_type, value);
                         } else if(instruction->kind == InstructionKind::PointerEquality) {
                             auto pointer_equality = (PointerEquality*)instruction;
 
-                            auto source_value_a = get_register_value(*function, function_value, registers, pointer_equality->source_register_a);
-                            auto source_value_b = get_register_value(*function, function_value, registers, pointer_equality->source_register_b);
+                            auto source_value_a = get_register_value(registers, pointer_equality->source_register_a);
+                            auto source_value_b = get_register_value(registers, pointer_equality->source_register_b);
 
                             assert(source_value_a.type.kind == IRTypeKind::Pointer);
                             assert(source_value_b.type.kind == IRTypeKind::Pointer);
@@ -1614,63 +1849,54 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                             auto value_a = source_value_a.value;
                             auto value_b = source_value_b.value;
 
-                            auto integer_llvm_type = get_llvm_integer_type(architecture_sizes.address_size);
+                            auto integer_llvm_type = get_llvm_integer_type(context, architecture_sizes.address_size);
 
-                            auto pointer_llvm_type = get_llvm_type(architecture_sizes, source_value_a.type);
+                            auto pointer_llvm_type = get_llvm_type(&type_cache, source_value_a.type);
 
                             llvm_instruction(integer_value_a, LLVMBuildPtrToInt(builder, value_a, integer_llvm_type, "pointer_to_int"));
                             llvm_instruction(integer_value_b, LLVMBuildPtrToInt(builder, value_b, integer_llvm_type, "pointer_to_int"));
 
                             llvm_instruction(value, LLVMBuildICmp(builder, LLVMIntPredicate::LLVMIntEQ, integer_value_a, integer_value_b, "pointer_equality"));
 
-                            llvm_instruction(extended_value, LLVMBuildZExt(builder, value, get_llvm_integer_type(architecture_sizes.boolean_size), "extend"));
+                            llvm_instruction(extended_value, LLVMBuildZExt(builder, value, get_llvm_integer_type(context, architecture_sizes.boolean_size), "extend"));
 
-                            registers.append(Register(
-                                pointer_equality->destination_register,
-                                TypedValue(IRType::create_boolean(), extended_value)
-                            ));
+                            registers[pointer_equality->destination_register] = TypedValue(IRType::create_boolean(), extended_value);
                         } else if(instruction->kind == InstructionKind::PointerFromInteger) {
                             auto pointer_from_integer = (PointerFromInteger*)instruction;
 
-                            auto source_value = get_register_value(*function, function_value, registers, pointer_from_integer->source_register);
+                            auto source_value = get_register_value(registers, pointer_from_integer->source_register);
 
                             assert(source_value.type.kind == IRTypeKind::Integer);
 
-                            auto destination_llvm_type = get_llvm_pointer_type(architecture_sizes);
+                            auto destination_llvm_type = get_llvm_pointer_type(context, architecture_sizes);
 
                             llvm_instruction(result_value, LLVMBuildIntToPtr(builder, source_value.value, destination_llvm_type, "integer_to_pointer"));
 
-                            registers.append(Register(
-                                pointer_from_integer->destination_register,
-                                TypedValue(IRType::create_pointer(), result_value)
-                            ));
+                            registers[pointer_from_integer->destination_register] = TypedValue(IRType::create_pointer(), result_value);
                         } else if(instruction->kind == InstructionKind::IntegerFromPointer) {
                             auto integer_from_pointer = (IntegerFromPointer*)instruction;
 
-                            auto source_value = get_register_value(*function, function_value, registers, integer_from_pointer->source_register);
+                            auto source_value = get_register_value(registers, integer_from_pointer->source_register);
 
                             assert(source_value.type.kind == IRTypeKind::Pointer);
 
                             auto destination_type = IRType::create_integer(integer_from_pointer->destination_size);
-                            auto destination_llvm_type = get_llvm_integer_type(integer_from_pointer->destination_size);
+                            auto destination_llvm_type = get_llvm_integer_type(context, integer_from_pointer->destination_size);
 
                             llvm_instruction(result_value, LLVMBuildPtrToInt(builder, source_value.value, destination_llvm_type, "pointer_to_integer"));
 
-                            registers.append(Register(
-                                integer_from_pointer->destination_register,
-                                TypedValue(destination_type, result_value)
-                            ));
+                            registers[integer_from_pointer->destination_register] = TypedValue(destination_type, result_value);
                         } else if(instruction->kind == InstructionKind::BooleanArithmeticOperation) {
                             auto boolean_arithmetic_operation = (BooleanArithmeticOperation*)instruction;
 
-                            auto source_value_a = get_register_value(*function, function_value, registers, boolean_arithmetic_operation->source_register_a);
-                            auto source_value_b = get_register_value(*function, function_value, registers, boolean_arithmetic_operation->source_register_b);
+                            auto source_value_a = get_register_value(registers, boolean_arithmetic_operation->source_register_a);
+                            auto source_value_b = get_register_value(registers, boolean_arithmetic_operation->source_register_b);
 
                             assert(source_value_a.type.kind == IRTypeKind::Boolean);
                             assert(source_value_b.type.kind == IRTypeKind::Boolean);
 
-                            llvm_instruction(value_a, LLVMBuildTrunc(builder, source_value_a.value, LLVMInt1Type(), "truncate"));
-                            llvm_instruction(value_b, LLVMBuildTrunc(builder, source_value_b.value, LLVMInt1Type(), "truncate"));
+                            llvm_instruction(value_a, LLVMBuildTrunc(builder, source_value_a.value, LLVMInt1TypeInContext(context), "truncate"));
+                            llvm_instruction(value_b, LLVMBuildTrunc(builder, source_value_b.value, LLVMInt1TypeInContext(context), "truncate"));
 
                             LLVMValueRef value;
                             switch(boolean_arithmetic_operation->operation) {
@@ -1694,63 +1920,54 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                             llvm_instruction(extended_value, LLVMBuildZExt(
                                 builder,
                                 value,
-                                get_llvm_integer_type(architecture_sizes.boolean_size),
+                                get_llvm_integer_type(context, architecture_sizes.boolean_size),
                                 "extend"
                             ));
 
-                            registers.append(Register(
-                                boolean_arithmetic_operation->destination_register,
-                                TypedValue(source_value_a.type, extended_value)
-                            ));
+                            registers[boolean_arithmetic_operation->destination_register] = TypedValue(source_value_a.type, extended_value);
                         } else if(instruction->kind == InstructionKind::BooleanEquality) {
                             auto boolean_equality = (BooleanEquality*)instruction;
 
-                            auto source_value_a = get_register_value(*function, function_value, registers, boolean_equality->source_register_a);
-                            auto source_value_b = get_register_value(*function, function_value, registers, boolean_equality->source_register_b);
+                            auto source_value_a = get_register_value(registers, boolean_equality->source_register_a);
+                            auto source_value_b = get_register_value(registers, boolean_equality->source_register_b);
 
                             assert(source_value_a.type.kind == IRTypeKind::Boolean);
                             assert(source_value_b.type.kind == IRTypeKind::Boolean);
 
-                            llvm_instruction(value_a, LLVMBuildTrunc(builder, source_value_a.value, LLVMInt1Type(), "truncate"));
-                            llvm_instruction(value_b, LLVMBuildTrunc(builder, source_value_b.value, LLVMInt1Type(), "truncate"));
+                            llvm_instruction(value_a, LLVMBuildTrunc(builder, source_value_a.value, LLVMInt1TypeInContext(context), "truncate"));
+                            llvm_instruction(value_b, LLVMBuildTrunc(builder, source_value_b.value, LLVMInt1TypeInContext(context), "truncate"));
 
                             llvm_instruction(value, LLVMBuildICmp(builder, LLVMIntPredicate::LLVMIntEQ, value_a, value_b, "pointer_equality"));
 
-                            llvm_instruction(extended_value, LLVMBuildZExt(builder, value, get_llvm_integer_type(architecture_sizes.boolean_size), "extend"));
+                            llvm_instruction(extended_value, LLVMBuildZExt(builder, value, get_llvm_integer_type(context, architecture_sizes.boolean_size), "extend"));
 
-                            registers.append(Register(
-                                boolean_equality->destination_register,
-                                TypedValue(IRType::create_boolean(), extended_value)
-                            ));
+                            registers[boolean_equality->destination_register] = TypedValue(IRType::create_boolean(), extended_value);
                         } else if(instruction->kind == InstructionKind::BooleanInversion) {
                             auto boolean_inversion = (BooleanInversion*)instruction;
 
-                            auto source_value = get_register_value(*function, function_value, registers, boolean_inversion->source_register);
+                            auto source_value = get_register_value(registers, boolean_inversion->source_register);
 
                             assert(source_value.type.kind == IRTypeKind::Boolean);
 
-                            llvm_instruction(value, LLVMBuildTrunc(builder, source_value.value, LLVMInt1Type(), "truncate"));
+                            llvm_instruction(value, LLVMBuildTrunc(builder, source_value.value, LLVMInt1TypeInContext(context), "truncate"));
 
                             llvm_instruction(result_value, LLVMBuildNot(builder, value, "boolean_inversion"));
 
-                            llvm_instruction(extended_value, LLVMBuildZExt(builder, result_value, get_llvm_integer_type(architecture_sizes.boolean_size), "extend"));
+                            llvm_instruction(extended_value, LLVMBuildZExt(builder, result_value, get_llvm_integer_type(context, architecture_sizes.boolean_size), "extend"));
 
-                            registers.append(Register(
-                                boolean_inversion->destination_register,
-                                TypedValue(IRType::create_boolean(), extended_value)
-                            ));
+                            registers[boolean_inversion->destination_register] = TypedValue(IRType::create_boolean(), extended_value);
                         } else if(instruction->kind == InstructionKind::AssembleStaticArray) {
                             auto assemble_static_array = (AssembleStaticArray*)instruction;
 
-                            auto first_element_value = get_register_value(*function, function_value, registers, assemble_static_array->element_registers[0]);
+                            auto first_element_value = get_register_value(registers, assemble_static_array->element_registers[0]);
 
-                            auto element_llvm_type = get_llvm_type(architecture_sizes, first_element_value.type);
+                            auto element_llvm_type = get_llvm_type(&type_cache, first_element_value.type);
                             auto llvm_type = LLVMArrayType2(element_llvm_type, assemble_static_array->element_registers.length);
 
-                            auto initial_constant_values = allocate<LLVMValueRef>(assemble_static_array->element_registers.length);
+                            auto initial_constant_values = allocate<LLVMValueRef>(&scratch_arena, assemble_static_array->element_registers.length);
 
                             for(size_t i = 1; i < assemble_static_array->element_registers.length; i += 1) {
-                                auto element_value = get_register_value(*function, function_value, registers, assemble_static_array->element_registers[i]);
+                                auto element_value = get_register_value(registers, assemble_static_array->element_registers[i]);
 
                                 assert(element_value.type == first_element_value.type);
 
@@ -1780,7 +1997,7 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                             }
 
                             for(size_t i = 1; i < assemble_static_array->element_registers.length; i += 1) {
-                                auto element_value = get_register_value(*function, function_value, registers, assemble_static_array->element_registers[i]);
+                                auto element_value = get_register_value(registers, assemble_static_array->element_registers[i]);
 
                                 if(!LLVMIsConstant(element_value.value)) {
                                     current_array_value = LLVMBuildInsertValue(
@@ -1799,17 +2016,14 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
 
                             auto type = IRType::create_static_array(
                                 assemble_static_array->element_registers.length,
-                                heapify(first_element_value.type)
+                                heapify(&scratch_arena, first_element_value.type)
                             );
 
-                            registers.append(Register(
-                                assemble_static_array->destination_register,
-                                TypedValue(type, current_array_value)
-                            ));
+                            registers[assemble_static_array->destination_register] = TypedValue(type, current_array_value);
                         } else if(instruction->kind == InstructionKind::ReadStaticArrayElement) {
                             auto read_static_array_element = (ReadStaticArrayElement*)instruction;
 
-                            auto source_value = get_register_value(*function, function_value, registers, read_static_array_element->source_register);
+                            auto source_value = get_register_value(registers, read_static_array_element->source_register);
 
                             assert(source_value.type.kind == IRTypeKind::StaticArray);
                             assert(read_static_array_element->element_index < source_value.type.static_array.length);
@@ -1821,35 +2035,33 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                                 "read_static_array_element"
                             ));
 
-                            registers.append(Register(
-                                read_static_array_element->destination_register,
-                                TypedValue(*source_value.type.static_array.element_type, result_value)
-                            ));
+                            registers[read_static_array_element->destination_register] = TypedValue(*source_value.type.static_array.element_type, result_value);
                         } else if(instruction->kind == InstructionKind::AssembleStruct) {
                             auto assemble_struct = (AssembleStruct*)instruction;
 
-                            auto initial_constant_values = allocate<LLVMValueRef>(assemble_struct->member_registers.length);
+                            auto initial_constant_values = allocate<LLVMValueRef>(&scratch_arena, assemble_struct->member_registers.length);
 
                             for(size_t i = 0; i < assemble_struct->member_registers.length; i += 1) {
-                                auto member_value = get_register_value(*function, function_value, registers, assemble_struct->member_registers[i]);
+                                auto member_value = get_register_value(registers, assemble_struct->member_registers[i]);
 
                                 if(LLVMIsConstant(member_value.value)) {
                                     initial_constant_values[i] = member_value.value;
                                 } else {
-                                    initial_constant_values[i] = LLVMGetUndef(get_llvm_type(architecture_sizes, member_value.type));
+                                    initial_constant_values[i] = LLVMGetUndef(get_llvm_type(&type_cache, member_value.type));
                                 }
                             }
 
-                            auto current_struct_value = LLVMConstStruct(
+                            auto current_struct_value = LLVMConstStructInContext(
+                                context,
                                 initial_constant_values,
                                 assemble_struct->member_registers.length,
                                 false
                             );
 
-                            auto member_types = allocate<IRType>(assemble_struct->member_registers.length);
+                            auto member_types = allocate<IRType>(&scratch_arena, assemble_struct->member_registers.length);
 
                             for(size_t i = 0; i < assemble_struct->member_registers.length; i += 1) {
-                                auto member_value = get_register_value(*function, function_value, registers, assemble_struct->member_registers[i]);
+                                auto member_value = get_register_value(registers, assemble_struct->member_registers[i]);
 
                                 member_types[i] = member_value.type;
 
@@ -1870,14 +2082,11 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
 
                             auto type = IRType::create_struct(Array(assemble_struct->member_registers.length, member_types));
 
-                            registers.append(Register(
-                                assemble_struct->destination_register,
-                                TypedValue(type, current_struct_value)
-                            ));
+                            registers[assemble_struct->destination_register] = TypedValue(type, current_struct_value);
                         } else if(instruction->kind == InstructionKind::ReadStructMember) {
                             auto read_struct_member = (ReadStructMember*)instruction;
 
-                            auto source_value = get_register_value(*function, function_value, registers, read_struct_member->source_register);
+                            auto source_value = get_register_value(registers, read_struct_member->source_register);
 
                             assert(source_value.type.kind == IRTypeKind::Struct);
                             assert(read_struct_member->member_index < source_value.type.struct_.members.length);
@@ -1889,101 +2098,56 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                                 "read_struct_member"
                             ));
 
-                            registers.append(Register(
-                                read_struct_member->destination_register,
-                                TypedValue(source_value.type.struct_.members[read_struct_member->member_index], result_value)
-                            ));
+                            registers[read_struct_member->destination_register] = TypedValue(source_value.type.struct_.members[read_struct_member->member_index], result_value);
                         } else if(instruction->kind == InstructionKind::Literal) {
                             auto literal = (Literal*)instruction;
 
-                            auto llvm_constant_result = get_llvm_constant(architecture_sizes, literal->type, literal->value);
+                            auto llvm_constant_result = get_llvm_constant(&type_cache, literal->type, literal->value);
 
-                            registers.append(Register(
-                                literal->destination_register,
-                                TypedValue(literal->type, llvm_constant_result.value)
-                            ));
+                            registers[literal->destination_register] = TypedValue(literal->type, llvm_constant_result.value);
                         } else if(instruction->kind == InstructionKind::Jump) {
                             auto jump = (Jump*)instruction;
 
-                            auto found_block = false;
-                            size_t block_index;
-                            for(size_t i = 0; i < function->blocks.length; i += 1) {
-                                if(function->blocks[i] == jump->destination_block) {
-                                    block_index = i;
-                                    found_block = true;
-
-                                    break;
-                                }
-                            }
-
-                            assert(found_block);
-
-                            llvm_instruction_ignore(LLVMBuildBr(builder, llvm_blocks[block_index]));
+                            llvm_instruction_ignore(LLVMBuildBr(builder, llvm_blocks[jump->destination_block->index]));
                         } else if(instruction->kind == InstructionKind::Branch) {
                             auto branch = (Branch*)instruction;
 
-                            auto condition_value = get_register_value(*function, function_value, registers, branch->condition_register);
+                            auto condition_value = get_register_value(registers, branch->condition_register);
 
                             assert(condition_value.type.kind == IRTypeKind::Boolean);
 
-                            llvm_instruction(truncated_condition_value, LLVMBuildTrunc(builder, condition_value.value, LLVMInt1Type(), "truncate"));
-
-                            auto found_true_block = false;
-                            size_t block_true_index;
-                            for(size_t i = 0; i < function->blocks.length; i += 1) {
-                                if(function->blocks[i] == branch->true_destination_block) {
-                                    block_true_index = i;
-                                    found_true_block = true;
-
-                                    break;
-                                }
-                            }
-
-                            assert(found_true_block);
-
-                            auto found_false_block = false;
-                            size_t block_false_index;
-                            for(size_t i = 0; i < function->blocks.length; i += 1) {
-                                if(function->blocks[i] == branch->false_destination_block) {
-                                    block_false_index = i;
-                                    found_false_block = true;
-
-                                    break;
-                                }
-                            }
-
-                            assert(found_false_block);
+                            llvm_instruction(truncated_condition_value, LLVMBuildTrunc(builder, condition_value.value, LLVMInt1TypeInContext(context), "truncate"));
 
                             llvm_instruction_ignore(LLVMBuildCondBr(
                                 builder,
                                 truncated_condition_value,
-                                llvm_blocks[block_true_index],
-                                llvm_blocks[block_false_index]
+                                llvm_blocks[branch->true_destination_block->index],
+                                llvm_blocks[branch->false_destination_block->index]
                             ));
                         } else if(instruction->kind == InstructionKind::FunctionCallInstruction) {
                             auto function_call = (FunctionCallInstruction*)instruction;
 
                             auto parameter_count = function_call->parameters.length;
 
-                            auto function_pointer_value = get_register_value(*function, function_value, registers, function_call->pointer_register);
+                            auto function_pointer_value = get_register_value(registers, function_call->pointer_register);
 
                             assert(function_pointer_value.type.kind == IRTypeKind::Pointer);
 
-                            auto parameter_types = allocate<LLVMTypeRef>(parameter_count);
-                            auto parameter_values = allocate<LLVMValueRef>(parameter_count);
+                            auto parameter_types = allocate<LLVMTypeRef>(&scratch_arena, parameter_count);
+                            auto parameter_values = allocate<LLVMValueRef>(&scratch_arena, parameter_count);
                             for(size_t i = 0; i < parameter_count; i += 1) {
                                 auto parameter = function_call->parameters[i];
 
-                                parameter_types[i] = get_llvm_type(architecture_sizes, parameter.type);
+                                parameter_types[i] = get_llvm_type(&type_cache, parameter.type);
 
-                                parameter_values[i] = get_register_value(*function, function_value, registers, parameter.register_index).value;
+                                parameter_values[i] = get_register_value(registers, parameter.register_index).value;
                             }
 
                             LLVMTypeRef return_llvm_type;
                             if(function_call->has_return) {
-                                return_llvm_type = get_llvm_type(architecture_sizes, function_call->return_type);
+                                return_llvm_type = get_llvm_type(&type_cache, function_call->return_type);
                             } else {
-                                return_llvm_type = LLVMVoidType();
+                                return_llvm_type = LLVMVoidTypeInContext(context);
                             }
 
                             auto function_llvm_type = LLVMFunctionType(return_llvm_type, parameter_types, (unsigned int)parameter_count, false);
@@ -2007,39 +2171,36 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                             expect(calling_convention, get_llvm_calling_convention(
                                 function->path,
                                 function_call->range,
-                                os,
-                                architecture,
+                                info->os,
+                                info->architecture,
                                 function_call->calling_convention
                             ));
 
                             LLVMSetInstructionCallConv(value, calling_convention);
 
                             if(function_call->has_return) {
-                                registers.append(Register(
-                                    function_call->return_register,
-                                    TypedValue(function_call->return_type, value)
-                                ));
+                                registers[function_call->return_register] = TypedValue(function_call->return_type, value);
                             }
                         } else if(instruction->kind == InstructionKind::IntrinsicCallInstruction) {
                             auto intrinsic_call = (IntrinsicCallInstruction*)instruction;
 
                             auto parameter_count = intrinsic_call->parameters.length;
 
-                            auto parameter_types = allocate<LLVMTypeRef>(parameter_count);
-                            auto parameter_values = allocate<LLVMValueRef>(parameter_count);
+                            auto parameter_types = allocate<LLVMTypeRef>(&scratch_arena, parameter_count);
+                            auto parameter_values = allocate<LLVMValueRef>(&scratch_arena, parameter_count);
                             for(size_t i = 0; i < parameter_count; i += 1) {
                                 auto parameter = intrinsic_call->parameters[i];
 
-                                parameter_types[i] = get_llvm_type(architecture_sizes, parameter.type);
+                                parameter_types[i] = get_llvm_type(&type_cache, parameter.type);
 
-                                parameter_values[i] = get_register_value(*function, function_value, registers, parameter.register_index).value;
+                                parameter_values[i] = get_register_value(registers, parameter.register_index).value;
                             }
 
                             LLVMTypeRef return_llvm_type;
                             if(intrinsic_call->has_return) {
-                                return_llvm_type = get_llvm_type(architecture_sizes, intrinsic_call->return_type);
+                                return_llvm_type = get_llvm_type(&type_cache, intrinsic_call->return_type);
                             } else {
-                                return_llvm_type = LLVMVoidType();
+                                return_llvm_type = LLVMVoidTypeInContext(context);
                             }
 
                             auto function_llvm_type = LLVMFunctionType(return_llvm_type, parameter_types, (unsigned int)parameter_count, false);
@@ -2078,16 +2239,13 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                             ));
 
                             if(intrinsic_call->has_return) {
-                                registers.append(Register(
-                                    intrinsic_call->return_register,
-                                    TypedValue(intrinsic_call->return_type, value)
-                                ));
+                                registers[intrinsic_call->return_register] = TypedValue(intrinsic_call->return_type, value);
                             }
                         } else if(instruction->kind == InstructionKind::ReturnInstruction) {
                             auto return_instruction = (ReturnInstruction*)instruction;
 
                             if(function->has_return) {
-                                auto return_value = get_register_value(*function, function_value, registers, return_instruction->value_register);
+                                auto return_value = get_register_value(registers, return_instruction->value_register);
 
                                 assert(return_value.type == function->return_type);
 
@@ -2098,43 +2256,25 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                         } else if(instruction->kind == InstructionKind::AllocateLocal) {
                             auto allocate_local = (AllocateLocal*)instruction;
 
-                            auto found = false;
-                            LLVMValueRef pointer_value;
-                            for(auto local : locals) {
-                                if(local.allocate_local == allocate_local) {
-                                    pointer_value = local.pointer_value;
-                                    found = true;
-
-                                    break;
-                                }
-                            }
-                            assert(found);
-
-                            registers.append(Register(
-                                allocate_local->destination_register,
-                                TypedValue(IRType::create_pointer(), pointer_value)
-                            ));
+                            assert(registers[allocate_local->destination_register].value != nullptr);
                         } else if(instruction->kind == InstructionKind::Load) {
                             auto load = (Load*)instruction;
 
-                            auto pointer_register = get_register_value(*function, function_value, registers, load->pointer_register);
+                            auto pointer_register = get_register_value(registers, load->pointer_register);
 
                             assert(pointer_register.type.kind == IRTypeKind::Pointer);
 
-                            auto llvm_type = get_llvm_type(architecture_sizes, load->destination_type);
+                            auto llvm_type = get_llvm_type(&type_cache, load->destination_type);
 
                             llvm_instruction(value, LLVMBuildLoad2(builder, llvm_type, pointer_register.value, "load"));
 
-                            registers.append(Register(
-                                load->destination_register,
-                                TypedValue(load->destination_type, value)
-                            ));
+                            registers[load->destination_register] = TypedValue(load->destination_type, value);
                         } else if(instruction->kind == InstructionKind::Store) {
                             auto store = (Store*)instruction;
 
-                            auto source_value = get_register_value(*function, function_value, registers, store->source_register);
+                            auto source_value = get_register_value(registers, store->source_register);
 
-                            auto pointer_value = get_register_value(*function, function_value, registers, store->pointer_register);
+                            auto pointer_value = get_register_value(registers, store->pointer_register);
 
                             assert(pointer_value.type.kind == IRTypeKind::Pointer);
 
@@ -2142,7 +2282,7 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                         } else if(instruction->kind == InstructionKind::StructMemberPointer) {
                             auto struct_member_pointer = (StructMemberPointer*)instruction;
 
-                            auto pointer_value = get_register_value(*function, function_value, registers, struct_member_pointer->pointer_register);
+                            auto pointer_value = get_register_value(registers, struct_member_pointer->pointer_register);
 
                             assert(pointer_value.type.kind == IRTypeKind::Pointer);
 
@@ -2152,7 +2292,7 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
 
                             auto struct_type = IRType::create_struct(struct_member_pointer->members);
 
-                            auto struct_llvm_type = get_llvm_type(architecture_sizes, struct_type);
+                            auto struct_llvm_type = get_llvm_type(&type_cache, struct_type);
 
                             llvm_instruction(member_pointer_value, LLVMBuildStructGEP2(
                                 builder,
@@ -2162,22 +2302,19 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                                 "struct_member_pointer"
                             ));
 
-                            registers.append(Register(
-                                struct_member_pointer->destination_register,
-                                TypedValue(IRType::create_pointer(), member_pointer_value)
-                            ));
+                            registers[struct_member_pointer->destination_register] = TypedValue(IRType::create_pointer(), member_pointer_value);
                         } else if(instruction->kind == InstructionKind::PointerIndex) {
                             auto pointer_index = (PointerIndex*)instruction;
 
-                            auto index_value = get_register_value(*function, function_value, registers, pointer_index->index_register);
+                            auto index_value = get_register_value(registers, pointer_index->index_register);
 
                             assert(index_value.type.kind == IRTypeKind::Integer);
 
-                            auto pointer_value = get_register_value(*function, function_value, registers, pointer_index->pointer_register);
+                            auto pointer_value = get_register_value(registers, pointer_index->pointer_register);
 
                             assert(pointer_value.type.kind == IRTypeKind::Pointer);
 
-                            auto pointed_to_llvm_type = get_llvm_type(architecture_sizes, pointer_index->pointed_to_type);
+                            auto pointed_to_llvm_type = get_llvm_type(&type_cache, pointer_index->pointed_to_type);
 
                             llvm_instruction(result_pointer_value, LLVMBuildGEP2(
                                 builder,
@@ -2188,10 +2325,7 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                                 "pointer_index"
                             ));
 
-                            registers.append(Register(
-                                pointer_index->destination_register,
-                                TypedValue(pointer_value.type, result_pointer_value)
-                            ));
+                            registers[pointer_index->destination_register] = TypedValue(pointer_value.type, result_pointer_value);
                         } else if(instruction->kind == InstructionKind::AssemblyInstruction) {
                             auto assembly_instruction = (AssemblyInstruction*)instruction;
 
@@ -2211,17 +2345,17 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                                     constraints_buffer.append(u8","_S);
                                 }
 
-                                auto value = get_register_value(*function, function_value, registers, binding.register_index);
+                                auto value = get_register_value(registers, binding.register_index);
 
                                 if(binding.constraint[0] == '=') {
                                     assert(value.type.kind == IRTypeKind::Pointer);
 
-                                    auto pointed_to_llvm_type = get_llvm_type(architecture_sizes, binding.pointed_to_type);
+                                    auto pointed_to_llvm_type = get_llvm_type(&type_cache, binding.pointed_to_type);
 
                                     call_return_types.append(pointed_to_llvm_type);
                                     output_binding_pointer_values.append(value.value);
                                 } else {
-                                    auto llvm_type = get_llvm_type(architecture_sizes, value.type);
+                                    auto llvm_type = get_llvm_type(&type_cache, value.type);
 
                                     call_parameter_types.append(llvm_type);
                                     call_parameters.append(value.value);
@@ -2233,11 +2367,11 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
 
                             LLVMTypeRef llvm_function_return_type;
                             if(call_return_types.length == 0) {
-                                llvm_function_return_type = LLVMVoidType();
+                                llvm_function_return_type = LLVMVoidTypeInContext(context);
                             } else if(call_return_types.length == 1) {
                                 llvm_function_return_type = call_return_types[0];
                             } else {
-                                llvm_function_return_type = LLVMStructType(call_return_types.elements, (unsigned int)call_return_types.length, false);
+                                llvm_function_return_type = LLVMStructTypeInContext(context, call_return_types.elements, (unsigned int)call_return_types.length, false);
                             }
 
                             auto llvm_function_type = LLVMFunctionType(
@@ -2293,22 +2427,29 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                         } else if(instruction->kind == InstructionKind::ReferenceStatic) {
                             auto reference_static = (ReferenceStatic*)instruction;
 
-                            auto found = false;
-                            LLVMValueRef global_value;
-                            for(size_t i = 0; i < statics.length; i += 1) {
-                                if(statics[i] == reference_static->runtime_static) {
-                                    global_value = global_values[i];
-                                    found = true;
+                            auto global_value = global_values[reference_static->runtime_static->index];
+                            if(global_value == nullptr) {
+                                auto runtime_static = reference_static->runtime_static;
 
-                                    break;
-                                }
+                                expect(declared_value, add_llvm_global(
+                                    &type_cache,
+                                    module,
+                                    debug_builder,
+                                    &file_debug_scopes,
+                                    &debug_type_cache,
+                                    architecture_sizes,
+                                    info->architecture,
+                                    info->os,
+                                    runtime_static,
+                                    info->link_names[runtime_static->index],
+                                    false
+                                ));
+
+                                global_value = declared_value;
+                                global_values[runtime_static->index] = global_value;
                             }
-                            assert(found);
 
-                            registers.append(Register(
-                                reference_static->destination_register,
-                                TypedValue(IRType::create_pointer(), global_value)
-                            ));
+                            registers[reference_static->destination_register] = TypedValue(IRType::create_pointer(), global_value);
                         } else {
                             abort();
                         }
@@ -2318,18 +2459,251 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
                         LLVMDIBuilderFinalizeSubprogram(debug_builder, function_debug_scope);
                     }
                 }
+
+                free_arena(&scratch_arena);
             }
         }
     }
 
     LLVMDIBuilderFinalize(debug_builder);
 
-    if(print) {
-        printf("%s\n", LLVMPrintModuleToString(module));
+    free(type_cache.entries);
+    free_arena(&type_cache.arena);
+
+    free(debug_type_cache.entries.elements);
+    free(debug_type_cache.buckets);
+
+    if(info->print) {
+        partition->module_text = LLVMPrintModuleToString(module);
     }
 
     assert(LLVMVerifyModule(module, LLVMVerifierFailureAction::LLVMAbortProcessAction, nullptr) == 0);
 
+    auto target_machine = LLVMCreateTargetMachine(
+        info->target,
+        info->triple.to_c_string(),
+        "",
+        info->features.to_c_string(),
+        info->code_generation_level,
+        LLVMRelocMode::LLVMRelocPIC,
+        LLVMCodeModel::LLVMCodeModelDefault
+    );
+    assert(target_machine != nullptr);
+
+    if(info->optimization_level != u8"0"_S) {
+        StringBuffer pipeline {};
+        pipeline.append(u8"default<O"_S);
+        pipeline.append(info->optimization_level);
+        pipeline.append(u8">"_S);
+
+        auto pass_builder_options = LLVMCreatePassBuilderOptions();
+
+        auto error = LLVMRunPasses(module, pipeline.to_c_string(), target_machine, pass_builder_options);
+
+        LLVMDisposePassBuilderOptions(pass_builder_options);
+
+        if(error != nullptr) {
+            auto error_message = LLVMGetErrorMessage(error);
+
+            fprintf(stderr, "Error: Unable to run optimization pipeline '%.*s' (%s)\n", STRING_PRINTF_ARGUMENTS(pipeline), error_message);
+
+            LLVMDisposeErrorMessage(error_message);
+
+            LLVMDisposeTargetMachine(target_machine);
+            LLVMDisposeDIBuilder(debug_builder);
+            LLVMDisposeModule(module);
+            LLVMDisposeBuilder(builder);
+            LLVMContextDispose(context);
+
+            free(global_values);
+
+            return err();
+        }
+    }
+
+    char* error_message;
+    auto emit_failed = LLVMTargetMachineEmitToFile(
+        target_machine,
+        module,
+        partition->object_file_path.to_c_string(),
+        LLVMCodeGenFileType::LLVMObjectFile,
+        &error_message
+    ) != 0;
+
+    if(emit_failed) {
+        fprintf(stderr, "Error: Unable to emit object file '%.*s' (%s)\n", STRING_PRINTF_ARGUMENTS(partition->object_file_path), error_message);
+
+        LLVMDisposeMessage(error_message);
+    }
+
+    LLVMDisposeTargetMachine(target_machine);
+    LLVMDisposeDIBuilder(debug_builder);
+    LLVMDisposeModule(module);
+    LLVMDisposeBuilder(builder);
+    LLVMContextDispose(context);
+
+    free(global_values);
+
+    if(emit_failed) {
+        return err();
+    }
+
+    return ok();
+}
+
+static void run_llvm_partition(void* data) {
+    auto partition = (LLVMPartition*)data;
+
+    partition->succeeded = generate_llvm_partition(partition).status;
+}
+
+// Below this many instructions a partition costs more in per module setup and duplicated declarations than it saves
+const size_t minimum_partition_weight = 256;
+
+static size_t get_runtime_static_weight(RuntimeStatic* runtime_static) {
+    if(runtime_static->kind == RuntimeStaticKind::Function) {
+        auto function = (Function*)runtime_static;
+
+        if(!function->is_external) {
+            size_t weight = 1;
+            for(auto block : function->blocks) {
+                weight += block->instructions.length;
+            }
+
+            return weight;
+        }
+    }
+
+    return 1;
+}
+
+profiled_function(Result<LLVMObjectResult>, generate_llvm_object, (
+    String top_level_source_file_path,
+    Array<RuntimeStatic*> statics,
+    String architecture,
+    String os,
+    String toolchain,
+    String config,
+    String optimization_level,
+    Array<String> object_file_paths,
+    Array<String> reserved_names,
+    bool print
+), (
+    top_level_source_file_path,
+    statics,
+    architecture,
+    os,
+    config,
+    optimization_level,
+    object_file_paths,
+    reserved_names,
+    print
+)) {
+    List<NameMapping> name_mappings {};
+
+    auto link_names = allocate<String>(statics.length);
+
+    TakenNameTable taken_names {};
+    taken_names.capacity = 16;
+    while(taken_names.capacity < (statics.length + reserved_names.length) * 2) {
+        taken_names.capacity *= 2;
+    }
+
+    taken_names.entries = allocate<TakenName>(taken_names.capacity);
+    memset(taken_names.entries, 0, taken_names.capacity * sizeof(TakenName));
+
+    for(auto reserved_name : reserved_names) {
+        auto hash = calculate_string_hash(reserved_name);
+
+        if(find_taken_name(&taken_names, reserved_name, hash) == nullptr) {
+            add_taken_name(&taken_names, reserved_name, hash, nullptr);
+        }
+    }
+
+    for(auto runtime_static : statics) {
+        assert(statics[runtime_static->index] == runtime_static);
+
+        if(runtime_static->is_no_mangle) {
+            auto hash = calculate_string_hash(runtime_static->name);
+
+            auto taken_name = find_taken_name(&taken_names, runtime_static->name, hash);
+            if(taken_name != nullptr) {
+                if(taken_name->runtime_static == nullptr) {
+                    error(runtime_static->path, runtime_static->range, "Runtime name '%.*s' is reserved", STRING_PRINTF_ARGUMENTS(taken_name->name));
+                } else {
+                    error(runtime_static->path, runtime_static->range, "Conflicting no_mangle name '%.*s'", STRING_PRINTF_ARGUMENTS(taken_name->name));
+                    error(taken_name->runtime_static->path, taken_name->runtime_static->range, "Conflicing declaration here");
+                }
+
+                return err();
+            }
+
+            add_taken_name(&taken_names, runtime_static->name, hash, runtime_static);
+
+            NameMapping mapping {};
+            mapping.runtime_static = runtime_static;
+            mapping.name = runtime_static->name;
+
+            name_mappings.append(mapping);
+
+            link_names[runtime_static->index] = mapping.name;
+        }
+    }
+
+    for(auto runtime_static : statics) {
+        if(!runtime_static->is_no_mangle) {
+            auto base_hash = calculate_string_hash(runtime_static->name);
+
+            String name;
+            uint32_t hash;
+
+            auto base_taken_name = find_taken_name(&taken_names, runtime_static->name, base_hash);
+            if(base_taken_name == nullptr) {
+                name = runtime_static->name;
+                hash = base_hash;
+            } else {
+                // Every suffix below next_suffix is already taken, so the search picks up where the last one for this base name stopped
+                auto number = base_taken_name->next_suffix;
+                while(true) {
+                    StringBuffer name_buffer {};
+                    name_buffer.append(runtime_static->name);
+                    name_buffer.append(u8"_"_S);
+                    name_buffer.append_integer(number);
+
+                    hash = calculate_string_hash(name_buffer);
+
+                    if(find_taken_name(&taken_names, name_buffer, hash) == nullptr) {
+                        name = name_buffer;
+
+                        break;
+                    }
+
+                    free(name_buffer.elements);
+
+                    number += 1;
+                }
+
+                base_taken_name->next_suffix = number + 1;
+            }
+
+            add_taken_name(&taken_names, name, hash, runtime_static);
+
+            NameMapping mapping {};
+            mapping.runtime_static = runtime_static;
+            mapping.name = name;
+
+            name_mappings.append(mapping);
+
+            link_names[runtime_static->index] = mapping.name;
+        }
+    }
+
+    free(taken_names.entries);
+
+    assert(name_mappings.length == statics.length);
+
+    auto architecture_sizes = get_architecture_sizes(architecture);
+
     auto triple = get_llvm_triple(architecture, os, toolchain);
 
     LLVMTargetRef target;
@@ -2360,32 +2734,132 @@ profiled_function(Result<Array<NameMapping>>, generate_llvm_object, (
 
     auto features = get_llvm_features(architecture);
 
-    LLVMCodeGenOptLevel optimization_level;
-    if(config == u8"debug"_S) {
-        optimization_level = LLVMCodeGenOptLevel::LLVMCodeGenLevelNone;
-    } else if(config == u8"release"_S) {
-        optimization_level = LLVMCodeGenOptLevel::LLVMCodeGenLevelDefault;
+    LLVMCodeGenOptLevel code_generation_level;
+    if(optimization_level == u8"0"_S) {
+        code_generation_level = LLVMCodeGenOptLevel::LLVMCodeGenLevelNone;
+    } else if(optimization_level == u8"1"_S) {
+        code_generation_level = LLVMCodeGenOptLevel::LLVMCodeGenLevelLess;
+    } else if(optimization_level == u8"2"_S || optimization_level == u8"s"_S || optimization_level == u8"z"_S) {
+        code_generation_level = LLVMCodeGenOptLevel::LLVMCodeGenLevelDefault;
+    } else if(optimization_level == u8"3"_S) {
+        code_generation_level = LLVMCodeGenOptLevel::LLVMCodeGenLevelAggressive;
     } else {
         abort();
     }
 
-    auto target_machine = LLVMCreateTargetMachine(
-        target,
-        triple.to_c_string(),
-        "",
-        features.to_c_string(),
-        optimization_level,
-        LLVMRelocMode::LLVMRelocPIC,
-        LLVMCodeModel::LLVMCodeModelDefault
-    );
-    assert(target_machine != nullptr);
+    LLVMObjectInfo info {};
+    info.top_level_source_file_path = top_level_source_file_path;
+    info.statics = statics;
+    info.link_names = link_names;
+    info.architecture = architecture;
+    info.os = os;
+    info.config = config;
+    info.optimization_level = optimization_level;
+    info.architecture_sizes = architecture_sizes;
+    info.target = target;
+    info.triple = triple;
+    info.features = features;
+    info.code_generation_level = code_generation_level;
+    info.print = print;
+
+    // Statics are split into consecutive runs of roughly equal weight, neighbouring statics tend to reference each other
+    size_t total_weight = 0;
+    for(auto runtime_static : statics) {
+        total_weight += get_runtime_static_weight(runtime_static);
+    }
 
-    char* error_message;
-    if(LLVMTargetMachineEmitToFile(target_machine, module, object_file_path.to_c_string(), LLVMCodeGenFileType::LLVMObjectFile, &error_message) != 0) {
-        fprintf(stderr, "Error: Unable to emit object file '%.*s' (%s)\n", STRING_PRINTF_ARGUMENTS(object_file_path), error_message);
+    auto partition_count = object_file_paths.length;
+    assert(partition_count != 0);
+
+    // Optimizations can't inline or propagate constants across partitions, so optimized code is always emitted as one
+    if(optimization_level != u8"0"_S) {
+        partition_count = 1;
+    }
+
+    if(partition_count > total_weight / minimum_partition_weight) {
+        partition_count = total_weight / minimum_partition_weight;
+    }
+
+    if(partition_count > statics.length) {
+        partition_count = statics.length;
+    }
+
+    if(partition_count == 0) {
+        partition_count = 1;
+    }
+
+    auto partitions = allocate<LLVMPartition>(partition_count);
+    for(size_t i = 0; i < partition_count; i += 1) {
+        partitions[i] = {};
+        partitions[i].info = &info;
+    }
+
+    size_t weight = 0;
+    for(auto runtime_static : statics) {
+        auto partition_index = weight * partition_count / total_weight;
+
+        partitions[partition_index].statics.append(runtime_static);
+
+        weight += get_runtime_static_weight(runtime_static);
+    }
+
+    // A single heavy static can cover the whole share of the partitions after it, those are left out rather than emitted empty
+    size_t used_partition_count = 0;
+    for(size_t i = 0; i < partition_count; i += 1) {
+        if(partitions[i].statics.length != 0) {
+            partitions[used_partition_count] = partitions[i];
+            partitions[used_partition_count].object_file_path = object_file_paths[used_partition_count];
+
+            used_partition_count += 1;
+        }
+    }
+
+    partition_count = used_partition_count;
+
+    // The calling thread generates the first partition
+    auto threads = allocate<Thread>(partition_count);
+
+    for(size_t i = 1; i < partition_count; i += 1) {
+        threads[i] = create_thread(run_llvm_partition, &partitions[i]);
+    }
 
+    run_llvm_partition(&partitions[0]);
+
+    for(size_t i = 1; i < partition_count; i += 1) {
+        join_thread(threads[i]);
+    }
+
+    free(threads);
+
+    auto failed = false;
+    for(size_t i = 0; i < partition_count; i += 1) {
+        auto partition = &partitions[i];
+
+        if(partition->module_text != nullptr) {
+            printf("%s\n", partition->module_text);
+
+            LLVMDisposeMessage(partition->module_text);
+        }
+
+        if(!partition->succeeded) {
+            failed = true;
+        }
+    }
+
+    for(size_t i = 0; i < partition_count; i += 1) {
+        free(partitions[i].statics.elements);
+    }
+
+    free(partitions);
+
+    if(failed) {
         return err();
     }
 
-    return ok((Array<NameMapping>)name_mappings);
+    LLVMObjectResult result {};
+    result.name_mappings = name_mappings;
+    result.object_file_paths.elements = object_file_paths.elements;
+    result.object_file_paths.length = partition_count;
+
+    return ok(result);
 }
\ No newline at end of file
@@ -9,14 +9,22 @@ struct NameMapping {
     String name;
 };
 
-Result<Array<NameMapping>> generate_llvm_object(
+struct LLVMObjectResult {
+    Array<NameMapping> name_mappings;
+
+    // The object files that were written, fewer than were given when there wasn't enough code to split between them
+    Array<String> object_file_paths;
+};
+
+Result<LLVMObjectResult> generate_llvm_object(
     String top_level_source_file_path,
     Array<RuntimeStatic*> statics,
     String architecture,
     String os,
     String toolchain,
     String config,
-    String object_file_path,
+    String optimization_level,
+    Array<String> object_file_paths,
     Array<String> reserved_names,
     bool print
 );
\ No newline at end of file
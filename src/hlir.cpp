@@ -42,6 +42,27 @@ bool IRType::operator!=(IRType other) {
     return !(*this == other);
 }
 
+uint64_t IRType::get_hash() {
+    auto hash = (uint64_t)kind;
+
+    if(kind == IRTypeKind::Integer) {
+        hash = combine_hash(hash, (uint64_t)integer.size);
+    } else if(kind == IRTypeKind::Float) {
+        hash = combine_hash(hash, (uint64_t)float_.size);
+    } else if(kind == IRTypeKind::StaticArray) {
+        hash = combine_hash(hash, static_array.length);
+        hash = combine_hash(hash, static_array.element_type->get_hash());
+    } else if(kind == IRTypeKind::Struct) {
+        hash = combine_hash(hash, struct_.members.length);
+
+        for(size_t i = 0; i < struct_.members.length; i += 1) {
+            hash = combine_hash(hash, struct_.members[i].get_hash());
+        }
+    }
+
+    return hash;
+}
+
 inline String register_size_name(RegisterSize size){
     switch(size) {
         case RegisterSize::Size8: {
@@ -112,10 +133,14 @@ void IRConstantValue::print() {
     } else if(kind == IRConstantValueKind::StaticArrayConstant) {
         printf("[ ");
 
-        for(size_t i = 0; i < static_array.elements.length; i += 1) {
-            static_array.elements[i].print();
+        for(size_t i = 0; i < static_array.length; i += 1) {
+            if(static_array.is_packed) {
+                printf("%" PRIu64, read_packed_integer(static_array.packed.bytes, static_array.packed.element_size, static_array.packed.is_signed, i));
+            } else {
+                static_array.elements[i].print();
+            }
 
-            if(i != static_array.elements.length - 1) {
+            if(i != static_array.length - 1) {
                 printf(", ");
             }
         }
@@ -140,6 +165,107 @@ void IRConstantValue::print() {
     }
 }
 
+bool IRConstantValue::operator==(IRConstantValue other) {
+    if(other.kind != kind) {
+        return false;
+    }
+
+    if(kind == IRConstantValueKind::FunctionConstant) {
+        return
+            function.declaration == other.function.declaration &&
+            function.is_external == other.function.is_external &&
+            function.is_no_mangle == other.function.is_no_mangle
+        ;
+    } else if(kind == IRConstantValueKind::IntegerConstant) {
+        return integer == other.integer;
+    } else if(kind == IRConstantValueKind::FloatConstant) {
+        // Compare bits so that -0.0 and 0.0 stay distinct
+        return memcmp(&float_, &other.float_, sizeof(float_)) == 0;
+    } else if(kind == IRConstantValueKind::BooleanConstant) {
+        return boolean == other.boolean;
+    } else if(kind == IRConstantValueKind::StaticArrayConstant) {
+        if(
+            static_array.length != other.static_array.length ||
+            static_array.is_packed != other.static_array.is_packed
+        ) {
+            return false;
+        }
+
+        if(static_array.is_packed) {
+            if(static_array.packed.element_size != other.static_array.packed.element_size) {
+                return false;
+            }
+
+            auto byte_count = static_array.length * register_size_to_byte_size(static_array.packed.element_size);
+
+            return memcmp(static_array.packed.bytes, other.static_array.packed.bytes, byte_count) == 0;
+        } else {
+            for(size_t i = 0; i < static_array.length; i += 1) {
+                if(!(static_array.elements[i] == other.static_array.elements[i])) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    } else if(kind == IRConstantValueKind::StructConstant) {
+        if(struct_.members.length != other.struct_.members.length) {
+            return false;
+        }
+
+        for(size_t i = 0; i < struct_.members.length; i += 1) {
+            if(!(struct_.members[i] == other.struct_.members[i])) {
+                return false;
+            }
+        }
+
+        return true;
+    } else if(kind == IRConstantValueKind::UndefConstant) {
+        return true;
+    } else {
+        abort();
+    }
+}
+
+uint64_t IRConstantValue::get_hash() {
+    auto hash = (uint64_t)kind;
+
+    if(kind == IRConstantValueKind::FunctionConstant) {
+        hash = combine_hash(hash, (uint64_t)function.declaration);
+    } else if(kind == IRConstantValueKind::IntegerConstant) {
+        hash = combine_hash(hash, integer);
+    } else if(kind == IRConstantValueKind::FloatConstant) {
+        uint64_t bits;
+        memcpy(&bits, &float_, sizeof(bits));
+
+        hash = combine_hash(hash, bits);
+    } else if(kind == IRConstantValueKind::BooleanConstant) {
+        hash = combine_hash(hash, (uint64_t)boolean);
+    } else if(kind == IRConstantValueKind::StaticArrayConstant) {
+        hash = combine_hash(hash, static_array.length);
+
+        if(static_array.is_packed) {
+            auto byte_count = static_array.length * register_size_to_byte_size(static_array.packed.element_size);
+
+            for(size_t i = 0; i < byte_count; i += 1) {
+                hash = combine_hash(hash, static_array.packed.bytes[i]);
+            }
+        } else {
+            for(size_t i = 0; i < static_array.length; i += 1) {
+                hash = combine_hash(hash, static_array.elements[i].get_hash());
+            }
+        }
+    } else if(kind == IRConstantValueKind::StructConstant) {
+        hash = combine_hash(hash, struct_.members.length);
+
+        for(size_t i = 0; i < struct_.members.length; i += 1) {
+            hash = combine_hash(hash, struct_.members[i].get_hash());
+        }
+    }
+
+    return hash;
+}
+
 void Instruction::print(Array<Block*> blocks, bool has_return) {
     if(kind == InstructionKind::IntegerArithmeticOperation) {
         auto integer_arithmetic_operation = (IntegerArithmeticOperation*)this;
@@ -52,6 +52,8 @@ struct IRType {
     bool operator==(IRType other);
     bool operator!=(IRType other);
 
+    uint64_t get_hash();
+
     static inline IRType create_boolean() {
         IRType result {};
         result.kind = IRTypeKind::Boolean;
@@ -132,7 +134,20 @@ struct IRConstantValue {
         bool boolean;
 
         struct {
-            Array<IRConstantValue> elements;
+            size_t length;
+
+            // Mirrors StaticArrayConstant, integer arrays keep their raw bytes
+            bool is_packed;
+
+            union {
+                IRConstantValue* elements;
+
+                struct {
+                    RegisterSize element_size;
+                    bool is_signed;
+                    uint8_t* bytes;
+                } packed;
+            };
         } static_array;
 
         struct {
@@ -178,7 +193,21 @@ struct IRConstantValue {
     static inline IRConstantValue create_static_array(Array<IRConstantValue> elements) {
         IRConstantValue result;
         result.kind = IRConstantValueKind::StaticArrayConstant;
-        result.static_array.elements = elements;
+        result.static_array.length = elements.length;
+        result.static_array.is_packed = false;
+        result.static_array.elements = elements.elements;
+
+        return result;
+    }
+
+    static inline IRConstantValue create_packed_static_array(size_t length, RegisterSize element_size, bool is_signed, uint8_t* bytes) {
+        IRConstantValue result;
+        result.kind = IRConstantValueKind::StaticArrayConstant;
+        result.static_array.length = length;
+        result.static_array.is_packed = true;
+        result.static_array.packed.element_size = element_size;
+        result.static_array.packed.is_signed = is_signed;
+        result.static_array.packed.bytes = bytes;
 
         return result;
     }
@@ -198,6 +227,11 @@ struct IRConstantValue {
         return result;
     }
 
+    // Exact structural equality, packed arrays only compare equal to other packed arrays
+    bool operator==(IRConstantValue other);
+
+    uint64_t get_hash();
+
     void print();
 };
 
@@ -629,6 +663,9 @@ struct ReferenceStatic : Instruction {
 
 struct Block {
     Array<Instruction*> instructions;
+
+    // Position in the function's list of blocks
+    size_t index;
 };
 
 enum struct RuntimeStaticKind {
@@ -640,6 +677,9 @@ enum struct RuntimeStaticKind {
 struct RuntimeStatic {
     RuntimeStaticKind kind;
 
+    // Position in the list of all runtime statics handed to the backend
+    size_t index;
+
     String name;
     bool is_no_mangle;
 
@@ -653,6 +693,8 @@ struct RuntimeStatic {
 
 struct DebugScope {
     bool has_parent;
+
+    // Parents always come before their children in a function's scope list
     size_t parent_scope_index;
 
     FileRange range;
@@ -668,6 +710,9 @@ struct Function : RuntimeStatic {
 
     Array<Block*> blocks;
 
+    // Registers are numbered from 0 up to this, the first ones holding the parameters
+    size_t register_count;
+
     Array<String> libraries;
 
     CallingConvention calling_convention;
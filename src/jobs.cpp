@@ -0,0 +1,422 @@
+#include "jobs.h"
+#include <string.h>
+
+static bool get_job_identity(AnyJob* job, void** subject, ConstantScope** scope) {
+    switch(job->kind) {
+        case JobKind::ResolveStaticIf: {
+            *subject = job->resolve_static_if.static_if;
+            *scope = job->resolve_static_if.scope;
+        } break;
+
+        case JobKind::ResolveFunctionDeclaration: {
+            *subject = job->resolve_function_declaration.declaration;
+            *scope = job->resolve_function_declaration.scope;
+        } break;
+
+        case JobKind::ResolveConstantDefinition: {
+            *subject = job->resolve_constant_definition.definition;
+            *scope = job->resolve_constant_definition.scope;
+        } break;
+
+        case JobKind::ResolveStructDefinition: {
+            *subject = job->resolve_struct_definition.definition;
+            *scope = job->resolve_struct_definition.scope;
+        } break;
+
+        case JobKind::ResolveUnionDefinition: {
+            *subject = job->resolve_union_definition.definition;
+            *scope = job->resolve_union_definition.scope;
+        } break;
+
+        case JobKind::ResolveEnumDefinition: {
+            *subject = job->resolve_enum_definition.definition;
+            *scope = job->resolve_enum_definition.scope;
+        } break;
+
+        case JobKind::GenerateFunction: {
+            *subject = job->generate_function.value.declaration;
+            *scope = job->generate_function.value.body_scope;
+        } break;
+
+        case JobKind::GenerateStaticVariable: {
+            *subject = job->generate_static_variable.declaration;
+            *scope = job->generate_static_variable.scope;
+        } break;
+
+        default: {
+            return false;
+        } break;
+    }
+
+    return true;
+}
+
+static uint64_t calculate_identity_hash(JobKind kind, void* subject, ConstantScope* scope) {
+    auto hash = (uint64_t)subject ^ ((uint64_t)scope << 1) ^ (uint64_t)kind;
+
+    hash *= 0x9E3779B97F4A7C15;
+
+    return hash ^ (hash >> 32);
+}
+
+// Instantiations are keyed by the same parameter fields the dedupe comparisons look at, so a hash match only needs
+// the equality functions to rule out collisions
+static uint64_t calculate_polymorphic_function_hash(FunctionDeclaration* declaration, ConstantScope* scope, TypedConstantValue* parameters) {
+    auto hash = calculate_identity_hash(JobKind::ResolvePolymorphicFunction, declaration, scope);
+
+    for(size_t i = 0; i < declaration->parameters.length; i += 1) {
+        auto declaration_parameter = declaration->parameters[i];
+
+        if(declaration_parameter.is_polymorphic_determiner || declaration_parameter.is_constant) {
+            hash = combine_hash(hash, parameters[i].type.get_hash());
+        }
+
+        if(declaration_parameter.is_constant) {
+            hash = combine_hash(hash, calculate_constant_value_hash(parameters[i].value));
+        }
+    }
+
+    return hash;
+}
+
+static uint64_t calculate_polymorphic_type_hash(JobKind kind, void* definition, size_t parameter_count, AnyConstantValue* parameters) {
+    auto hash = calculate_identity_hash(kind, definition, nullptr);
+
+    for(size_t i = 0; i < parameter_count; i += 1) {
+        hash = combine_hash(hash, calculate_constant_value_hash(parameters[i]));
+    }
+
+    return hash;
+}
+
+static bool polymorphic_function_parameters_equal(FunctionDeclaration* declaration, TypedConstantValue* a, TypedConstantValue* b) {
+    for(size_t i = 0; i < declaration->parameters.length; i += 1) {
+        auto declaration_parameter = declaration->parameters[i];
+
+        if(
+            (declaration_parameter.is_polymorphic_determiner || declaration_parameter.is_constant) &&
+            a[i].type != b[i].type
+        ) {
+            return false;
+        }
+
+        if(
+            declaration_parameter.is_constant &&
+            !constant_values_equal(a[i].value, b[i].value)
+        ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool polymorphic_type_parameters_equal(size_t parameter_count, AnyConstantValue* a, AnyConstantValue* b) {
+    for(size_t i = 0; i < parameter_count; i += 1) {
+        if(!constant_values_equal(a[i], b[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool get_job_hash(AnyJob* job, uint64_t* hash) {
+    if(job->kind == JobKind::ParseFile) {
+        *hash = calculate_string_hash(job->parse_file.path);
+
+        return true;
+    }
+
+    if(job->kind == JobKind::ResolvePolymorphicFunction) {
+        auto resolve_polymorphic_function = job->resolve_polymorphic_function;
+
+        *hash = calculate_polymorphic_function_hash(
+            resolve_polymorphic_function.declaration,
+            resolve_polymorphic_function.scope,
+            resolve_polymorphic_function.parameters
+        );
+
+        return true;
+    }
+
+    if(job->kind == JobKind::ResolvePolymorphicStruct) {
+        auto definition = job->resolve_polymorphic_struct.definition;
+
+        *hash = calculate_polymorphic_type_hash(
+            job->kind,
+            definition,
+            definition->parameters.length,
+            job->resolve_polymorphic_struct.parameters
+        );
+
+        return true;
+    }
+
+    if(job->kind == JobKind::ResolvePolymorphicUnion) {
+        auto definition = job->resolve_polymorphic_union.definition;
+
+        *hash = calculate_polymorphic_type_hash(
+            job->kind,
+            definition,
+            definition->parameters.length,
+            job->resolve_polymorphic_union.parameters
+        );
+
+        return true;
+    }
+
+    void* subject;
+    ConstantScope* scope;
+    if(!get_job_identity(job, &subject, &scope)) {
+        return false;
+    }
+
+    *hash = calculate_identity_hash(job->kind, subject, scope);
+
+    return true;
+}
+
+static void insert_into_index(size_t* buckets, size_t capacity, uint64_t hash, size_t job_index) {
+    auto bucket_index = (size_t)hash & (capacity - 1);
+
+    while(buckets[bucket_index] != 0) {
+        bucket_index = (bucket_index + 1) & (capacity - 1);
+    }
+
+    buckets[bucket_index] = job_index + 1;
+}
+
+size_t JobList::append(AnyJob job) {
+    lock_mutex(mutex);
+
+    auto index = length;
+
+    auto chunk_number = index / job_list_first_chunk_size + 1;
+
+    size_t chunk_index = 63 - __builtin_clzll(chunk_number);
+
+    assert(chunk_index < job_list_max_chunks);
+
+    auto chunk_start = job_list_first_chunk_size * (((size_t)1 << chunk_index) - 1);
+
+    if(index == chunk_start) {
+        chunks[chunk_index] = allocate<AnyJob>(job_list_first_chunk_size << chunk_index);
+    }
+
+    chunks[chunk_index][index - chunk_start] = job;
+
+    uint64_t hash;
+    if(get_job_hash(&job, &hash)) {
+        if((index_count + 1) * 2 > index_capacity) {
+            size_t new_capacity;
+            if(index_capacity == 0) {
+                new_capacity = 256;
+            } else {
+                new_capacity = index_capacity * 2;
+            }
+
+            auto new_buckets = allocate<size_t>(new_capacity);
+            memset(new_buckets, 0, new_capacity * sizeof(size_t));
+
+            for(size_t i = 0; i < index_capacity; i += 1) {
+                if(index_buckets[i] != 0) {
+                    auto job_index = index_buckets[i] - 1;
+
+                    uint64_t existing_hash;
+                    get_job_hash(&(*this)[job_index], &existing_hash);
+
+                    insert_into_index(new_buckets, new_capacity, existing_hash, job_index);
+                }
+            }
+
+            free(index_buckets);
+
+            index_buckets = new_buckets;
+            index_capacity = new_capacity;
+        }
+
+        insert_into_index(index_buckets, index_capacity, hash, index);
+
+        index_count += 1;
+    }
+
+    atomic_store(&length, index + 1);
+
+    unlock_mutex(mutex);
+
+    return index;
+}
+
+bool JobList::find(JobKind kind, void* subject, ConstantScope* scope, size_t* job_index) {
+    lock_mutex(mutex);
+
+    auto found = false;
+    if(index_capacity != 0) {
+        auto hash = calculate_identity_hash(kind, subject, scope);
+
+        auto bucket_index = (size_t)hash & (index_capacity - 1);
+
+        while(index_buckets[bucket_index] != 0) {
+            auto current_job_index = index_buckets[bucket_index] - 1;
+            auto job = &(*this)[current_job_index];
+
+            if(job->kind == kind) {
+                void* job_subject;
+                ConstantScope* job_scope;
+                get_job_identity(job, &job_subject, &job_scope);
+
+                if(job_subject == subject && job_scope == scope) {
+                    found = true;
+                    *job_index = current_job_index;
+
+                    break;
+                }
+            }
+
+            bucket_index = (bucket_index + 1) & (index_capacity - 1);
+        }
+    }
+
+    unlock_mutex(mutex);
+
+    return found;
+}
+
+bool JobList::find_parse_file(String path, size_t* job_index) {
+    lock_mutex(mutex);
+
+    auto found = false;
+    if(index_capacity != 0) {
+        uint64_t hash = calculate_string_hash(path);
+
+        auto bucket_index = (size_t)hash & (index_capacity - 1);
+
+        while(index_buckets[bucket_index] != 0) {
+            auto current_job_index = index_buckets[bucket_index] - 1;
+            auto job = &(*this)[current_job_index];
+
+            if(job->kind == JobKind::ParseFile && job->parse_file.path == path) {
+                found = true;
+                *job_index = current_job_index;
+
+                break;
+            }
+
+            bucket_index = (bucket_index + 1) & (index_capacity - 1);
+        }
+    }
+
+    unlock_mutex(mutex);
+
+    return found;
+}
+
+bool JobList::find_polymorphic_function(
+    FunctionDeclaration* declaration,
+    ConstantScope* scope,
+    TypedConstantValue* parameters,
+    size_t* job_index
+) {
+    lock_mutex(mutex);
+
+    auto found = false;
+    if(index_capacity != 0) {
+        auto hash = calculate_polymorphic_function_hash(declaration, scope, parameters);
+
+        auto bucket_index = (size_t)hash & (index_capacity - 1);
+
+        while(index_buckets[bucket_index] != 0) {
+            auto current_job_index = index_buckets[bucket_index] - 1;
+            auto job = &(*this)[current_job_index];
+
+            if(
+                job->kind == JobKind::ResolvePolymorphicFunction &&
+                job->resolve_polymorphic_function.declaration == declaration &&
+                job->resolve_polymorphic_function.scope == scope &&
+                polymorphic_function_parameters_equal(declaration, parameters, job->resolve_polymorphic_function.parameters)
+            ) {
+                found = true;
+                *job_index = current_job_index;
+
+                break;
+            }
+
+            bucket_index = (bucket_index + 1) & (index_capacity - 1);
+        }
+    }
+
+    unlock_mutex(mutex);
+
+    return found;
+}
+
+bool JobList::find_polymorphic_struct(StructDefinition* definition, AnyConstantValue* parameters, size_t* job_index) {
+    lock_mutex(mutex);
+
+    auto found = false;
+    if(index_capacity != 0) {
+        auto parameter_count = definition->parameters.length;
+
+        auto hash = calculate_polymorphic_type_hash(JobKind::ResolvePolymorphicStruct, definition, parameter_count, parameters);
+
+        auto bucket_index = (size_t)hash & (index_capacity - 1);
+
+        while(index_buckets[bucket_index] != 0) {
+            auto current_job_index = index_buckets[bucket_index] - 1;
+            auto job = &(*this)[current_job_index];
+
+            if(
+                job->kind == JobKind::ResolvePolymorphicStruct &&
+                job->resolve_polymorphic_struct.definition == definition &&
+                polymorphic_type_parameters_equal(parameter_count, parameters, job->resolve_polymorphic_struct.parameters)
+            ) {
+                found = true;
+                *job_index = current_job_index;
+
+                break;
+            }
+
+            bucket_index = (bucket_index + 1) & (index_capacity - 1);
+        }
+    }
+
+    unlock_mutex(mutex);
+
+    return found;
+}
+
+bool JobList::find_polymorphic_union(UnionDefinition* definition, AnyConstantValue* parameters, size_t* job_index) {
+    lock_mutex(mutex);
+
+    auto found = false;
+    if(index_capacity != 0) {
+        auto parameter_count = definition->parameters.length;
+
+        auto hash = calculate_polymorphic_type_hash(JobKind::ResolvePolymorphicUnion, definition, parameter_count, parameters);
+
+        auto bucket_index = (size_t)hash & (index_capacity - 1);
+
+        while(index_buckets[bucket_index] != 0) {
+            auto current_job_index = index_buckets[bucket_index] - 1;
+            auto job = &(*this)[current_job_index];
+
+            if(
+                job->kind == JobKind::ResolvePolymorphicUnion &&
+                job->resolve_polymorphic_union.definition == definition &&
+                polymorphic_type_parameters_equal(parameter_count, parameters, job->resolve_polymorphic_union.parameters)
+            ) {
+                found = true;
+                *job_index = current_job_index;
+
+                break;
+            }
+
+            bucket_index = (bucket_index + 1) & (index_capacity - 1);
+        }
+    }
+
+    unlock_mutex(mutex);
+
+    return found;
+}
\ No newline at end of file
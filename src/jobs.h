@@ -4,11 +4,19 @@
 #include "constant.h"
 #include "types.h"
 #include "hlir.h"
+#include "list.h"
+#include "threading.h"
+#include "arena.h"
+
+struct FunctionGenerationState;
 
 struct ParseFile {
     String path;
 
     ConstantScope* scope;
+
+    // Holds the file's syntax tree, which is never freed
+    Arena ast_arena;
 };
 
 struct ResolveStaticIf {
@@ -88,6 +96,8 @@ struct GenerateFunction {
     FunctionConstant value;
 
     Function* function;
+
+    FunctionGenerationState* generation_state;
 };
 
 struct GenerateStaticVariable {
@@ -127,6 +137,8 @@ struct AnyJob {
 
     size_t waiting_for;
 
+    List<size_t> waiters;
+
     union {
         ParseFile parse_file;
         ResolveStaticIf resolve_static_if;
@@ -141,4 +153,76 @@ struct AnyJob {
         GenerateFunction generate_function;
         GenerateStaticVariable generate_static_variable;
     };
-};
\ No newline at end of file
+};
+
+inline JobState get_job_state(AnyJob* job) {
+    return (JobState)atomic_load((int*)&job->state);
+}
+
+inline void set_job_state(AnyJob* job, JobState state) {
+    atomic_store((int*)&job->state, (int)state);
+}
+
+const size_t job_list_first_chunk_size = 64;
+const size_t job_list_max_chunks = 48;
+
+// Jobs are stored in chunks that double in size and are never moved, so job pointers stay valid while other threads append.
+// Hold the list lock across a search and the append that follows it, so two threads can't both add the same job.
+// Most job kinds are identified by a subject (the declaration, definition or static if) and the scope it's in,
+// generated functions by their declaration and body scope, and parsed files by their absolute path.
+struct JobList {
+    Mutex mutex;
+
+    AnyJob* chunks[job_list_max_chunks];
+
+    size_t length;
+
+    // Open addressing table of job indices plus one, so jobs can be found by what they resolve or generate
+    size_t* index_buckets;
+    size_t index_capacity;
+    size_t index_count;
+
+    inline size_t get_length() {
+        return atomic_load(&length);
+    }
+
+    inline AnyJob& operator[](size_t index) {
+        auto chunk_number = index / job_list_first_chunk_size + 1;
+
+        size_t chunk_index = 63 - __builtin_clzll(chunk_number);
+
+        auto chunk_start = job_list_first_chunk_size * (((size_t)1 << chunk_index) - 1);
+
+        return chunks[chunk_index][index - chunk_start];
+    }
+
+    inline void lock() {
+        lock_mutex(mutex);
+    }
+
+    inline void unlock() {
+        unlock_mutex(mutex);
+    }
+
+    size_t append(AnyJob job);
+
+    bool find(JobKind kind, void* subject, ConstantScope* scope, size_t* job_index);
+    bool find_parse_file(String path, size_t* job_index);
+
+    // Polymorphic instantiations are indexed by a structural hash of their parameters
+    bool find_polymorphic_function(
+        FunctionDeclaration* declaration,
+        ConstantScope* scope,
+        TypedConstantValue* parameters,
+        size_t* job_index
+    );
+    bool find_polymorphic_struct(StructDefinition* definition, AnyConstantValue* parameters, size_t* job_index);
+    bool find_polymorphic_union(UnionDefinition* definition, AnyConstantValue* parameters, size_t* job_index);
+};
+
+inline JobList create_job_list() {
+    JobList jobs {};
+    jobs.mutex = create_mutex();
+
+    return jobs;
+}
\ No newline at end of file
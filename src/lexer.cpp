@@ -4,103 +4,13 @@
 #include <stdarg.h>
 #include "profiler.h"
 #include "list.h"
+#include "arena.h"
 #include "util.h"
+#include "symbols.h"
+#include "source_files.h"
+#include "byte_scan.h"
 
-static void error(String path, unsigned int line, unsigned int column, const char* format, ...) {
-    va_list arguments;
-    va_start(arguments, format);
-
-    fprintf(stderr, "Error: %.*s(%u,%u): ", STRING_PRINTF_ARGUMENTS(path), line, column);
-    vfprintf(stderr, format, arguments);
-    fprintf(stderr, "\n");
-
-    auto file = fopen(path.to_c_string(), "rb");
-
-    if(file != nullptr) {
-        unsigned int current_line = 1;
-
-        while(current_line != line) {
-            auto character = fgetc(file);
-
-            switch(character) {
-                case '\r': {
-                    auto character = fgetc(file);
-
-                    if(character == '\n') {
-                        current_line += 1;
-                    } else {
-                        ungetc(character, file);
-
-                        current_line += 1;
-                    }
-                } break;
-
-                case '\n': {
-                    current_line += 1;
-                } break;
-
-                case EOF: {
-                    fclose(file);
-
-                    va_end(arguments);
-
-                    return;
-                } break;
-            }
-        }
-
-        unsigned int skipped_spaces = 0;
-        auto done_skipping_spaces = false;
-
-        auto done = false;
-        while(!done) {
-            auto character = fgetc(file);
-
-            switch(character) {
-                case '\r':
-                case '\n': {
-                    done = true;
-                } break;
-
-                case ' ': {
-                    if(!done_skipping_spaces) {
-                        skipped_spaces += 1;
-                    } else {
-                        fprintf(stderr, "%c", character);
-                    }
-                } break;
-
-                case EOF: {
-                    fclose(file);
-
-                    va_end(arguments);
-
-                    return;
-                } break;
-
-                default: {
-                    fprintf(stderr, "%c", character);
-
-                    done_skipping_spaces = true;
-                } break;
-            }
-        }
-
-        fprintf(stderr, "\n");
-
-        for(unsigned int i = 1; i < column - skipped_spaces; i += 1) {
-            fprintf(stderr, " ");
-        }
-
-        fprintf(stderr, "^\n");
-
-        fclose(file);
-    }
-
-    va_end(arguments);
-}
-
-void append_single_character_token(unsigned int line, unsigned int column, List<Token>* tokens, TokenKind type) {
+void append_single_character_token(unsigned int line, unsigned int column, ArenaList<Token>* tokens, TokenKind type) {
     Token token;
     token.kind = type;
     token.line = line;
@@ -110,7 +20,7 @@ void append_single_character_token(unsigned int line, unsigned int column, List<
     tokens->append(token);
 }
 
-void append_double_character_token(unsigned int line, unsigned int first_column, List<Token>* tokens, TokenKind type) {
+void append_double_character_token(unsigned int line, unsigned int first_column, ArenaList<Token>* tokens, TokenKind type) {
     Token token;
     token.kind = type;
     token.line = line;
@@ -124,6 +34,8 @@ namespace {
     struct Lexer {
         String path;
 
+        Arena* arena;
+
         size_t length;
         uint8_t* source;
 
@@ -132,6 +44,38 @@ namespace {
         unsigned int line;
         unsigned int column;
 
+        List<size_t> line_offsets;
+
+        void error(const char* format, ...) {
+            va_list arguments;
+            va_start(arguments, format);
+
+            lock_diagnostics();
+
+            fprintf(stderr, "Error: %.*s(%u,%u): ", STRING_PRINTF_ARGUMENTS(path), line, column);
+            vfprintf(stderr, format, arguments);
+            fprintf(stderr, "\n");
+
+            va_end(arguments);
+
+            print_source_line(source, length, line_offsets[line - 1], column, column);
+
+            unlock_diagnostics();
+        }
+
+        // Only for runs of ASCII bytes, which are a column each
+        inline void skip_ascii_bytes(size_t count) {
+            index += count;
+            column += (unsigned int)count;
+        }
+
+        inline void start_new_line() {
+            line += 1;
+            column = 1;
+
+            line_offsets.append(index);
+        }
+
         inline Result<char32_t> get_current_character() {
             assert(index < length);
 
@@ -149,12 +93,12 @@ namespace {
             // Definitely at least 2 bytes
 
             if(first_byte >> 6 != 0b11) {
-                error(path, line, column, "Invalid UTF-8 byte sequence");
+                error("Invalid UTF-8 byte sequence");
                 return err();
             }
 
             if(temp_index == length) {
-                error(path, line, column, "Invalid UTF-8 byte sequence");
+                error("Invalid UTF-8 byte sequence");
                 return err();
             }
 
@@ -162,7 +106,7 @@ namespace {
             temp_index += 1;
 
             if(second_byte >> 6 != 0b10) {
-                error(path, line, column, "Invalid UTF-8 byte sequence");
+                error("Invalid UTF-8 byte sequence");
                 return err();
             }
 
@@ -172,7 +116,7 @@ namespace {
                 auto codepoint = (((uint32_t)first_byte & 0b11111) << 6) | ((uint32_t)second_byte & 0b111111);
 
                 if(codepoint < 0x0080) {
-                    error(path, line, column, "Invalid UTF-8 byte sequence");
+                    error("Invalid UTF-8 byte sequence");
                     return err();
                 }
 
@@ -182,7 +126,7 @@ namespace {
             // Definitely at least 3 bytes
 
             if(temp_index == length) {
-                error(path, line, column, "Invalid UTF-8 byte sequence");
+                error("Invalid UTF-8 byte sequence");
                 return err();
             }
 
@@ -190,7 +134,7 @@ namespace {
             temp_index += 1;
 
             if(third_byte >> 6 != 0b10) {
-                error(path, line, column, "Invalid UTF-8 byte sequence");
+                error("Invalid UTF-8 byte sequence");
                 return err();
             }
 
@@ -204,7 +148,7 @@ namespace {
                 ;
 
                 if(codepoint < 0x0800) {
-                    error(path, line, column, "Invalid UTF-8 byte sequence");
+                    error("Invalid UTF-8 byte sequence");
                     return err();
                 }
 
@@ -214,12 +158,12 @@ namespace {
             // Definitely 4 byte
 
             if(first_byte >> 3 != 0b11110) {
-                error(path, line, column, "Invalid UTF-8 byte sequence");
+                error("Invalid UTF-8 byte sequence");
                 return err();
             }
 
             if(temp_index == length) {
-                error(path, line, column, "Invalid UTF-8 byte sequence");
+                error("Invalid UTF-8 byte sequence");
                 return err();
             }
 
@@ -227,7 +171,7 @@ namespace {
             temp_index += 1;
 
             if(fourth_byte >> 6 != 0b10) {
-                error(path, line, column, "Invalid UTF-8 byte sequence");
+                error("Invalid UTF-8 byte sequence");
                 return err();
             }
 
@@ -239,7 +183,7 @@ namespace {
             ;
 
             if(codepoint < 0x010000) {
-                error(path, line, column, "Invalid UTF-8 byte sequence");
+                error("Invalid UTF-8 byte sequence");
                 return err();
             }
 
@@ -265,13 +209,14 @@ namespace {
         }
 
         Result<Array<Token>> tokenize() {
-            List<Token> tokens {};
+            ArenaList<Token> tokens {};
+            tokens.arena = arena;
 
             while(index < length) {
                 expect(character, get_current_character());
 
                 if(character == ' ') {
-                    consume_current_character();
+                    skip_ascii_bytes(count_space_bytes(&source[index], length - index));
                 } else if(character == '\r') {
                     consume_current_character();
 
@@ -283,13 +228,11 @@ namespace {
                         }
                     }
 
-                    line += 1;
-                    column = 1;
+                    start_new_line();
                 } else if(character == '\n') {
                     consume_current_character();
 
-                    line += 1;
-                    column = 1;
+                    start_new_line();
                 } else if(character == '/') {
                     auto first_column = column;
 
@@ -303,6 +246,12 @@ namespace {
                         consume_current_character();
 
                         while(index < length) {
+                            skip_ascii_bytes(count_line_comment_bytes(&source[index], length - index));
+
+                            if(index == length) {
+                                break;
+                            }
+
                             expect(character, get_current_character());
 
                             if(character == '\r') {
@@ -312,15 +261,13 @@ namespace {
                                     consume_current_character();
                                 }
 
-                                line += 1;
-                                column = 1;
+                                start_new_line();
 
                                 break;
                             } else if(character == '\n') {
                                 consume_current_character();
 
-                                line += 1;
-                                column = 1;
+                                start_new_line();
 
                                 break;
                             } else {
@@ -333,13 +280,17 @@ namespace {
                         unsigned int level = 1;
 
                         while(level > 0) {
-                            expect(character, get_current_character());
+                            skip_ascii_bytes(count_block_comment_bytes(&source[index], length - index));
 
                             if(index == length) {
-                                error(path, line, column, "Unexpected end of file");
+                                error("Unexpected end of file");
 
                                 return err();
-                            } else if(character == '\r') {
+                            }
+
+                            expect(character, get_current_character());
+
+                            if(character == '\r') {
                                 consume_current_character();
 
                                 if(index < length) {
@@ -350,13 +301,11 @@ namespace {
                                     }
                                 }
 
-                                line += 1;
-                                column = 1;
+                                start_new_line();
                             } else if(character == '\n') {
                                 consume_current_character();
 
-                                line += 1;
-                                column = 1;
+                                start_new_line();
                             } else if(character == '/') {
                                 consume_current_character();
 
@@ -651,13 +600,28 @@ namespace {
                 } else if(character == '"') {
                     consume_current_character();
 
+                    auto first_index = index;
                     auto first_column = column;
 
+                    // Literals without escapes point straight into the source, only ones with escapes are copied
+                    auto has_escapes = false;
                     StringBuffer buffer {};
 
                     while(true) {
+                        auto run_start_index = index;
+
+                        skip_ascii_bytes(count_string_literal_bytes(&source[index], length - index));
+
+                        if(has_escapes) {
+                            String run {};
+                            run.length = index - run_start_index;
+                            run.elements = (char8_t*)&source[run_start_index];
+
+                            buffer.append(run);
+                        }
+
                         if(index == length) {
-                            error(path, line, column, "Unexpected end of file");
+                            error("Unexpected end of file");
 
                             return err();
                         }
@@ -665,7 +629,7 @@ namespace {
                         expect(character, get_current_character());
 
                         if(character == '\n' || character == '\r') {
-                            error(path, line, column, "Unexpected newline");
+                            error("Unexpected newline");
 
                             return err();
                         } else if(character == '"') {
@@ -673,10 +637,20 @@ namespace {
 
                             break;
                         } else if(character == '\\') {
+                            if(!has_escapes) {
+                                has_escapes = true;
+
+                                String previous_characters {};
+                                previous_characters.length = index - first_index;
+                                previous_characters.elements = (char8_t*)&source[first_index];
+
+                                buffer.append(previous_characters);
+                            }
+
                             consume_current_character();
 
                             if(index == length) {
-                                error(path, line, column, "Unexpected end of file");
+                                error("Unexpected end of file");
 
                                 return err();
                             }
@@ -694,21 +668,23 @@ namespace {
                             } else if(character == 'n') {
                                 buffer.append_character('\n');
                             } else if(character == '\r' || character == '\n') {
-                                error(path, line, column, "Unexpected newline");
+                                error("Unexpected newline");
 
                                 return err();
                             } else {
                                 StringBuffer buffer {};
                                 buffer.append_character(character);
 
-                                error(path, line, column, "Unknown escape code '\\%.*s'", STRING_PRINTF_ARGUMENTS(buffer));
+                                error("Unknown escape code '\\%.*s'", STRING_PRINTF_ARGUMENTS(buffer));
 
                                 return err();
                             }
 
                             consume_current_character();
                         } else {
-                            buffer.append_character(character);
+                            if(has_escapes) {
+                                buffer.append_character(character);
+                            }
 
                             consume_current_character();
                         }
@@ -719,7 +695,13 @@ namespace {
                     token.line = line;
                     token.first_column = first_column;
                     token.last_column = column - 2;
-                    token.string = buffer;
+
+                    if(has_escapes) {
+                        token.string = buffer;
+                    } else {
+                        token.string.length = index - 1 - first_index;
+                        token.string.elements = (char8_t*)&source[first_index];
+                    }
 
                     tokens.append(token);
                 } else if(
@@ -727,37 +709,27 @@ namespace {
                     (character >= 'A' && character <= 'Z') ||
                     character == '_'
                 ) {
-                    StringBuffer buffer {};
-
-                    buffer.append_character(character);
-
+                    auto first_index = index;
                     auto first_column = column;
 
                     consume_current_character();
 
-                    while(index < length) {
-                        expect(character, get_current_character());
+                    skip_ascii_bytes(count_identifier_bytes(&source[index], length - index));
 
-                        if(
-                            (character >= 'a' && character <= 'z') ||
-                            (character >= 'A' && character <= 'Z') ||
-                            (character >= '0' && character <= '9') ||
-                            character == '_'
-                        ) {
-                            buffer.append_character(character);
+                    // Identifiers are plain ASCII, so their text is exactly the source bytes they were read from
+                    String text {};
+                    text.length = index - first_index;
+                    text.elements = (char8_t*)&source[first_index];
 
-                            consume_current_character();
-                        } else {
-                            break;
-                        }
-                    }
+                    auto hash = calculate_string_hash(text);
 
                     Token token;
                     token.kind = TokenKind::Identifier;
                     token.line = line;
                     token.first_column = first_column;
                     token.last_column = column - 1;
-                    token.identifier = buffer;
+                    token.identifier = intern_symbol(text, hash);
+                    token.identifier_hash = hash;
 
                     tokens.append(token);
                 } else if((character >= '0' && character <= '9') || character == '.') {
@@ -801,6 +773,22 @@ namespace {
                     StringBuffer buffer {};
 
                     while(index < length) {
+                        if(radix >= 10) {
+                            auto digit_count = count_decimal_digit_bytes(&source[index], length - index);
+
+                            if(digit_count != 0) {
+                                String digits {};
+                                digits.length = digit_count;
+                                digits.elements = (char8_t*)&source[index];
+
+                                buffer.append(digits);
+
+                                skip_ascii_bytes(digit_count);
+
+                                continue;
+                            }
+                        }
+
                         expect(character, get_current_character());
 
                         if(character == '.' && (!definitely_integer && !seen_dot && !seen_e)) {
@@ -900,7 +888,7 @@ namespace {
                     StringBuffer buffer {};
                     buffer.append_character(character);
 
-                    error(path, line, column, "Unexpected character '%.*s'", STRING_PRINTF_ARGUMENTS(buffer));
+                    error("Unexpected character '%.*s'", STRING_PRINTF_ARGUMENTS(buffer));
 
                     return err();
                 }
@@ -911,56 +899,36 @@ namespace {
     };
 };
 
-profiled_function(Result<Array<Token>>, tokenize_source, (String path), (path)) {
+profiled_function(Result<Array<Token>>, tokenize_source, (String path, Arena* arena), (path, arena)) {
     Lexer lexer {};
     lexer.path = path;
+    lexer.arena = arena;
 
     enter_region("read source file");
 
-    auto file = fopen(path.to_c_string(), "rb");
-
-    if(file == nullptr) {
-        fprintf(stderr, "Error: Unable to read source file at '%.*s'\n", STRING_PRINTF_ARGUMENTS(path));
-
-        leave_region();
-
-        return err();
-    }
-
-    fseek(file, 0, SEEK_END);
-
-    auto signed_length = ftell(file);
+    auto file_result = load_source_file(path);
 
-    if(signed_length == -1) {
-        fprintf(stderr, "Error: Unable to determine length of source file at '%.*s'\n", STRING_PRINTF_ARGUMENTS(path));
-
-        leave_region();
-
-        return err();
-    }
-
-    lexer.length = (size_t)signed_length;
-
-    fseek(file, 0, SEEK_SET);
-
-    lexer.source = allocate<uint8_t>(lexer.length);
-
-    if(fread(lexer.source, lexer.length, 1, file) != 1) {
-        fprintf(stderr, "Error: Unable to read source file at '%.*s'\n", STRING_PRINTF_ARGUMENTS(path));
-
-        leave_region();
+    leave_region();
 
+    if(!file_result.status) {
         return err();
     }
 
-    fclose(file);
+    auto file = file_result.value;
 
-    leave_region();
+    lexer.length = file->length;
+    lexer.source = file->source;
 
     lexer.index = 0;
 
     lexer.line = 1;
     lexer.column = 1;
 
-    return lexer.tokenize();
+    lexer.line_offsets.append(0);
+
+    auto result = lexer.tokenize();
+
+    set_source_file_line_offsets(file, lexer.line_offsets);
+
+    return result;
 }
\ No newline at end of file
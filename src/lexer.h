@@ -3,5 +3,7 @@
 #include "tokens.h"
 #include "result.h"
 #include "array.h"
+#include "arena.h"
 
-Result<Array<Token>> tokenize_source(String path);
\ No newline at end of file
+// Tokens are allocated in the given arena, the source itself stays loaded in the source file table
+Result<Array<Token>> tokenize_source(String path, Arena* arena);
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "lld_linker.h"
+#include <stdio.h>
+#include <lld/Common/Driver.h>
+#include <llvm/Support/raw_ostream.h>
+#include "list.h"
+
+LLD_HAS_DRIVER(elf)
+LLD_HAS_DRIVER(coff)
+LLD_HAS_DRIVER(mingw)
+LLD_HAS_DRIVER(wasm)
+
+static void append_argument(List<const char*>* arguments, String prefix, String value) {
+    StringBuffer buffer {};
+    buffer.append(prefix);
+    buffer.append(value);
+
+    arguments->append(buffer.to_c_string());
+}
+
+// The same defaults the clang driver would give lld for a linux target
+static Result<void> append_linux_arguments(String architecture, List<const char*>* arguments) {
+    String multiarch_name;
+    String dynamic_linker_path;
+    if(architecture == u8"x86"_S) {
+        multiarch_name = u8"i386-linux-gnu"_S;
+        dynamic_linker_path = u8"/lib/ld-linux.so.2"_S;
+    } else if(architecture == u8"x64"_S) {
+        multiarch_name = u8"x86_64-linux-gnu"_S;
+        dynamic_linker_path = u8"/lib64/ld-linux-x86-64.so.2"_S;
+    } else if(architecture == u8"riscv32"_S) {
+        multiarch_name = u8"riscv32-linux-gnu"_S;
+        dynamic_linker_path = u8"/lib/ld-linux-riscv32-ilp32d.so.1"_S;
+    } else if(architecture == u8"riscv64"_S) {
+        multiarch_name = u8"riscv64-linux-gnu"_S;
+        dynamic_linker_path = u8"/lib/ld-linux-riscv64-lp64d.so.1"_S;
+    } else {
+        fprintf(stderr, "Error: Unable to link for architecture '%.*s' on linux in-process\n", STRING_PRINTF_ARGUMENTS(architecture));
+
+        return err();
+    }
+
+    arguments->append("-pie");
+    arguments->append("--entry=entry");
+
+    append_argument(arguments, u8"--dynamic-linker="_S, dynamic_linker_path);
+
+    append_argument(arguments, u8"-L/lib/"_S, multiarch_name);
+    append_argument(arguments, u8"-L/usr/lib/"_S, multiarch_name);
+    arguments->append("-L/lib");
+    arguments->append("-L/usr/lib");
+
+    return ok();
+}
+
+Result<void> link_in_process(
+    String os,
+    String architecture,
+    String toolchain,
+    String config,
+    String output_file_path,
+    Array<String> object_file_paths,
+    Array<String> libraries
+) {
+    List<const char*> arguments {};
+
+    // lld picks its flavor from the program name
+    auto is_msvc = os == u8"windows"_S && toolchain == u8"msvc"_S;
+    if(is_msvc) {
+        arguments.append("lld-link");
+
+        arguments.append("/entry:entry");
+        arguments.append("/SUBSYSTEM:CONSOLE");
+
+        if(config == u8"debug"_S) {
+            arguments.append("/DEBUG");
+        }
+
+        append_argument(&arguments, u8"/out:"_S, output_file_path);
+    } else {
+        if(os == u8"wasi"_S) {
+            arguments.append("wasm-ld");
+        } else {
+            arguments.append("ld.lld");
+        }
+
+        if(os == u8"windows"_S) {
+            arguments.append("-m");
+
+            if(architecture == u8"x86"_S) {
+                arguments.append("i386pe");
+            } else {
+                arguments.append("i386pep");
+            }
+
+            arguments.append("--entry=entry");
+            arguments.append("--subsystem=console");
+        } else if(os == u8"linux"_S) {
+            expect_void(append_linux_arguments(architecture, &arguments));
+        }
+
+        append_argument(&arguments, u8"-o"_S, output_file_path);
+    }
+
+    for(auto library : libraries) {
+        if(is_msvc) {
+            append_argument(&arguments, library, u8".lib"_S);
+        } else {
+            append_argument(&arguments, u8"-l"_S, library);
+        }
+    }
+
+    for(auto object_file_path : object_file_paths) {
+        arguments.append(object_file_path.to_c_string());
+    }
+
+    lld::DriverDef drivers[] {
+        { lld::Gnu, &lld::elf::link },
+        { lld::MinGW, &lld::mingw::link },
+        { lld::WinLink, &lld::coff::link },
+        { lld::Wasm, &lld::wasm::link }
+    };
+
+    auto result = lld::lldMain(
+        llvm::ArrayRef<const char*>(arguments.elements, arguments.length),
+        llvm::outs(),
+        llvm::errs(),
+        drivers
+    );
+
+    if(result.retCode != 0) {
+        fprintf(stderr, "Error: lld failed while linking\n");
+
+        return err();
+    }
+
+    return ok();
+}
\ No newline at end of file
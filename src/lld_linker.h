@@ -0,0 +1,16 @@
+#pragma once
+
+#include "array.h"
+#include "string.h"
+#include "result.h"
+
+// Runs lld through its library entry points rather than spawning a linker process, emscripten still needs emcc
+Result<void> link_in_process(
+    String os,
+    String architecture,
+    String toolchain,
+    String config,
+    String output_file_path,
+    Array<String> object_file_paths,
+    Array<String> libraries
+);
\ No newline at end of file
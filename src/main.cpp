@@ -3,6 +3,7 @@
 #include <string.h>
 #include "constant.h"
 #include "timing.h"
+#include "threading.h"
 #include "profiler.h"
 #include "lexer.h"
 #include "parser.h"
@@ -14,6 +15,9 @@
 #include "jobs.h"
 #include "hl_generator.h"
 #include "types.h"
+#if defined(IN_PROCESS_LINKER)
+#include "lld_linker.h"
+#endif
 
 inline String get_default_output_file(String os, bool no_link) {
     if(no_link) {
@@ -42,19 +46,22 @@ static void print_help_message(FILE* file) {
     fprintf(file, "Options:\n");
     fprintf(file, "  -output <output file>  (default: %.*s) Specify output file path\n", STRING_PRINTF_ARGUMENTS(default_output_file));
     fprintf(file, "  -config debug|release  (default: debug) Specify build configuration\n");
+    fprintf(file, "  -opt 0|1|2|3|s|z  (default: 0 for debug, 2 for release) Specify LLVM optimization level\n");
     fprintf(file, "  -arch x86|x64|riscv32|riscv64|wasm32  (default: %.*s) Specify CPU architecture to target\n", STRING_PRINTF_ARGUMENTS(default_architecture));
     fprintf(file, "  -os windows|linux|emscripten|wasi  (default: %.*s) Specify operating system to target\n", STRING_PRINTF_ARGUMENTS(default_os));
     fprintf(file, "  -os gnu|msvc  (default: %.*s) Specify toolchain to use\n", STRING_PRINTF_ARGUMENTS(default_toolchain));
+    fprintf(file, "  -jobs <count>  (default: 1) Number of threads to run compilation jobs and LLVM code generation on, 0 uses one per processor. Code generation only uses more than one thread at -opt 0\n");
     fprintf(file, "  -no-link  Don't run the linker\n");
     fprintf(file, "  -print-ast  Print abstract syntax tree\n");
     fprintf(file, "  -print-ir  Print internal intermediate representation\n");
     fprintf(file, "  -print-llvm  Print LLVM IR\n");
+    fprintf(file, "  -print-restarts  Print how many times the generation of each function had to restart\n");
     fprintf(file, "  -help  Display this help message then exit\n");
 }
 
 inline void append_global_constant(List<GlobalConstant>* global_constants, String name, AnyType type, AnyConstantValue value) {
     GlobalConstant global_constant {};
-    global_constant.name = name;
+    global_constant.name = intern_symbol(name);
     global_constant.type = type;
     global_constant.value = value;
 
@@ -84,1034 +91,1784 @@ inline void append_builtin(List<GlobalConstant>* global_constants, String name)
     );
 }
 
-static_profiled_function(Result<void>, cli_entry, (Array<const char*> arguments), (arguments)) {
-    auto start_time = get_timer_counts();
+// Ready jobs are kept in a binary min-heap on job index, so the lowest-index runnable job always runs next
+static void push_ready_job(List<size_t>* ready_jobs, size_t job_index) {
+    auto index = ready_jobs->append(job_index);
 
-    bool has_source_file_path = false;
-    String source_file_path;
-    bool has_output_file_path = false;
-    String output_file_path;
+    while(index != 0) {
+        auto parent_index = (index - 1) / 2;
 
-    auto architecture = get_host_architecture();
+        if((*ready_jobs)[parent_index] <= job_index) {
+            break;
+        }
 
-    auto os = get_host_os();
+        (*ready_jobs)[index] = (*ready_jobs)[parent_index];
+        index = parent_index;
+    }
 
-    auto has_toolchain = false;
-    String toolchain;
+    (*ready_jobs)[index] = job_index;
+}
 
-    auto config = u8"debug"_S;
+static size_t take_ready_job(List<size_t>* ready_jobs) {
+    auto first_job_index = (*ready_jobs)[0];
 
-    auto no_link = false;
-    auto print_ast = false;
-    auto print_ir = false;
-    auto print_llvm = false;
+    auto last_job_index = ready_jobs->take_last();
 
-    int argument_index = 1;
-    while(argument_index < arguments.length) {
-        auto argument = arguments[argument_index];
+    if(ready_jobs->length != 0) {
+        size_t index = 0;
+        while(true) {
+            auto child_index = index * 2 + 1;
 
-        if(argument_index == arguments.length - 1 && argument[0] != '-') {
-            has_source_file_path = true;
+            if(child_index >= ready_jobs->length) {
+                break;
+            }
 
-            auto result = String::from_c_string(argument);
-            if(!result.status) {
-                fprintf(stderr, "Error: Invalid source file path '%s'\n", argument);
+            if(child_index + 1 < ready_jobs->length && (*ready_jobs)[child_index + 1] < (*ready_jobs)[child_index]) {
+                child_index += 1;
+            }
 
-                return err();
+            if(last_job_index <= (*ready_jobs)[child_index]) {
+                break;
             }
 
-            source_file_path = result.value;
-        } else if(strcmp(argument, "-output") == 0) {
-            argument_index += 1;
+            (*ready_jobs)[index] = (*ready_jobs)[child_index];
+            index = child_index;
+        }
 
-            if(argument_index == arguments.length - 1) {
-                fprintf(stderr, "Error: Missing value for '-output' option\n\n");
-                print_help_message(stderr);
+        (*ready_jobs)[index] = last_job_index;
+    }
 
-                return err();
-            }
+    return first_job_index;
+}
 
-            has_output_file_path = true;
+// Newly appended jobs always start out runnable
+static void schedule_new_jobs(JobList* jobs, List<size_t>* ready_jobs, size_t* scheduled_job_count) {
+    while(*scheduled_job_count < jobs->get_length()) {
+        (*jobs)[*scheduled_job_count].waiters = {};
 
-            auto result = String::from_c_string(arguments[argument_index]);
-            if(!result.status) {
-                fprintf(stderr, "Error: Invalid output file path '%s'\n", arguments[argument_index]);
+        push_ready_job(ready_jobs, *scheduled_job_count);
 
-                return err();
-            }
+        *scheduled_job_count += 1;
+    }
+}
 
-            output_file_path = result.value;
-        } else if(strcmp(argument, "-arch") == 0) {
-            argument_index += 1;
+struct StaticConstantPoolEntry {
+    uint64_t hash;
 
-            if(argument_index == arguments.length - 1) {
-                fprintf(stderr, "Error: Missing value for '-arch' option\n\n");
-                print_help_message(stderr);
+    StaticConstant* constant;
+};
 
-                return err();
-            }
+// Static constants with the same type and value share the first one registered, so each is only emitted once
+struct StaticConstantPool {
+    StaticConstantPoolEntry* entries;
+    size_t capacity;
+    size_t count;
+};
 
-            auto result = String::from_c_string(arguments[argument_index]);
-            if(!result.status) {
-                fprintf(stderr, "Error: '%s' is not a valid '-arch' option value\n\n", arguments[argument_index]);
-                print_help_message(stderr);
+static void insert_static_constant_pool_entry(StaticConstantPoolEntry* entries, size_t capacity, StaticConstantPoolEntry entry) {
+    auto entry_index = (size_t)entry.hash & (capacity - 1);
 
-                return err();
-            }
+    while(entries[entry_index].constant != nullptr) {
+        entry_index = (entry_index + 1) & (capacity - 1);
+    }
 
-            architecture = result.value;
-        } else if(strcmp(argument, "-os") == 0) {
-            argument_index += 1;
+    entries[entry_index] = entry;
+}
 
-            if(argument_index == arguments.length - 1) {
-                fprintf(stderr, "Error: Missing value for '-os' option\n\n");
-                print_help_message(stderr);
+// Returns the pooled constant equal to the given one, adding it to the pool if there is none yet
+static StaticConstant* pool_static_constant(StaticConstantPool* pool, StaticConstant* constant) {
+    auto hash = combine_hash(constant->type.get_hash(), constant->value.get_hash());
 
-                return err();
-            }
+    if(pool->capacity != 0) {
+        auto entry_index = (size_t)hash & (pool->capacity - 1);
 
-            auto result = String::from_c_string(arguments[argument_index]);
-            if(!result.status) {
-                fprintf(stderr, "Error: '%s' is not a valid '-os' option value\n\n", arguments[argument_index]);
-                print_help_message(stderr);
+        while(pool->entries[entry_index].constant != nullptr) {
+            auto entry = &pool->entries[entry_index];
 
-                return err();
+            if(entry->hash == hash && entry->constant->type == constant->type && entry->constant->value == constant->value) {
+                return entry->constant;
             }
 
-            os = result.value;
-        } else if(strcmp(argument, "-toolchain") == 0) {
-            has_toolchain = true;
+            entry_index = (entry_index + 1) & (pool->capacity - 1);
+        }
+    }
 
-            argument_index += 1;
+    if((pool->count + 1) * 2 > pool->capacity) {
+        size_t new_capacity;
+        if(pool->capacity == 0) {
+            new_capacity = 64;
+        } else {
+            new_capacity = pool->capacity * 2;
+        }
 
-            if(argument_index == arguments.length - 1) {
-                fprintf(stderr, "Error: Missing value for '-toolchain' option\n\n");
-                print_help_message(stderr);
+        auto new_entries = allocate<StaticConstantPoolEntry>(new_capacity);
+        memset(new_entries, 0, sizeof(StaticConstantPoolEntry) * new_capacity);
 
-                return err();
+        for(size_t i = 0; i < pool->capacity; i += 1) {
+            if(pool->entries[i].constant != nullptr) {
+                insert_static_constant_pool_entry(new_entries, new_capacity, pool->entries[i]);
             }
+        }
 
-            auto result = String::from_c_string(arguments[argument_index]);
-            if(!result.status) {
-                fprintf(stderr, "Error: '%s' is not a valid '-toolchain' option value\n\n", arguments[argument_index]);
-                print_help_message(stderr);
+        free(pool->entries);
 
-                return err();
-            }
+        pool->entries = new_entries;
+        pool->capacity = new_capacity;
+    }
 
-            toolchain = result.value;
-        } else if(strcmp(argument, "-config") == 0) {
-            argument_index += 1;
+    StaticConstantPoolEntry entry {};
+    entry.hash = hash;
+    entry.constant = constant;
 
-            if(argument_index == arguments.length - 1) {
-                fprintf(stderr, "Error: Missing value for '-config' option\n\n");
-                print_help_message(stderr);
+    insert_static_constant_pool_entry(pool->entries, pool->capacity, entry);
+    pool->count += 1;
 
-                return err();
-            }
+    return constant;
+}
 
-            auto result = String::from_c_string(arguments[argument_index]);
-            if(!result.status) {
-                fprintf(stderr, "Error: '%s' is not a valid '-config' option value\n\n", arguments[argument_index]);
-                print_help_message(stderr);
+const size_t unordered_runtime_static_index = (size_t)-1;
 
-                return err();
-            }
+// Static constants aren't listed, they are only ordered once a function is found to reference them
+struct GeneratedStatic {
+    size_t job_index;
 
-            config = result.value;
-        } else if(strcmp(argument, "-no-link") == 0) {
-            no_link = true;
-        } else if(strcmp(argument, "-print-ast") == 0) {
-            print_ast = true;
-        } else if(strcmp(argument, "-print-ir") == 0) {
-            print_ir = true;
-        } else if(strcmp(argument, "-print-llvm") == 0) {
-            print_llvm = true;
-        } else if(strcmp(argument, "-help") == 0) {
-            print_help_message(stdout);
+    // The constants of the scopes the static was declared in, which tell apart the instances of one polymorphic declaration
+    String scope_constants_description;
 
-            return ok();
-        } else {
-            fprintf(stderr, "Error: Unknown option '%s'\n\n", argument);
-            print_help_message(stderr);
+    RuntimeStatic* runtime_static;
+};
 
-            return err();
+static String describe_scope_constants(ConstantScope* scope) {
+    StringBuffer buffer {};
+
+    auto current_scope = scope;
+    while(current_scope != nullptr) {
+        for(auto scope_constant : current_scope->scope_constants) {
+            buffer.append(scope_constant.name);
+            buffer.append(u8": "_S);
+            buffer.append(scope_constant.type.get_description());
+            buffer.append(u8" = "_S);
+            buffer.append(scope_constant.value.get_description());
+            buffer.append(u8"; "_S);
         }
 
-        argument_index += 1;
+        if(current_scope->is_top_level) {
+            break;
+        }
+
+        current_scope = current_scope->parent;
     }
 
-    if(
-        config == u8"debug"_S &&
-        config == u8"release"_S
-    ) {
-        fprintf(stderr, "Error: Unknown config '%.*s'\n\n", STRING_PRINTF_ARGUMENTS(config));
-        print_help_message(stderr);
+    return buffer;
+}
 
-        return err();
-    }
+static void append_generated_static(List<GeneratedStatic>* generated_statics, size_t job_index, ConstantScope* scope, RuntimeStatic* runtime_static) {
+    runtime_static->index = unordered_runtime_static_index;
 
-    if(!does_os_exist(os)) {
-        fprintf(stderr, "Error: Unknown OS '%.*s'\n\n", STRING_PRINTF_ARGUMENTS(os));
-        print_help_message(stderr);
+    GeneratedStatic generated_static {};
+    generated_static.job_index = job_index;
+    generated_static.scope_constants_description = describe_scope_constants(scope);
+    generated_static.runtime_static = runtime_static;
 
-        return err();
+    generated_statics->append(generated_static);
+}
+
+static int compare_sizes(size_t a, size_t b) {
+    if(a < b) {
+        return -1;
+    } else if(a > b) {
+        return 1;
+    } else {
+        return 0;
     }
+}
 
-    if(!does_architecture_exist(architecture)) {
-        fprintf(stderr, "Error: Unknown architecture '%.*s'\n\n", STRING_PRINTF_ARGUMENTS(architecture));
-        print_help_message(stderr);
+static int compare_strings(String a, String b) {
+    auto common_length = a.length;
+    if(b.length < common_length) {
+        common_length = b.length;
+    }
 
-        return err();
+    auto order = memcmp(a.elements, b.elements, common_length);
+    if(order != 0) {
+        return order;
     }
 
-    if(has_toolchain) {
-        if(!does_toolchain_exist(toolchain)) {
-            fprintf(stderr, "Error: Unknown toolchain '%.*s'\n\n", STRING_PRINTF_ARGUMENTS(toolchain));
-            print_help_message(stderr);
+    return compare_sizes(a.length, b.length);
+}
 
-            return err();
-        }
-    } else {
-        toolchain = get_default_toolchain(os);
+// Job indices depend on thread timing, so they only break ties between statics that are described exactly the same
+static int compare_generated_statics(const void* a, const void* b) {
+    auto generated_static_a = (const GeneratedStatic*)a;
+    auto generated_static_b = (const GeneratedStatic*)b;
+
+    auto order = compare_strings(generated_static_a->runtime_static->path, generated_static_b->runtime_static->path);
+    if(order != 0) {
+        return order;
     }
 
-    if(!is_supported_target(os, architecture, toolchain)) {
-        fprintf(
-            stderr,
-            "Error: '%.*s', '%.*s', and '%.*s' is not a supported OS, architecture, and toolchain combination\n\n",
-            STRING_PRINTF_ARGUMENTS(os),
-            STRING_PRINTF_ARGUMENTS(architecture),
-            STRING_PRINTF_ARGUMENTS(toolchain)
-        );
-        print_help_message(stderr);
+    auto range_a = generated_static_a->runtime_static->range;
+    auto range_b = generated_static_b->runtime_static->range;
 
-        return err();
+    order = compare_sizes(range_a.first_line, range_b.first_line);
+    if(order != 0) {
+        return order;
     }
 
-    if(!has_source_file_path) {
-        fprintf(stderr, "Error: No source file provided\n\n");
-        print_help_message(stderr);
+    order = compare_sizes(range_a.first_column, range_b.first_column);
+    if(order != 0) {
+        return order;
+    }
 
-        return err();
+    order = compare_strings(generated_static_a->scope_constants_description, generated_static_b->scope_constants_description);
+    if(order != 0) {
+        return order;
     }
 
-    expect(absolute_source_file_path, path_relative_to_absolute(source_file_path));
+    return compare_sizes(generated_static_a->job_index, generated_static_b->job_index);
+}
 
-    if(!has_output_file_path) {
-        output_file_path = get_default_output_file(os, no_link);
-    }
+// Gives a static its final index, then does the same for everything its body references that isn't ordered yet, depth first.
+// The pending statics are kept on a list rather than the native stack, since generated code can have very long call chains.
+static void order_runtime_static(
+    List<RuntimeStatic*>* runtime_statics,
+    StaticConstantPool* static_constant_pool,
+    List<RuntimeStatic*>* pending_statics,
+    RuntimeStatic* runtime_static
+) {
+    pending_statics->append(runtime_static);
+
+    while(pending_statics->length != 0) {
+        auto current_static = pending_statics->take_last();
+
+        if(current_static->index != unordered_runtime_static_index) {
+            continue;
+        }
 
-    auto architecture_sizes = get_architecture_sizes(architecture);
+        if(current_static->kind == RuntimeStaticKind::StaticConstant) {
+            auto static_constant = (StaticConstant*)current_static;
 
-    List<GlobalConstant> global_constants {};
+            auto pooled_constant = pool_static_constant(static_constant_pool, static_constant);
 
-    append_base_integer_type(&global_constants, u8"u8"_S, RegisterSize::Size8, false);
-    append_base_integer_type(&global_constants, u8"u16"_S, RegisterSize::Size16, false);
-    append_base_integer_type(&global_constants, u8"u32"_S, RegisterSize::Size32, false);
-    append_base_integer_type(&global_constants, u8"u64"_S, RegisterSize::Size64, false);
+            if(pooled_constant != static_constant) {
+                static_constant->index = pooled_constant->index;
 
-    append_base_integer_type(&global_constants, u8"i8"_S, RegisterSize::Size8, true);
-    append_base_integer_type(&global_constants, u8"i16"_S, RegisterSize::Size16, true);
-    append_base_integer_type(&global_constants, u8"i32"_S, RegisterSize::Size32, true);
-    append_base_integer_type(&global_constants, u8"i64"_S, RegisterSize::Size64, true);
+                continue;
+            }
+        }
 
-    append_base_integer_type(&global_constants, u8"usize"_S, architecture_sizes.address_size, false);
-    append_base_integer_type(&global_constants, u8"isize"_S, architecture_sizes.address_size, true);
+        current_static->index = runtime_statics->append(current_static);
 
-    append_base_integer_type(&global_constants, u8"uint"_S, architecture_sizes.default_integer_size, false);
-    append_base_integer_type(&global_constants, u8"int"_S, architecture_sizes.default_integer_size, true);
+        if(current_static->kind == RuntimeStaticKind::Function && !((Function*)current_static)->is_external) {
+            auto function = (Function*)current_static;
 
-    append_global_type(
-        &global_constants,
-        u8"bool"_S,
-        AnyType::create_boolean()
-    );
+            // Pushed last to first, so they are taken back off in the order they are referenced
+            for(size_t i = function->blocks.length; i != 0; i -= 1) {
+                auto block = function->blocks[i - 1];
 
-    append_global_type(
-        &global_constants,
-        u8"void"_S,
-        AnyType::create_void()
-    );
+                for(size_t j = block->instructions.length; j != 0; j -= 1) {
+                    auto instruction = block->instructions[j - 1];
 
-    append_global_type(
-        &global_constants,
-        u8"f32"_S,
-        AnyType(FloatType(RegisterSize::Size32))
-    );
+                    if(instruction->kind == InstructionKind::ReferenceStatic) {
+                        auto reference_static = (ReferenceStatic*)instruction;
 
-    append_global_type(
-        &global_constants,
-        u8"f64"_S,
-        AnyType(FloatType(RegisterSize::Size64))
-    );
+                        if(reference_static->runtime_static->index == unordered_runtime_static_index) {
+                            pending_statics->append(reference_static->runtime_static);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
 
-    append_global_type(
-        &global_constants,
-        u8"float"_S,
-        AnyType(FloatType(architecture_sizes.default_float_size))
-    );
+struct JobRunner {
+    GlobalInfo info;
+    JobList* jobs;
 
-    append_global_constant(
-        &global_constants,
-        u8"true"_S,
-        AnyType::create_boolean(),
-        AnyConstantValue(true)
-    );
+    bool print_ast;
+    bool print_ir;
+    bool print_restarts;
 
-    append_global_constant(
-        &global_constants,
-        u8"false"_S,
-        AnyType::create_boolean(),
-        AnyConstantValue(false)
-    );
+    Mutex output_mutex;
 
-    append_global_type(
-        &global_constants,
-        u8"type"_S,
-        AnyType::create_type_type()
-    );
+    // Jobs finish in whatever order the threads get to them, so statics are only given their final order once all jobs are done
+    List<GeneratedStatic> generated_statics;
+    List<String> libraries;
 
-    append_global_constant(
-        &global_constants,
-        u8"undef"_S,
-        AnyType::create_undef(),
-        AnyConstantValue::create_undef()
-    );
+    uint64_t total_parser_time;
+    uint64_t total_generator_time;
+};
 
-    append_builtin(&global_constants, u8"size_of"_S);
-    append_builtin(&global_constants, u8"type_of"_S);
+// Runs a single job and stores its results, the caller is responsible for marking it as done afterwards
+static DelayedResult<void> run_job(JobRunner* runner, size_t job_index) {
+    auto jobs = runner->jobs;
+    auto job = &(*jobs)[job_index];
 
-    append_builtin(&global_constants, u8"globalify"_S);
-    append_builtin(&global_constants, u8"stackify"_S);
+    switch(job->kind) {
+        case JobKind::ParseFile: {
+            auto parse_file = &job->parse_file;
 
-    append_builtin(&global_constants, u8"sqrt"_S);
+            auto start_time = get_timer_counts();
 
-    append_global_constant(
-        &global_constants,
-        u8"X86"_S,
-        AnyType::create_boolean(),
-        AnyConstantValue(architecture == u8"x86"_S)
-    );
+            Arena token_arena {};
 
-    append_global_constant(
-        &global_constants,
-        u8"X64"_S,
-        AnyType::create_boolean(),
-        AnyConstantValue(architecture == u8"x64"_S)
-    );
+            expect(tokens, tokenize_source(parse_file->path, &token_arena));
 
-    append_global_constant(
-        &global_constants,
-        u8"RISCV32"_S,
-        AnyType::create_boolean(),
-        AnyConstantValue(architecture == u8"riscv32"_S)
-    );
+            parse_file->ast_arena = {};
 
-    append_global_constant(
-        &global_constants,
-        u8"RISCV64"_S,
-        AnyType::create_boolean(),
-        AnyConstantValue(architecture == u8"riscv64"_S)
-    );
+            expect(statements, parse_tokens(parse_file->path, tokens, &parse_file->ast_arena));
 
-    append_global_constant(
-        &global_constants,
-        u8"WASM32"_S,
-        AnyType::create_boolean(),
-        AnyConstantValue(config == u8"wasm32"_S)
-    );
+            free_arena(&token_arena);
 
-    append_global_constant(
-        &global_constants,
-        u8"WINDOWS"_S,
-        AnyType::create_boolean(),
-        AnyConstantValue(os == u8"windows"_S)
-    );
+            auto scope = new ConstantScope;
+            scope->statements = statements;
+            scope->declarations = create_declaration_hash_table(statements);
+            scope->scope_constants = {};
+            scope->is_top_level = true;
+            scope->file_path = parse_file->path;
 
-    append_global_constant(
-        &global_constants,
-        u8"LINUX"_S,
-        AnyType::create_boolean(),
-        AnyConstantValue(os == u8"linux"_S)
-    );
+            parse_file->scope = scope;
 
-    append_global_constant(
-        &global_constants,
-        u8"EMSCRIPTEN"_S,
-        AnyType::create_boolean(),
-        AnyConstantValue(os == u8"emscripten"_S)
-    );
+            expect_void(process_scope(jobs, scope, statements, nullptr, true));
 
-    append_global_constant(
-        &global_constants,
-        u8"WASI"_S,
-        AnyType::create_boolean(),
-        AnyConstantValue(os == u8"wasi"_S)
-    );
+            auto end_time = get_timer_counts();
 
-    append_global_constant(
-        &global_constants,
-        u8"GNU"_S,
-        AnyType::create_boolean(),
-        AnyConstantValue(toolchain == u8"gnu"_S)
-    );
+            atomic_add(&runner->total_parser_time, end_time - start_time);
 
-    append_global_constant(
-        &global_constants,
-        u8"MSVC"_S,
-        AnyType::create_boolean(),
-        AnyConstantValue(toolchain == u8"msvc"_S)
-    );
+            if(runner->print_ast) {
+                lock_mutex(runner->output_mutex);
 
-    append_global_constant(
-        &global_constants,
-        u8"DEBUG"_S,
-        AnyType::create_boolean(),
-        AnyConstantValue(config == u8"debug"_S)
-    );
+                printf("%.*s:\n", STRING_PRINTF_ARGUMENTS(parse_file->path));
 
-    append_global_constant(
-        &global_constants,
-        u8"RELEASE"_S,
-        AnyType::create_boolean(),
-        AnyConstantValue(config == u8"release"_S)
-    );
+                for(auto statement : statements) {
+                    statement->print();
+                    printf("\n");
+                }
 
-    GlobalInfo info {
-        global_constants,
-        architecture_sizes
-    };
+                unlock_mutex(runner->output_mutex);
+            }
+        } break;
 
-    List<AnyJob> jobs {};
+        case JobKind::ResolveStaticIf: {
+            auto resolve_static_if = job->resolve_static_if;
 
-    size_t main_file_parse_job_index;
-    {
-        AnyJob job;
-        job.kind = JobKind::ParseFile;
-        job.state = JobState::Working;
-        job.parse_file.path = absolute_source_file_path;
+            auto start_time = get_timer_counts();
 
-        main_file_parse_job_index = jobs.append(job);
-    }
+            auto result = do_resolve_static_if(runner->info, jobs, resolve_static_if.static_if, resolve_static_if.scope);
 
-    List<RuntimeStatic*> runtime_statics {};
-    List<String> libraries {};
+            if(result.has_value) {
+                if(!result.status) {
+                    return err();
+                }
 
-    if(os == u8"windows"_S || os == u8"mingw"_S) {
-        libraries.append(u8"kernel32"_S);
-    }
+                job->resolve_static_if.condition = result.value.condition;
+                job->resolve_static_if.declarations = result.value.declarations;
+            }
 
-    auto main_function_state = JobState::Waiting;
-    auto main_function_waiting_for = main_file_parse_job_index;
-    Function* main_function;
+            auto end_time = get_timer_counts();
 
-    uint64_t total_parser_time = 0;
-    uint64_t total_generator_time = 0;
+            atomic_add(&runner->total_generator_time, end_time - start_time);
 
-    while(true) {
-        auto did_work = false;
-        for(size_t job_index = 0; job_index < jobs.length; job_index += 1) {
-            auto job = &jobs[job_index];
-
-            if(job->state != JobState::Done) {
-                if(job->state == JobState::Waiting) {
-                    if(jobs[job->waiting_for].state != JobState::Done) {
-                        continue;
+            if(!result.has_value) {
+                return wait(result.waiting_for);
+            }
+        } break;
+
+        case JobKind::ResolveFunctionDeclaration: {
+            auto resolve_function_declaration = job->resolve_function_declaration;
+
+            auto start_time = get_timer_counts();
+
+            auto result = do_resolve_function_declaration(
+                runner->info,
+                jobs,
+                resolve_function_declaration.declaration,
+                resolve_function_declaration.scope
+            );
+
+            if(result.has_value) {
+                if(!result.status) {
+                    return err();
+                }
+
+                job->resolve_function_declaration.type = result.value.type;
+                job->resolve_function_declaration.value = result.value.value;
+
+                if(job->resolve_function_declaration.type.kind == TypeKind::FunctionTypeType) {
+                    auto function_type = job->resolve_function_declaration.type.function;
+
+                    auto function_value = job->resolve_function_declaration.value.unwrap_function();
+
+                    jobs->lock();
+
+                    size_t job_index;
+                    if(!jobs->find(JobKind::GenerateFunction, function_value.declaration, function_value.body_scope, &job_index)) {
+                        AnyJob job;
+                        job.kind = JobKind::GenerateFunction;
+                        job.state = JobState::Working;
+                        job.generate_function.type = function_type;
+                        job.generate_function.value = function_value;
+                        job.generate_function.function = new Function;
+                        job.generate_function.generation_state = nullptr;
+
+                        jobs->append(job);
                     }
 
-                    job->state = JobState::Working;
+                    jobs->unlock();
                 }
+            }
 
-                switch(job->kind) {
-                    case JobKind::ParseFile: {
-                        auto parse_file = &job->parse_file;
+            auto end_time = get_timer_counts();
+
+            atomic_add(&runner->total_generator_time, end_time - start_time);
 
-                        auto start_time = get_timer_counts();
+            if(!result.has_value) {
+                return wait(result.waiting_for);
+            }
+        } break;
+
+        case JobKind::ResolvePolymorphicFunction: {
+            auto resolve_polymorphic_function = job->resolve_polymorphic_function;
+
+            auto start_time = get_timer_counts();
+
+            auto result = do_resolve_polymorphic_function(
+                runner->info,
+                jobs,
+                resolve_polymorphic_function.declaration,
+                resolve_polymorphic_function.parameters,
+                resolve_polymorphic_function.scope,
+                resolve_polymorphic_function.call_scope,
+                resolve_polymorphic_function.call_parameter_ranges
+            );
+
+            if(result.has_value) {
+                if(!result.status) {
+                    return err();
+                }
 
-                        expect(tokens, tokenize_source(parse_file->path));
+                job->resolve_polymorphic_function.type = result.value.type;
+                job->resolve_polymorphic_function.value = result.value.value;
+            }
 
-                        expect(statements, parse_tokens(parse_file->path, tokens));
+            auto end_time = get_timer_counts();
 
-                        auto scope = new ConstantScope;
-                        scope->statements = statements;
-                        scope->declarations = create_declaration_hash_table(statements);
-                        scope->scope_constants = {};
-                        scope->is_top_level = true;
-                        scope->file_path = parse_file->path;
+            atomic_add(&runner->total_generator_time, end_time - start_time);
 
-                        parse_file->scope = scope;
-                        job->state = JobState::Done;
+            if(!result.has_value) {
+                return wait(result.waiting_for);
+            }
+        } break;
 
-                        expect_void(process_scope(&jobs, scope, statements, nullptr, true));
+        case JobKind::ResolveConstantDefinition: {
+            auto resolve_constant_definition = job->resolve_constant_definition;
 
-                        auto end_time = get_timer_counts();
+            auto start_time = get_timer_counts();
 
-                        total_parser_time += end_time - start_time;
+            auto result = evaluate_constant_expression(
+                runner->info,
+                jobs,
+                resolve_constant_definition.scope,
+                nullptr,
+                resolve_constant_definition.definition->expression
+            );
 
-                        auto job_after = jobs[job_index];
+            if(result.has_value) {
+                if(!result.status) {
+                    return err();
+                }
 
-                        if(print_ast) {
-                            printf("%.*s:\n", STRING_PRINTF_ARGUMENTS(job_after.parse_file.path));
+                job->resolve_constant_definition.type = result.value.type;
+                job->resolve_constant_definition.value = result.value.value;
+            }
 
-                            for(auto statement : statements) {
-                                statement->print();
-                                printf("\n");
-                            }
-                        }
-                    } break;
+            auto end_time = get_timer_counts();
 
-                    case JobKind::ResolveStaticIf: {
-                        auto resolve_static_if = job->resolve_static_if;
+            atomic_add(&runner->total_generator_time, end_time - start_time);
 
-                        auto start_time = get_timer_counts();
+            if(!result.has_value) {
+                return wait(result.waiting_for);
+            }
+        } break;
 
-                        auto result = do_resolve_static_if(info, &jobs, resolve_static_if.static_if, resolve_static_if.scope);
+        case JobKind::ResolveStructDefinition: {
+            auto resolve_struct_definition = job->resolve_struct_definition;
 
-                        auto job_after = &jobs[job_index];
+            auto start_time = get_timer_counts();
 
-                        if(result.has_value) {
-                            if(!result.status) {
-                                return err();
-                            }
+            auto result = do_resolve_struct_definition(
+                runner->info,
+                jobs,
+                resolve_struct_definition.definition,
+                resolve_struct_definition.scope
+            );
 
-                            job_after->state = JobState::Done;
-                            job_after->resolve_static_if.condition = result.value.condition;
-                            job_after->resolve_static_if.declarations = result.value.declarations;
-                        } else {
-                            job_after->state = JobState::Waiting;
-                            job_after->waiting_for = result.waiting_for;
-                        }
+            if(result.has_value) {
+                if(!result.status) {
+                    return err();
+                }
 
-                        auto end_time = get_timer_counts();
+                job->resolve_struct_definition.type = result.value;
+            }
 
-                        total_generator_time += end_time - start_time;
-                    } break;
+            auto end_time = get_timer_counts();
 
-                    case JobKind::ResolveFunctionDeclaration: {
-                        auto resolve_function_declaration = job->resolve_function_declaration;
+            atomic_add(&runner->total_generator_time, end_time - start_time);
 
-                        auto start_time = get_timer_counts();
+            if(!result.has_value) {
+                return wait(result.waiting_for);
+            }
+        } break;
 
-                        auto result = do_resolve_function_declaration(
-                            info,
-                            &jobs,
-                            resolve_function_declaration.declaration,
-                            resolve_function_declaration.scope
-                        );
+        case JobKind::ResolvePolymorphicStruct: {
+            auto resolve_polymorphic_struct = job->resolve_polymorphic_struct;
 
-                        auto job_after = &jobs[job_index];
+            auto start_time = get_timer_counts();
 
-                        if(result.has_value) {
-                            if(!result.status) {
-                                return err();
-                            }
+            auto result = do_resolve_polymorphic_struct(
+                runner->info,
+                jobs,
+                resolve_polymorphic_struct.definition,
+                resolve_polymorphic_struct.parameters,
+                resolve_polymorphic_struct.scope
+            );
 
-                            job_after->state = JobState::Done;
-                            job_after->resolve_function_declaration.type = result.value.type;
-                            job_after->resolve_function_declaration.value = result.value.value;
-
-                            if(job_after->resolve_function_declaration.type.kind == TypeKind::FunctionTypeType) {
-                                auto function_type = job_after->resolve_function_declaration.type.function;
-
-                                auto function_value = job_after->resolve_function_declaration.value.unwrap_function();
-
-                                auto found = false;
-                                for(auto job : jobs) {
-                                    if(job.kind == JobKind::GenerateFunction) {
-                                        auto generate_function = job.generate_function;
-
-                                        if(
-                                            generate_function.value.declaration == function_value.declaration &&
-                                            generate_function.value.body_scope == function_value.body_scope
-                                        ) {
-                                            found = true;
-                                            break;
-                                        }
-                                    }
-                                }
-
-                                if(!found) {
-                                    AnyJob job;
-                                    job.kind = JobKind::GenerateFunction;
-                                    job.state = JobState::Working;
-                                    job.generate_function.type = function_type;
-                                    job.generate_function.value = function_value;
-                                    job.generate_function.function = new Function;
-
-                                    jobs.append(job);
-                                }
-                            }
-                        } else {
-                            job_after->state = JobState::Waiting;
-                            job_after->waiting_for = result.waiting_for;
-                        }
+            if(result.has_value) {
+                if(!result.status) {
+                    return err();
+                }
 
-                        auto end_time = get_timer_counts();
+                job->resolve_polymorphic_struct.type = result.value;
+            }
 
-                        total_generator_time += end_time - start_time;
-                    } break;
+            auto end_time = get_timer_counts();
 
-                    case JobKind::ResolvePolymorphicFunction: {
-                        auto resolve_polymorphic_function = job->resolve_polymorphic_function;
+            atomic_add(&runner->total_generator_time, end_time - start_time);
 
-                        auto start_time = get_timer_counts();
+            if(!result.has_value) {
+                return wait(result.waiting_for);
+            }
+        } break;
 
-                        auto result = do_resolve_polymorphic_function(
-                            info,
-                            &jobs,
-                            resolve_polymorphic_function.declaration,
-                            resolve_polymorphic_function.parameters,
-                            resolve_polymorphic_function.scope,
-                            resolve_polymorphic_function.call_scope,
-                            resolve_polymorphic_function.call_parameter_ranges
-                        );
+        case JobKind::ResolveUnionDefinition: {
+            auto resolve_union_definition = job->resolve_union_definition;
 
-                        auto job_after = &jobs[job_index];
+            auto start_time = get_timer_counts();
 
-                        if(result.has_value) {
-                            if(!result.status) {
-                                return err();
-                            }
+            auto result = do_resolve_union_definition(
+                runner->info,
+                jobs,
+                resolve_union_definition.definition,
+                resolve_union_definition.scope
+            );
 
-                            job_after->state = JobState::Done;
-                            job_after->resolve_polymorphic_function.type = result.value.type;
-                            job_after->resolve_polymorphic_function.value = result.value.value;
-                        } else {
-                            job_after->state = JobState::Waiting;
-                            job_after->waiting_for = result.waiting_for;
-                        }
+            if(result.has_value) {
+                if(!result.status) {
+                    return err();
+                }
 
-                        auto end_time = get_timer_counts();
+                job->resolve_union_definition.type = result.value;
+            }
 
-                        total_generator_time += end_time - start_time;
-                    } break;
+            auto end_time = get_timer_counts();
 
-                    case JobKind::ResolveConstantDefinition: {
-                        auto resolve_constant_definition = job->resolve_constant_definition;
+            atomic_add(&runner->total_generator_time, end_time - start_time);
 
-                        auto start_time = get_timer_counts();
+            if(!result.has_value) {
+                return wait(result.waiting_for);
+            }
+        } break;
 
-                        auto result = evaluate_constant_expression(
-                            info,
-                            &jobs,
-                            resolve_constant_definition.scope,
-                            nullptr,
-                            resolve_constant_definition.definition->expression
-                        );
+        case JobKind::ResolvePolymorphicUnion: {
+            auto resolve_polymorphic_union = job->resolve_polymorphic_union;
 
-                        auto job_after = &jobs[job_index];
+            auto start_time = get_timer_counts();
 
-                        if(result.has_value) {
-                            if(!result.status) {
-                                return err();
-                            }
+            auto result = do_resolve_polymorphic_union(
+                runner->info,
+                jobs,
+                resolve_polymorphic_union.definition,
+                resolve_polymorphic_union.parameters,
+                resolve_polymorphic_union.scope
+            );
 
-                            job_after->state = JobState::Done;
-                            job_after->resolve_constant_definition.type = result.value.type;
-                            job_after->resolve_constant_definition.value = result.value.value;
-                        } else {
-                            job_after->state = JobState::Waiting;
-                            job_after->waiting_for = result.waiting_for;
-                        }
+            if(result.has_value) {
+                if(!result.status) {
+                    return err();
+                }
 
-                        auto end_time = get_timer_counts();
+                job->resolve_polymorphic_union.type = result.value;
+            }
 
-                        total_generator_time += end_time - start_time;
-                    } break;
+            auto end_time = get_timer_counts();
 
-                    case JobKind::ResolveStructDefinition: {
-                        auto resolve_struct_definition = job->resolve_struct_definition;
+            atomic_add(&runner->total_generator_time, end_time - start_time);
+
+            if(!result.has_value) {
+                return wait(result.waiting_for);
+            }
+        } break;
 
-                        auto start_time = get_timer_counts();
+        case JobKind::ResolveEnumDefinition: {
+            auto resolve_enum_definition = job->resolve_enum_definition;
 
-                        auto result = do_resolve_struct_definition(
-                            info,
-                            &jobs,
-                            resolve_struct_definition.definition,
-                            resolve_struct_definition.scope
-                        );
+            auto start_time = get_timer_counts();
 
-                        auto job_after = &jobs[job_index];
+            auto result = do_resolve_enum_definition(
+                runner->info,
+                jobs,
+                resolve_enum_definition.definition,
+                resolve_enum_definition.scope
+            );
 
-                        if(result.has_value) {
-                            if(!result.status) {
-                                return err();
-                            }
+            if(result.has_value) {
+                if(!result.status) {
+                    return err();
+                }
 
-                            job_after->state = JobState::Done;
-                            job_after->resolve_struct_definition.type = result.value;
-                        } else {
-                            job_after->state = JobState::Waiting;
-                            job_after->waiting_for = result.waiting_for;
-                        }
+                job->resolve_enum_definition.type = result.value;
+            }
 
-                        auto end_time = get_timer_counts();
+            auto end_time = get_timer_counts();
 
-                        total_generator_time += end_time - start_time;
-                    } break;
+            atomic_add(&runner->total_generator_time, end_time - start_time);
 
-                    case JobKind::ResolvePolymorphicStruct: {
-                        auto resolve_polymorphic_struct = job->resolve_polymorphic_struct;
+            if(!result.has_value) {
+                return wait(result.waiting_for);
+            }
+        } break;
 
-                        auto start_time = get_timer_counts();
+        case JobKind::GenerateFunction: {
+            auto generate_function = job->generate_function;
 
-                        auto result = do_resolve_polymorphic_struct(
-                            info,
-                            &jobs,
-                            resolve_polymorphic_struct.definition,
-                            resolve_polymorphic_struct.parameters,
-                            resolve_polymorphic_struct.scope
-                        );
+            auto start_time = get_timer_counts();
 
-                        auto job_after = &jobs[job_index];
+            auto result = do_generate_function(
+                runner->info,
+                jobs,
+                generate_function.type,
+                generate_function.value,
+                generate_function.function,
+                &job->generate_function.generation_state
+            );
 
-                        if(result.has_value) {
-                            if(!result.status) {
-                                return err();
+            if(result.has_value) {
+                if(!result.status) {
+                    return err();
+                }
+
+                lock_mutex(runner->output_mutex);
+
+                append_generated_static(
+                    &runner->generated_statics,
+                    job_index,
+                    job->generate_function.value.body_scope,
+                    job->generate_function.function
+                );
+
+                if(job->generate_function.function->is_external) {
+                    for(auto library : job->generate_function.function->libraries) {
+                        auto already_registered = false;
+                        for(auto registered_library : runner->libraries) {
+                            if(registered_library == library) {
+                                already_registered = true;
+                                break;
                             }
+                        }
 
-                            job_after->state = JobState::Done;
-                            job_after->resolve_polymorphic_struct.type = result.value;
-                        } else {
-                            job_after->state = JobState::Waiting;
-                            job_after->waiting_for = result.waiting_for;
+                        if(!already_registered) {
+                            runner->libraries.append(library);
                         }
+                    }
+                }
 
-                        auto end_time = get_timer_counts();
+                for(auto static_constant : result.value) {
+                    static_constant->index = unordered_runtime_static_index;
+                }
 
-                        total_generator_time += end_time - start_time;
-                    } break;
+                unlock_mutex(runner->output_mutex);
+            }
 
-                    case JobKind::ResolveUnionDefinition: {
-                        auto resolve_union_definition = job->resolve_union_definition;
+            auto end_time = get_timer_counts();
 
-                        auto start_time = get_timer_counts();
+            atomic_add(&runner->total_generator_time, end_time - start_time);
 
-                        auto result = do_resolve_union_definition(
-                            info,
-                            &jobs,
-                            resolve_union_definition.definition,
-                            resolve_union_definition.scope
-                        );
+            if(!result.has_value) {
+                return wait(result.waiting_for);
+            }
 
-                        auto job_after = &jobs[job_index];
+            if(runner->print_ir) {
+                lock_mutex(runner->output_mutex);
 
-                        if(result.has_value) {
-                            if(!result.status) {
-                                return err();
-                            }
+                printf("%.*s:\n", STRING_PRINTF_ARGUMENTS(job->generate_function.function->path));
+                job->generate_function.function->print();
+                printf("\n");
 
-                            job_after->state = JobState::Done;
-                            job_after->resolve_union_definition.type = result.value;
-                        } else {
-                            job_after->state = JobState::Waiting;
-                            job_after->waiting_for = result.waiting_for;
-                        }
+                unlock_mutex(runner->output_mutex);
+            }
 
-                        auto end_time = get_timer_counts();
+            if(runner->print_restarts) {
+                lock_mutex(runner->output_mutex);
 
-                        total_generator_time += end_time - start_time;
-                    } break;
+                printf(
+                    "%.*s: %zu restarts\n",
+                    STRING_PRINTF_ARGUMENTS(job->generate_function.function->name),
+                    get_generation_restart_count(job->generate_function.generation_state)
+                );
 
-                    case JobKind::ResolvePolymorphicUnion: {
-                        auto resolve_polymorphic_union = job->resolve_polymorphic_union;
+                unlock_mutex(runner->output_mutex);
+            }
+        } break;
+
+        case JobKind::GenerateStaticVariable: {
+            auto generate_static_variable = job->generate_static_variable;
+
+            auto start_time = get_timer_counts();
+
+            auto result = do_generate_static_variable(
+                runner->info,
+                jobs,
+                generate_static_variable.declaration,
+                generate_static_variable.scope
+            );
 
-                        auto start_time = get_timer_counts();
+            if(result.has_value) {
+                if(!result.status) {
+                    return err();
+                }
+
+                job->generate_static_variable.static_variable = result.value.static_variable;
+                job->generate_static_variable.type = result.value.type;
 
-                        auto result = do_resolve_polymorphic_union(
-                            info,
-                            &jobs,
-                            resolve_polymorphic_union.definition,
-                            resolve_polymorphic_union.parameters,
-                            resolve_polymorphic_union.scope
-                        );
+                lock_mutex(runner->output_mutex);
 
-                        auto job_after = &jobs[job_index];
+                append_generated_static(&runner->generated_statics, job_index, generate_static_variable.scope, result.value.static_variable);
 
-                        if(result.has_value) {
-                            if(!result.status) {
-                                return err();
+                if(job->generate_static_variable.static_variable->is_external) {
+                    for(auto library : job->generate_static_variable.static_variable->libraries) {
+                        auto already_registered = false;
+                        for(auto registered_library : runner->libraries) {
+                            if(registered_library == library) {
+                                already_registered = true;
+                                break;
                             }
+                        }
 
-                            job_after->state = JobState::Done;
-                            job_after->resolve_polymorphic_union.type = result.value;
-                        } else {
-                            job_after->state = JobState::Waiting;
-                            job_after->waiting_for = result.waiting_for;
+                        if(!already_registered) {
+                            runner->libraries.append(library);
                         }
+                    }
+                }
+
+                unlock_mutex(runner->output_mutex);
+            }
+
+            auto end_time = get_timer_counts();
+
+            atomic_add(&runner->total_generator_time, end_time - start_time);
+
+            if(!result.has_value) {
+                return wait(result.waiting_for);
+            }
+
+            if(runner->print_ir) {
+                lock_mutex(runner->output_mutex);
+
+                printf("%.*s:\n", STRING_PRINTF_ARGUMENTS(get_scope_file_path(*job->generate_static_variable.scope)));
+                result.value.static_variable->print();
+                printf("\n");
+
+                unlock_mutex(runner->output_mutex);
+            }
+        } break;
+
+        default: abort();
+    }
+
+    return ok();
+}
+
+static DelayedResult<Function*> find_main_function(JobRunner* runner, ConstantScope* scope) {
+    auto jobs = runner->jobs;
+
+    auto name_hash = calculate_string_hash(u8"main"_S);
+
+    expect_delayed(search_value, search_for_name(
+        runner->info,
+        jobs,
+        intern_symbol(u8"main"_S, name_hash),
+        name_hash,
+        scope,
+        scope->statements,
+        &scope->declarations,
+        false,
+        nullptr
+    ));
+
+    if(!search_value.found) {
+        fprintf(stderr, "Error: Cannot find 'main'\n");
+
+        return err();
+    }
+
+    if(search_value.type.kind != TypeKind::FunctionTypeType) {
+        fprintf(stderr, "Error: 'main' must be a function. Got '%.*s'\n", STRING_PRINTF_ARGUMENTS(search_value.type.get_description()));
+
+        return err();
+    }
+
+    auto function_type = search_value.type.function;
+
+    auto function_value = search_value.value.unwrap_function();
+
+    if(function_type.parameters.length != 0) {
+        error(scope, function_value.declaration->range, "'main' must have zero parameters");
+
+        return err();
+    }
+
+    auto expected_main_return_integer = AnyType(Integer(RegisterSize::Size32, true));
+
+    if(function_type.return_types.length != 1) {
+        error(
+            scope,
+            function_value.declaration->range,
+            "Incorrect number of return types for 'main'. Expected 1, got %zu",
+            function_type.return_types.length
+        );
+
+        return err();
+    }
+
+    if(function_type.return_types[0] != expected_main_return_integer) {
+        error(
+            scope,
+            function_value.declaration->range,
+            "Incorrect 'main' return type. Expected '%.*s', got '%.*s'",
+            STRING_PRINTF_ARGUMENTS(expected_main_return_integer.get_description()),
+            STRING_PRINTF_ARGUMENTS(function_type.return_types[0].get_description())
+        );
+
+        return err();
+    }
+
+    size_t job_index;
+    if(!jobs->find(JobKind::GenerateFunction, function_value.declaration, function_value.body_scope, &job_index)) {
+        abort();
+    }
+
+    return ok((*jobs)[job_index].generate_function.function);
+}
+
+struct WorkerQueue {
+    Mutex mutex;
+
+    List<size_t> jobs;
+    size_t first_job;
+};
+
+struct JobExecutor {
+    JobRunner* runner;
 
-                        auto end_time = get_timer_counts();
+    Array<WorkerQueue> queues;
+
+    Mutex mutex;
+    ConditionVariable condition_variable;
+
+    size_t scheduled_job_count;
+
+    size_t active_worker_count;
+
+    bool finished;
+    bool failed;
+};
+
+struct Worker {
+    JobExecutor* executor;
+
+    size_t index;
+};
+
+static void push_queued_job(WorkerQueue* queue, size_t job_index) {
+    lock_mutex(queue->mutex);
+
+    queue->jobs.append(job_index);
+
+    unlock_mutex(queue->mutex);
+}
+
+// A worker takes the newest job from its own queue, and steals the oldest job from other queues
+static bool take_queued_job(WorkerQueue* queue, bool steal, size_t* job_index) {
+    lock_mutex(queue->mutex);
+
+    auto found = false;
+    if(queue->first_job != queue->jobs.length) {
+        found = true;
+
+        if(steal) {
+            *job_index = queue->jobs[queue->first_job];
+
+            queue->first_job += 1;
+        } else {
+            *job_index = queue->jobs.take_last();
+        }
+
+        if(queue->first_job == queue->jobs.length) {
+            queue->jobs.length = 0;
+            queue->first_job = 0;
+        }
+    }
+
+    unlock_mutex(queue->mutex);
+
+    return found;
+}
+
+static bool find_queued_job(JobExecutor* executor, size_t worker_index, size_t* job_index) {
+    if(take_queued_job(&executor->queues[worker_index], false, job_index)) {
+        return true;
+    }
+
+    for(size_t i = 1; i < executor->queues.length; i += 1) {
+        auto queue_index = (worker_index + i) % executor->queues.length;
+
+        if(take_queued_job(&executor->queues[queue_index], true, job_index)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Must be called with the executor mutex held
+static void queue_new_jobs(JobExecutor* executor, WorkerQueue* queue) {
+    auto jobs = executor->runner->jobs;
+
+    while(executor->scheduled_job_count < jobs->get_length()) {
+        (*jobs)[executor->scheduled_job_count].waiters = {};
+
+        push_queued_job(queue, executor->scheduled_job_count);
+
+        executor->scheduled_job_count += 1;
+    }
+}
+
+static bool wait_for_job(JobExecutor* executor, size_t worker_index, size_t* job_index) {
+    while(true) {
+        if(atomic_load(&executor->failed)) {
+            return false;
+        }
+
+        if(find_queued_job(executor, worker_index, job_index)) {
+            return true;
+        }
+
+        lock_mutex(executor->mutex);
+
+        // Jobs are only queued with the executor mutex held, so none can be missed between this search and going to sleep
+        if(find_queued_job(executor, worker_index, job_index)) {
+            unlock_mutex(executor->mutex);
+
+            return true;
+        }
+
+        executor->active_worker_count -= 1;
+
+        if(executor->active_worker_count == 0) {
+            executor->finished = true;
+
+            wake_all_condition_variable(executor->condition_variable);
+        } else {
+            wait_condition_variable(executor->condition_variable, executor->mutex);
+        }
+
+        if(executor->finished || executor->failed) {
+            unlock_mutex(executor->mutex);
+
+            return false;
+        }
+
+        executor->active_worker_count += 1;
+
+        unlock_mutex(executor->mutex);
+    }
+}
+
+static void finish_job(JobExecutor* executor, size_t worker_index, size_t job_index, DelayedResult<void> result) {
+    auto jobs = executor->runner->jobs;
+    auto queue = &executor->queues[worker_index];
+
+    lock_mutex(executor->mutex);
+
+    queue_new_jobs(executor, queue);
+
+    auto job = &(*jobs)[job_index];
+
+    if(result.has_value) {
+        set_job_state(job, JobState::Done);
+
+        for(auto waiter : job->waiters) {
+            push_queued_job(queue, waiter);
+        }
+
+        job->waiters = {};
+    } else {
+        auto waiting_for = &(*jobs)[result.waiting_for];
+
+        if(get_job_state(waiting_for) == JobState::Done) {
+            push_queued_job(queue, job_index);
+        } else {
+            set_job_state(job, JobState::Waiting);
+            job->waiting_for = result.waiting_for;
+
+            waiting_for->waiters.append(job_index);
+        }
+    }
+
+    wake_all_condition_variable(executor->condition_variable);
+
+    unlock_mutex(executor->mutex);
+}
+
+static void run_worker(void* data) {
+    auto worker = (Worker*)data;
+    auto executor = worker->executor;
+    auto jobs = executor->runner->jobs;
+
+    size_t job_index;
+    while(wait_for_job(executor, worker->index, &job_index)) {
+        set_job_state(&(*jobs)[job_index], JobState::Working);
+
+        auto result = run_job(executor->runner, job_index);
+
+        if(result.has_value && !result.status) {
+            lock_mutex(executor->mutex);
+
+            atomic_store(&executor->failed, true);
+
+            wake_all_condition_variable(executor->condition_variable);
+
+            unlock_mutex(executor->mutex);
+
+            return;
+        }
+
+        finish_job(executor, worker->index, job_index, result);
+    }
+}
+
+// Runs jobs on every worker until none are left runnable, the calling thread acts as the first worker
+static Result<void> run_jobs_in_parallel(JobExecutor* executor) {
+    auto worker_count = executor->queues.length;
+
+    lock_mutex(executor->mutex);
+
+    queue_new_jobs(executor, &executor->queues[0]);
+
+    executor->active_worker_count = worker_count;
+    executor->finished = false;
+
+    unlock_mutex(executor->mutex);
+
+    auto workers = allocate<Worker>(worker_count);
+    auto threads = allocate<Thread>(worker_count);
+
+    for(size_t i = 0; i < worker_count; i += 1) {
+        workers[i].executor = executor;
+        workers[i].index = i;
+    }
+
+    for(size_t i = 1; i < worker_count; i += 1) {
+        threads[i] = create_thread(run_worker, &workers[i]);
+    }
+
+    run_worker(&workers[0]);
+
+    for(size_t i = 1; i < worker_count; i += 1) {
+        join_thread(threads[i]);
+    }
+
+    free(workers);
+    free(threads);
+
+    if(executor->failed) {
+        return err();
+    }
+
+    return ok();
+}
+
+static Result<uint32_t> calculate_file_hash(String path) {
+    auto file = fopen(path.to_c_string(), "rb");
+
+    if(file == nullptr) {
+        fprintf(stderr, "Error: Unable to read file at '%.*s'\n", STRING_PRINTF_ARGUMENTS(path));
+
+        return err();
+    }
+
+    fseek(file, 0, SEEK_END);
+
+    auto signed_length = ftell(file);
+
+    if(signed_length == -1) {
+        fprintf(stderr, "Error: Unable to determine length of file at '%.*s'\n", STRING_PRINTF_ARGUMENTS(path));
+
+        fclose(file);
+
+        return err();
+    }
+
+    fseek(file, 0, SEEK_SET);
+
+    String contents {};
+    contents.length = (size_t)signed_length;
+    contents.elements = allocate<char8_t>(contents.length);
+
+    if(contents.length != 0 && fread(contents.elements, contents.length, 1, file) != 1) {
+        fprintf(stderr, "Error: Unable to read file at '%.*s'\n", STRING_PRINTF_ARGUMENTS(path));
+
+        fclose(file);
+
+        return err();
+    }
+
+    fclose(file);
+
+    auto hash = calculate_string_hash(contents);
+
+    free(contents.elements);
+
+    return ok(hash);
+}
+
+static_profiled_function(Result<void>, cli_entry, (Array<const char*> arguments), (arguments)) {
+    auto start_time = get_timer_counts();
+
+    bool has_source_file_path = false;
+    String source_file_path;
+    bool has_output_file_path = false;
+    String output_file_path;
+
+    auto architecture = get_host_architecture();
+
+    auto os = get_host_os();
+
+    auto has_toolchain = false;
+    String toolchain;
+
+    auto config = u8"debug"_S;
+
+    auto has_optimization_level = false;
+    String optimization_level;
+
+    size_t job_thread_count = 1;
+
+    auto no_link = false;
+    auto print_ast = false;
+    auto print_ir = false;
+    auto print_restarts = false;
+    auto print_llvm = false;
+
+    int argument_index = 1;
+    while(argument_index < arguments.length) {
+        auto argument = arguments[argument_index];
+
+        if(argument_index == arguments.length - 1 && argument[0] != '-') {
+            has_source_file_path = true;
+
+            auto result = String::from_c_string(argument);
+            if(!result.status) {
+                fprintf(stderr, "Error: Invalid source file path '%s'\n", argument);
+
+                return err();
+            }
+
+            source_file_path = result.value;
+        } else if(strcmp(argument, "-output") == 0) {
+            argument_index += 1;
+
+            if(argument_index == arguments.length - 1) {
+                fprintf(stderr, "Error: Missing value for '-output' option\n\n");
+                print_help_message(stderr);
+
+                return err();
+            }
+
+            has_output_file_path = true;
+
+            auto result = String::from_c_string(arguments[argument_index]);
+            if(!result.status) {
+                fprintf(stderr, "Error: Invalid output file path '%s'\n", arguments[argument_index]);
+
+                return err();
+            }
+
+            output_file_path = result.value;
+        } else if(strcmp(argument, "-arch") == 0) {
+            argument_index += 1;
+
+            if(argument_index == arguments.length - 1) {
+                fprintf(stderr, "Error: Missing value for '-arch' option\n\n");
+                print_help_message(stderr);
+
+                return err();
+            }
+
+            auto result = String::from_c_string(arguments[argument_index]);
+            if(!result.status) {
+                fprintf(stderr, "Error: '%s' is not a valid '-arch' option value\n\n", arguments[argument_index]);
+                print_help_message(stderr);
+
+                return err();
+            }
+
+            architecture = result.value;
+        } else if(strcmp(argument, "-os") == 0) {
+            argument_index += 1;
+
+            if(argument_index == arguments.length - 1) {
+                fprintf(stderr, "Error: Missing value for '-os' option\n\n");
+                print_help_message(stderr);
+
+                return err();
+            }
+
+            auto result = String::from_c_string(arguments[argument_index]);
+            if(!result.status) {
+                fprintf(stderr, "Error: '%s' is not a valid '-os' option value\n\n", arguments[argument_index]);
+                print_help_message(stderr);
+
+                return err();
+            }
+
+            os = result.value;
+        } else if(strcmp(argument, "-toolchain") == 0) {
+            has_toolchain = true;
+
+            argument_index += 1;
+
+            if(argument_index == arguments.length - 1) {
+                fprintf(stderr, "Error: Missing value for '-toolchain' option\n\n");
+                print_help_message(stderr);
+
+                return err();
+            }
+
+            auto result = String::from_c_string(arguments[argument_index]);
+            if(!result.status) {
+                fprintf(stderr, "Error: '%s' is not a valid '-toolchain' option value\n\n", arguments[argument_index]);
+                print_help_message(stderr);
+
+                return err();
+            }
+
+            toolchain = result.value;
+        } else if(strcmp(argument, "-config") == 0) {
+            argument_index += 1;
+
+            if(argument_index == arguments.length - 1) {
+                fprintf(stderr, "Error: Missing value for '-config' option\n\n");
+                print_help_message(stderr);
+
+                return err();
+            }
+
+            auto result = String::from_c_string(arguments[argument_index]);
+            if(!result.status) {
+                fprintf(stderr, "Error: '%s' is not a valid '-config' option value\n\n", arguments[argument_index]);
+                print_help_message(stderr);
+
+                return err();
+            }
+
+            config = result.value;
+        } else if(strcmp(argument, "-opt") == 0) {
+            argument_index += 1;
+
+            if(argument_index == arguments.length - 1) {
+                fprintf(stderr, "Error: Missing value for '-opt' option\n\n");
+                print_help_message(stderr);
+
+                return err();
+            }
+
+            auto result = String::from_c_string(arguments[argument_index]);
+            if(
+                !result.status ||
+                (
+                    result.value != u8"0"_S &&
+                    result.value != u8"1"_S &&
+                    result.value != u8"2"_S &&
+                    result.value != u8"3"_S &&
+                    result.value != u8"s"_S &&
+                    result.value != u8"z"_S
+                )
+            ) {
+                fprintf(stderr, "Error: '%s' is not a valid '-opt' option value\n\n", arguments[argument_index]);
+                print_help_message(stderr);
+
+                return err();
+            }
+
+            has_optimization_level = true;
+            optimization_level = result.value;
+        } else if(strcmp(argument, "-jobs") == 0) {
+            argument_index += 1;
+
+            if(argument_index == arguments.length - 1) {
+                fprintf(stderr, "Error: Missing value for '-jobs' option\n\n");
+                print_help_message(stderr);
+
+                return err();
+            }
+
+            char* end;
+            auto count = strtoull(arguments[argument_index], &end, 10);
+            if(*arguments[argument_index] == '\0' || *end != '\0') {
+                fprintf(stderr, "Error: '%s' is not a valid '-jobs' option value\n\n", arguments[argument_index]);
+                print_help_message(stderr);
+
+                return err();
+            }
+
+            if(count == 0) {
+                job_thread_count = get_processor_count();
+            } else {
+                job_thread_count = (size_t)count;
+            }
+        } else if(strcmp(argument, "-no-link") == 0) {
+            no_link = true;
+        } else if(strcmp(argument, "-print-ast") == 0) {
+            print_ast = true;
+        } else if(strcmp(argument, "-print-ir") == 0) {
+            print_ir = true;
+        } else if(strcmp(argument, "-print-llvm") == 0) {
+            print_llvm = true;
+        } else if(strcmp(argument, "-print-restarts") == 0) {
+            print_restarts = true;
+        } else if(strcmp(argument, "-help") == 0) {
+            print_help_message(stdout);
+
+            return ok();
+        } else {
+            fprintf(stderr, "Error: Unknown option '%s'\n\n", argument);
+            print_help_message(stderr);
+
+            return err();
+        }
+
+        argument_index += 1;
+    }
+
+#if defined(PROFILING)
+    // The profiler records into a single buffer, so it can only follow one thread
+    job_thread_count = 1;
+#endif
+
+    if(
+        config == u8"debug"_S &&
+        config == u8"release"_S
+    ) {
+        fprintf(stderr, "Error: Unknown config '%.*s'\n\n", STRING_PRINTF_ARGUMENTS(config));
+        print_help_message(stderr);
+
+        return err();
+    }
+
+    if(!has_optimization_level) {
+        if(config == u8"release"_S) {
+            optimization_level = u8"2"_S;
+        } else {
+            optimization_level = u8"0"_S;
+        }
+    }
+
+    if(!does_os_exist(os)) {
+        fprintf(stderr, "Error: Unknown OS '%.*s'\n\n", STRING_PRINTF_ARGUMENTS(os));
+        print_help_message(stderr);
+
+        return err();
+    }
+
+    if(!does_architecture_exist(architecture)) {
+        fprintf(stderr, "Error: Unknown architecture '%.*s'\n\n", STRING_PRINTF_ARGUMENTS(architecture));
+        print_help_message(stderr);
+
+        return err();
+    }
+
+    if(has_toolchain) {
+        if(!does_toolchain_exist(toolchain)) {
+            fprintf(stderr, "Error: Unknown toolchain '%.*s'\n\n", STRING_PRINTF_ARGUMENTS(toolchain));
+            print_help_message(stderr);
+
+            return err();
+        }
+    } else {
+        toolchain = get_default_toolchain(os);
+    }
+
+    if(!is_supported_target(os, architecture, toolchain)) {
+        fprintf(
+            stderr,
+            "Error: '%.*s', '%.*s', and '%.*s' is not a supported OS, architecture, and toolchain combination\n\n",
+            STRING_PRINTF_ARGUMENTS(os),
+            STRING_PRINTF_ARGUMENTS(architecture),
+            STRING_PRINTF_ARGUMENTS(toolchain)
+        );
+        print_help_message(stderr);
+
+        return err();
+    }
+
+    if(!has_source_file_path) {
+        fprintf(stderr, "Error: No source file provided\n\n");
+        print_help_message(stderr);
+
+        return err();
+    }
+
+    expect(absolute_source_file_path, path_relative_to_absolute(source_file_path));
+
+    if(!has_output_file_path) {
+        output_file_path = get_default_output_file(os, no_link);
+    }
+
+    auto architecture_sizes = get_architecture_sizes(architecture);
+
+    List<GlobalConstant> global_constants {};
+
+    append_base_integer_type(&global_constants, u8"u8"_S, RegisterSize::Size8, false);
+    append_base_integer_type(&global_constants, u8"u16"_S, RegisterSize::Size16, false);
+    append_base_integer_type(&global_constants, u8"u32"_S, RegisterSize::Size32, false);
+    append_base_integer_type(&global_constants, u8"u64"_S, RegisterSize::Size64, false);
+
+    append_base_integer_type(&global_constants, u8"i8"_S, RegisterSize::Size8, true);
+    append_base_integer_type(&global_constants, u8"i16"_S, RegisterSize::Size16, true);
+    append_base_integer_type(&global_constants, u8"i32"_S, RegisterSize::Size32, true);
+    append_base_integer_type(&global_constants, u8"i64"_S, RegisterSize::Size64, true);
+
+    append_base_integer_type(&global_constants, u8"usize"_S, architecture_sizes.address_size, false);
+    append_base_integer_type(&global_constants, u8"isize"_S, architecture_sizes.address_size, true);
+
+    append_base_integer_type(&global_constants, u8"uint"_S, architecture_sizes.default_integer_size, false);
+    append_base_integer_type(&global_constants, u8"int"_S, architecture_sizes.default_integer_size, true);
+
+    append_global_type(
+        &global_constants,
+        u8"bool"_S,
+        AnyType::create_boolean()
+    );
+
+    append_global_type(
+        &global_constants,
+        u8"void"_S,
+        AnyType::create_void()
+    );
+
+    append_global_type(
+        &global_constants,
+        u8"f32"_S,
+        AnyType(FloatType(RegisterSize::Size32))
+    );
+
+    append_global_type(
+        &global_constants,
+        u8"f64"_S,
+        AnyType(FloatType(RegisterSize::Size64))
+    );
 
-                        total_generator_time += end_time - start_time;
-                    } break;
+    append_global_type(
+        &global_constants,
+        u8"float"_S,
+        AnyType(FloatType(architecture_sizes.default_float_size))
+    );
 
-                    case JobKind::ResolveEnumDefinition: {
-                        auto resolve_enum_definition = job->resolve_enum_definition;
+    append_global_constant(
+        &global_constants,
+        u8"true"_S,
+        AnyType::create_boolean(),
+        AnyConstantValue(true)
+    );
 
-                        auto start_time = get_timer_counts();
+    append_global_constant(
+        &global_constants,
+        u8"false"_S,
+        AnyType::create_boolean(),
+        AnyConstantValue(false)
+    );
 
-                        auto result = do_resolve_enum_definition(
-                            info,
-                            &jobs,
-                            resolve_enum_definition.definition,
-                            resolve_enum_definition.scope
-                        );
+    append_global_type(
+        &global_constants,
+        u8"type"_S,
+        AnyType::create_type_type()
+    );
 
-                        auto job_after = &jobs[job_index];
+    append_global_constant(
+        &global_constants,
+        u8"undef"_S,
+        AnyType::create_undef(),
+        AnyConstantValue::create_undef()
+    );
 
-                        if(result.has_value) {
-                            if(!result.status) {
-                                return err();
-                            }
+    append_builtin(&global_constants, u8"size_of"_S);
+    append_builtin(&global_constants, u8"type_of"_S);
 
-                            job_after->state = JobState::Done;
-                            job_after->resolve_enum_definition.type = result.value;
-                        } else {
-                            job_after->state = JobState::Waiting;
-                            job_after->waiting_for = result.waiting_for;
-                        }
+    append_builtin(&global_constants, u8"globalify"_S);
+    append_builtin(&global_constants, u8"stackify"_S);
 
-                        auto end_time = get_timer_counts();
+    append_builtin(&global_constants, u8"sqrt"_S);
 
-                        total_generator_time += end_time - start_time;
-                    } break;
+    append_global_constant(
+        &global_constants,
+        u8"X86"_S,
+        AnyType::create_boolean(),
+        AnyConstantValue(architecture == u8"x86"_S)
+    );
 
-                    case JobKind::GenerateFunction: {
-                        auto generate_function = job->generate_function;
+    append_global_constant(
+        &global_constants,
+        u8"X64"_S,
+        AnyType::create_boolean(),
+        AnyConstantValue(architecture == u8"x64"_S)
+    );
 
-                        auto start_time = get_timer_counts();
+    append_global_constant(
+        &global_constants,
+        u8"RISCV32"_S,
+        AnyType::create_boolean(),
+        AnyConstantValue(architecture == u8"riscv32"_S)
+    );
 
-                        auto result = do_generate_function(
-                            info,
-                            &jobs,
-                            generate_function.type,
-                            generate_function.value,
-                            generate_function.function
-                        );
+    append_global_constant(
+        &global_constants,
+        u8"RISCV64"_S,
+        AnyType::create_boolean(),
+        AnyConstantValue(architecture == u8"riscv64"_S)
+    );
 
-                        auto job_after = &jobs[job_index];
+    append_global_constant(
+        &global_constants,
+        u8"WASM32"_S,
+        AnyType::create_boolean(),
+        AnyConstantValue(config == u8"wasm32"_S)
+    );
 
-                        if(result.has_value) {
-                            if(!result.status) {
-                                return err();
-                            }
+    append_global_constant(
+        &global_constants,
+        u8"WINDOWS"_S,
+        AnyType::create_boolean(),
+        AnyConstantValue(os == u8"windows"_S)
+    );
 
-                            job_after->state = JobState::Done;
+    append_global_constant(
+        &global_constants,
+        u8"LINUX"_S,
+        AnyType::create_boolean(),
+        AnyConstantValue(os == u8"linux"_S)
+    );
 
-                            runtime_statics.append(job_after->generate_function.function);
+    append_global_constant(
+        &global_constants,
+        u8"EMSCRIPTEN"_S,
+        AnyType::create_boolean(),
+        AnyConstantValue(os == u8"emscripten"_S)
+    );
 
-                            if(job_after->generate_function.function->is_external) {
-                                for(auto library : job_after->generate_function.function->libraries) {
-                                    auto already_registered = false;
-                                    for(auto registered_library : libraries) {
-                                        if(registered_library == library) {
-                                            already_registered = true;
-                                            break;
-                                        }
-                                    }
+    append_global_constant(
+        &global_constants,
+        u8"WASI"_S,
+        AnyType::create_boolean(),
+        AnyConstantValue(os == u8"wasi"_S)
+    );
 
-                                    if(!already_registered) {
-                                        libraries.append(library);
-                                    }
-                                }
-                            }
+    append_global_constant(
+        &global_constants,
+        u8"GNU"_S,
+        AnyType::create_boolean(),
+        AnyConstantValue(toolchain == u8"gnu"_S)
+    );
 
-                            for(auto static_constant : result.value) {
-                                runtime_statics.append(static_constant);
-                            }
-                        } else {
-                            job_after->state = JobState::Waiting;
-                            job_after->waiting_for = result.waiting_for;
-                        }
+    append_global_constant(
+        &global_constants,
+        u8"MSVC"_S,
+        AnyType::create_boolean(),
+        AnyConstantValue(toolchain == u8"msvc"_S)
+    );
 
-                        auto end_time = get_timer_counts();
+    append_global_constant(
+        &global_constants,
+        u8"DEBUG"_S,
+        AnyType::create_boolean(),
+        AnyConstantValue(config == u8"debug"_S)
+    );
 
-                        total_generator_time += end_time - start_time;
+    append_global_constant(
+        &global_constants,
+        u8"RELEASE"_S,
+        AnyType::create_boolean(),
+        AnyConstantValue(config == u8"release"_S)
+    );
 
-                        if(job_after->state == JobState::Done && print_ir) {
-                            printf("%.*s:\n", STRING_PRINTF_ARGUMENTS(job_after->generate_function.function->path));
-                            job_after->generate_function.function->print();
-                            printf("\n");
-                        }
-                    } break;
+    GlobalInfo info {
+        global_constants,
+        architecture_sizes
+    };
 
-                    case JobKind::GenerateStaticVariable: {
-                        auto generate_static_variable = job->generate_static_variable;
+    auto jobs = create_job_list();
 
-                        auto start_time = get_timer_counts();
+    size_t main_file_parse_job_index;
+    {
+        AnyJob job;
+        job.kind = JobKind::ParseFile;
+        job.state = JobState::Working;
+        job.parse_file.path = absolute_source_file_path;
 
-                        auto result = do_generate_static_variable(
-                            info,
-                            &jobs,
-                            generate_static_variable.declaration,
-                            generate_static_variable.scope
-                        );
+        main_file_parse_job_index = jobs.append(job);
+    }
 
-                        auto job_after = &jobs[job_index];
+    JobRunner runner {};
+    runner.info = info;
+    runner.jobs = &jobs;
+    runner.print_ast = print_ast;
+    runner.print_ir = print_ir;
+    runner.print_restarts = print_restarts;
+    runner.output_mutex = create_mutex();
 
-                        if(result.has_value) {
-                            if(!result.status) {
-                                return err();
-                            }
+    if(os == u8"windows"_S || os == u8"mingw"_S) {
+        runner.libraries.append(u8"kernel32"_S);
+    }
 
-                            job_after->state = JobState::Done;
-                            job_after->generate_static_variable.static_variable = result.value.static_variable;
-                            job_after->generate_static_variable.type = result.value.type;
-
-                            runtime_statics.append((RuntimeStatic*)result.value.static_variable);
-
-                            if(job_after->generate_static_variable.static_variable->is_external) {
-                                for(auto library : job_after->generate_static_variable.static_variable->libraries) {
-                                    auto already_registered = false;
-                                    for(auto registered_library : libraries) {
-                                        if(registered_library == library) {
-                                            already_registered = true;
-                                            break;
-                                        }
-                                    }
-
-                                    if(!already_registered) {
-                                        libraries.append(library);
-                                    }
-                                }
-                            }
-                        } else {
-                            job_after->state = JobState::Waiting;
-                            job_after->waiting_for = result.waiting_for;
-                        }
+    auto main_function_state = JobState::Waiting;
+    auto main_function_waiting_for = main_file_parse_job_index;
+    Function* main_function;
 
-                        auto end_time = get_timer_counts();
+    if(job_thread_count == 1) {
+        List<size_t> ready_jobs {};
+        size_t scheduled_job_count = 0;
 
-                        total_generator_time += end_time - start_time;
+        while(true) {
+            schedule_new_jobs(&jobs, &ready_jobs, &scheduled_job_count);
 
-                        if(job_after->state == JobState::Done &&print_ir) {
-                            printf("%.*s:\n", STRING_PRINTF_ARGUMENTS(get_scope_file_path(*job_after->generate_static_variable.scope)));
-                            result.value.static_variable->print();
-                            printf("\n");
-                        }
-                    } break;
+            auto did_work = false;
+            if(ready_jobs.length != 0) {
+                auto job_index = take_ready_job(&ready_jobs);
+                auto job = &jobs[job_index];
 
-                    default: abort();
-                }
+                set_job_state(job, JobState::Working);
 
-                did_work = true;
-                break;
-            }
-        }
+                auto result = run_job(&runner, job_index);
 
-        if(main_function_state != JobState::Done) {
-            if(main_function_state == JobState::Waiting) {
-                if(jobs[main_function_waiting_for].state == JobState::Done) {
-                    main_function_state = JobState::Working;
+                if(result.has_value && !result.status) {
+                    return err();
                 }
-            }
 
-            if(main_function_state == JobState::Working) {
-                auto scope = jobs[main_file_parse_job_index].parse_file.scope;
+                schedule_new_jobs(&jobs, &ready_jobs, &scheduled_job_count);
 
-                did_work = true;
-
-                auto result = search_for_name(
-                    info,
-                    &jobs,
-                    u8"main"_S,
-                    calculate_string_hash(u8"main"_S),
-                    scope,
-                    scope->statements,
-                    scope->declarations,
-                    false,
-                    nullptr
-                );
+                if(result.has_value) {
+                    set_job_state(job, JobState::Done);
 
-                if(!result.has_value) {
-                    main_function_state = JobState::Waiting;
-                    main_function_waiting_for = result.waiting_for;
-                } else {
-                    if(!result.status) {
-                        return err();
+                    for(auto waiter : job->waiters) {
+                        push_ready_job(&ready_jobs, waiter);
                     }
 
-                    main_function_state = JobState::Done;
+                    job->waiters = {};
+                } else {
+                    auto waiting_for = &jobs[result.waiting_for];
 
-                    if(!result.value.found) {
-                        fprintf(stderr, "Error: Cannot find 'main'\n");
+                    if(get_job_state(waiting_for) == JobState::Done) {
+                        push_ready_job(&ready_jobs, job_index);
+                    } else {
+                        set_job_state(job, JobState::Waiting);
+                        job->waiting_for = result.waiting_for;
 
-                        return err();
+                        waiting_for->waiters.append(job_index);
                     }
+                }
 
-                    if(result.value.type.kind != TypeKind::FunctionTypeType) {
-                        fprintf(stderr, "Error: 'main' must be a function. Got '%.*s'\n", STRING_PRINTF_ARGUMENTS(result.value.type.get_description()));
+                did_work = true;
+            }
 
-                        return err();
+            if(main_function_state != JobState::Done) {
+                if(main_function_state == JobState::Waiting) {
+                    if(get_job_state(&jobs[main_function_waiting_for]) == JobState::Done) {
+                        main_function_state = JobState::Working;
                     }
+                }
+
+                if(main_function_state == JobState::Working) {
+                    auto scope = jobs[main_file_parse_job_index].parse_file.scope;
 
-                    auto function_type = result.value.type.function;
+                    did_work = true;
 
-                    auto function_value = result.value.value.unwrap_function();
+                    auto result = find_main_function(&runner, scope);
 
-                    if(function_type.parameters.length != 0) {
-                        error(scope, function_value.declaration->range, "'main' must have zero parameters");
+                    if(!result.has_value) {
+                        main_function_state = JobState::Waiting;
+                        main_function_waiting_for = result.waiting_for;
+                    } else {
+                        if(!result.status) {
+                            return err();
+                        }
 
-                        return err();
+                        main_function_state = JobState::Done;
+                        main_function = result.value;
                     }
+                }
+            }
 
-                    auto expected_main_return_integer = AnyType(Integer(RegisterSize::Size32, true));
+            if(!did_work) {
+                break;
+            }
+        }
+    } else {
+        JobExecutor executor {};
+        executor.runner = &runner;
+        executor.mutex = create_mutex();
+        executor.condition_variable = create_condition_variable();
 
-                    if(function_type.return_types.length != 1) {
-                        error(
-                            scope,
-                            function_value.declaration->range,
-                            "Incorrect number of return types for 'main'. Expected 1, got %zu",
-                            function_type.return_types.length
-                        );
+        executor.queues.length = job_thread_count;
+        executor.queues.elements = allocate<WorkerQueue>(job_thread_count);
 
-                        return err();
-                    }
+        for(size_t i = 0; i < job_thread_count; i += 1) {
+            executor.queues[i] = {};
+            executor.queues[i].mutex = create_mutex();
+        }
 
-                    if(function_type.return_types[0] != expected_main_return_integer) {
-                        error(
-                            scope,
-                            function_value.declaration->range,
-                            "Incorrect 'main' return type. Expected '%.*s', got '%.*s'",
-                            STRING_PRINTF_ARGUMENTS(expected_main_return_integer.get_description()),
-                            STRING_PRINTF_ARGUMENTS(function_type.return_types[0].get_description())
-                        );
+        // Looking up 'main' can itself add jobs, so keep alternating between the two until neither makes progress
+        while(true) {
+            expect_void(run_jobs_in_parallel(&executor));
 
-                        return err();
-                    }
+            if(main_function_state == JobState::Done) {
+                break;
+            }
 
-                    auto found = false;
-                    for(auto job : jobs) {
-                        if(job.kind == JobKind::GenerateFunction) {
-                            auto generate_function = job.generate_function;
+            if(get_job_state(&jobs[main_function_waiting_for]) != JobState::Done) {
+                break;
+            }
 
-                            if(
-                                AnyType(generate_function.type) == AnyType(function_type) &&
-                                generate_function.value.declaration == function_value.declaration &&
-                                generate_function.value.body_scope == function_value.body_scope
-                            ) {
-                                found = true;
+            auto scope = jobs[main_file_parse_job_index].parse_file.scope;
 
-                                main_function = generate_function.function;
+            auto result = find_main_function(&runner, scope);
 
-                                break;
-                            }
-                        }
-                    }
-                    assert(found);
+            if(!result.has_value) {
+                main_function_waiting_for = result.waiting_for;
+            } else {
+                if(!result.status) {
+                    return err();
                 }
-            }
-        }
 
-        if(!did_work) {
-            break;
+                main_function_state = JobState::Done;
+                main_function = result.value;
+            }
         }
     }
 
     auto all_jobs_done = true;
-    for(auto job : jobs) {
-        if(job.state != JobState::Done) {
+    for(size_t i = 0; i < jobs.get_length(); i += 1) {
+        if(get_job_state(&jobs[i]) != JobState::Done) {
             all_jobs_done = false;
         }
     }
@@ -1120,7 +1877,9 @@ static_profiled_function(Result<void>, cli_entry, (Array<const char*> arguments)
         fprintf(stderr, "Error: Circular dependency detected!\n");
         fprintf(stderr, "Error: The following areas depend on eathother:\n");
 
-        for(auto job : jobs) {
+        for(size_t i = 0; i < jobs.get_length(); i += 1) {
+            auto job = jobs[i];
+
             if(job.state != JobState::Done) {
                 ConstantScope* scope;
                 FileRange range;
@@ -1209,11 +1968,32 @@ static_profiled_function(Result<void>, cli_entry, (Array<const char*> arguments)
         return err();
     }
 
+    // Jobs run in a different order for each thread count, so statics are ordered by where they are first referenced instead,
+    // starting from 'main' then going through the rest in source order, to give the same output for any number of threads.
+    // Static constants that no instruction references, left behind by a restarted function, are never emitted.
+    qsort(
+        runner.generated_statics.elements,
+        runner.generated_statics.length,
+        sizeof(GeneratedStatic),
+        compare_generated_statics
+    );
+
+    List<RuntimeStatic*> runtime_statics {};
+    StaticConstantPool static_constant_pool {};
+    List<RuntimeStatic*> pending_statics {};
+
+    order_runtime_static(&runtime_statics, &static_constant_pool, &pending_statics, main_function);
+
+    for(auto generated_static : runner.generated_statics) {
+        order_runtime_static(&runtime_statics, &static_constant_pool, &pending_statics, generated_static.runtime_static);
+    }
+
     expect(output_file_directory, path_get_directory_component(output_file_path));
 
-    String object_file_path;
+    // Code generation is split into up to one object file per job thread, unless a single object file was asked for
+    List<String> object_file_paths {};
     if(no_link) {
-        object_file_path = output_file_path;
+        object_file_paths.append(output_file_path);
     } else {
         expect(full_name, path_get_file_component(output_file_path));
 
@@ -1242,13 +2022,21 @@ static_profiled_function(Result<void>, cli_entry, (Array<const char*> arguments)
             }
         }
 
-        StringBuffer buffer {};
+        for(size_t i = 0; i < job_thread_count; i += 1) {
+            StringBuffer buffer {};
+
+            buffer.append(output_file_directory);
+            buffer.append(output_file_name);
+
+            if(job_thread_count != 1) {
+                buffer.append(u8"_"_S);
+                buffer.append_integer(i);
+            }
 
-        buffer.append(output_file_directory);
-        buffer.append(output_file_name);
-        buffer.append(u8".o"_S);
+            buffer.append(u8".o"_S);
 
-        object_file_path = buffer;
+            object_file_paths.append(buffer);
+        }
     }
 
     uint64_t backend_time;
@@ -1271,20 +2059,24 @@ static_profiled_function(Result<void>, cli_entry, (Array<const char*> arguments)
 
         auto start_time = get_timer_counts();
 
-        expect(name_mappings, generate_llvm_object(
+        expect(object_result, generate_llvm_object(
             source_file_path,
             runtime_statics,
             architecture,
             os,
             toolchain,
             config,
-            object_file_path,
+            optimization_level,
+            object_file_paths,
             reserved_names,
             print_llvm
         ));
 
+        // Only link the object files the backend actually split the code between
+        object_file_paths.length = object_result.object_file_paths.length;
+
         auto main_found = false;
-        for(auto name_mapping : name_mappings) {
+        for(auto name_mapping : object_result.name_mappings) {
             if(name_mapping.runtime_static == main_function) {
                 main_function_name = name_mapping.name;
                 main_found = true;
@@ -1294,6 +2086,14 @@ static_profiled_function(Result<void>, cli_entry, (Array<const char*> arguments)
         }
         assert(main_found);
 
+        for(size_t i = 0; i < jobs.get_length(); i += 1) {
+            auto job = &jobs[i];
+
+            if(job->kind == JobKind::GenerateFunction) {
+                free_generated_function(job->generate_function.generation_state);
+            }
+        }
+
         auto end_time = get_timer_counts();
 
         backend_time = end_time - start_time;
@@ -1360,7 +2160,7 @@ static_profiled_function(Result<void>, cli_entry, (Array<const char*> arguments)
         command_buffer.append(u8" -o"_S);
         command_buffer.append(output_file_path);
         
-        for(auto library : libraries) {
+        for(auto library : runner.libraries) {
             command_buffer.append(u8" -l"_S);
             command_buffer.append(library);
         }
@@ -1369,8 +2169,10 @@ static_profiled_function(Result<void>, cli_entry, (Array<const char*> arguments)
             command_buffer.append(u8" -lcompiler_rt"_S);
         }
 
-        command_buffer.append(u8" "_S);
-        command_buffer.append(object_file_path);
+        for(auto object_file_path : object_file_paths) {
+            command_buffer.append(u8" "_S);
+            command_buffer.append(object_file_path);
+        }
 
         expect(executable_path, get_executable_path());
         expect(executable_directory, path_get_directory_component(executable_path));
@@ -1416,6 +2218,8 @@ static_profiled_function(Result<void>, cli_entry, (Array<const char*> arguments)
 
         if(!found_runtime_source) {
             fprintf(stderr, "Error: Unable to locate runtime source file\n");
+
+            return err();
         }
 
         StringBuffer runtime_command_buffer {};
@@ -1430,34 +2234,137 @@ static_profiled_function(Result<void>, cli_entry, (Array<const char*> arguments)
 
         runtime_command_buffer.append(u8" -DMAIN="_S);
         runtime_command_buffer.append(main_function_name);
-        
-        runtime_command_buffer.append(u8" -o "_S);
-        runtime_command_buffer.append(output_file_directory);
-        runtime_command_buffer.append(u8"runtime.o "_S);
 
+        runtime_command_buffer.append(u8" "_S);
         runtime_command_buffer.append(runtime_source_path);
 
-        enter_region("clang");
-        if(system(runtime_command_buffer.to_c_string()) != 0) {
-            fprintf(stderr, "Error: 'clang' returned non-zero while compiling runtime\n");
+        // The runtime object only depends on the command that compiles it, the clang that runs it and the runtime source,
+        // so it's cached by all three. The clang binary is identified by its path and file status, so a cache hit doesn't need
+        // to start any process.
+        StringBuffer runtime_object_path {};
+        auto runtime_object_cacheable = false;
+        auto runtime_object_cached = false;
 
-            return err();
+        auto cache_directory_result = get_cache_directory();
+
+        Result<String> clang_path_result {};
+        Result<uint64_t> clang_identity_hash_result {};
+        if(cache_directory_result.status) {
+            clang_path_result = find_executable(u8"clang"_S);
+
+            if(clang_path_result.status) {
+                clang_identity_hash_result = get_file_identity_hash(clang_path_result.value);
+            }
+        }
+
+        if(cache_directory_result.status && clang_path_result.status && clang_identity_hash_result.status) {
+            expect(runtime_source_hash, calculate_file_hash(runtime_source_path));
+
+            auto runtime_hash = combine_hash(calculate_string_hash(runtime_command_buffer), runtime_source_hash);
+            runtime_hash = combine_hash(runtime_hash, calculate_string_hash(clang_path_result.value));
+            runtime_hash = combine_hash(runtime_hash, clang_identity_hash_result.value);
+
+            runtime_object_cacheable = true;
+
+            runtime_object_path.append(cache_directory_result.value);
+            runtime_object_path.append(u8"runtime_"_S);
+            runtime_object_path.append(os);
+            runtime_object_path.append(u8"_"_S);
+            runtime_object_path.append(architecture);
+            runtime_object_path.append(u8"_"_S);
+            runtime_object_path.append_integer(runtime_hash);
+            runtime_object_path.append(u8".o"_S);
+
+            auto file_test = fopen(runtime_object_path.to_c_string(), "rb");
+
+            if(file_test != nullptr) {
+                fclose(file_test);
+
+                runtime_object_cached = true;
+            }
+        } else {
+            runtime_object_path.append(output_file_directory);
+            runtime_object_path.append(u8"runtime.o"_S);
+        }
+
+        if(!runtime_object_cached) {
+            // A cached object is compiled under a name only this process uses then renamed into place, so a build that is
+            // killed part way through, or another build compiling the same object, never leaves a partial object at the key
+            StringBuffer runtime_output_path {};
+            runtime_output_path.append(runtime_object_path);
+
+            if(runtime_object_cacheable) {
+                runtime_output_path.append(u8"."_S);
+                runtime_output_path.append_integer(get_process_id());
+                runtime_output_path.append(u8".tmp"_S);
+            }
+
+            runtime_command_buffer.append(u8" -o "_S);
+            runtime_command_buffer.append(runtime_output_path);
+
+            enter_region("clang");
+            if(system(runtime_command_buffer.to_c_string()) != 0) {
+                fprintf(stderr, "Error: 'clang' returned non-zero while compiling runtime\n");
+
+                remove(runtime_output_path.to_c_string());
+
+                return err();
+            }
+            leave_region();
+
+            if(runtime_object_cacheable && rename(runtime_output_path.to_c_string(), runtime_object_path.to_c_string()) != 0) {
+                remove(runtime_output_path.to_c_string());
+
+                // Renaming onto an existing file fails on Windows, which is fine when another build just put the same object there
+                auto file_test = fopen(runtime_object_path.to_c_string(), "rb");
+
+                if(file_test == nullptr) {
+                    fprintf(stderr, "Error: Unable to move compiled runtime to '%.*s'\n", STRING_PRINTF_ARGUMENTS(runtime_object_path));
+
+                    return err();
+                }
+
+                fclose(file_test);
+            }
         }
-        leave_region();
 
         command_buffer.append(u8" "_S);
-        command_buffer.append(output_file_directory);
-        command_buffer.append(u8"runtime.o"_S);
+        command_buffer.append(runtime_object_path);
 
-        enter_region("linker");
+        auto linked_in_process = false;
+#if defined(IN_PROCESS_LINKER)
+        if(os != u8"emscripten"_S) {
+            object_file_paths.append(runtime_object_path);
 
-        if(system(command_buffer.to_c_string()) != 0) {
-            fprintf(stderr, "Error: '%.*s' returned non-zero while linking\n", STRING_PRINTF_ARGUMENTS(frontend));
+            enter_region("linker");
 
-            return err();
+            expect_void(link_in_process(
+                os,
+                architecture,
+                toolchain,
+                config,
+                output_file_path,
+                object_file_paths,
+                runner.libraries
+            ));
+
+            leave_region();
+
+            linked_in_process = true;
         }
+#endif
+
+        if(!linked_in_process) {
+            enter_region("linker");
+
+            if(system(command_buffer.to_c_string()) != 0) {
+                fprintf(stderr, "Error: '%.*s' returned non-zero while linking\n", STRING_PRINTF_ARGUMENTS(frontend));
 
-        leave_region();
+                return err();
+            }
+
+            leave_region();
+        }
 
         auto end_time = get_timer_counts();
 
@@ -1471,8 +2378,8 @@ static_profiled_function(Result<void>, cli_entry, (Array<const char*> arguments)
     auto counts_per_second = get_timer_counts_per_second();
 
     printf("Total time: %.2fms\n", (double)total_time / counts_per_second * 1000);
-    printf("  Parser time: %.2fms\n", (double)total_parser_time / counts_per_second * 1000);
-    printf("  Generator time: %.2fms\n", (double)total_generator_time / counts_per_second * 1000);
+    printf("  Parser time: %.2fms\n", (double)runner.total_parser_time / counts_per_second * 1000);
+    printf("  Generator time: %.2fms\n", (double)runner.total_generator_time / counts_per_second * 1000);
     printf("  LLVM Backend time: %.2fms\n", (double)backend_time / counts_per_second * 1000);
     if(!no_link) {
         printf("  Linker time: %.2fms\n", (double)linker_time / counts_per_second * 1000);
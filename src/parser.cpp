@@ -8,6 +8,7 @@
 #include "list.h"
 #include "tokens.h"
 #include "util.h"
+#include "arena.h"
 
 inline FileRange token_range(Token token) {
     FileRange range {};
@@ -29,8 +30,8 @@ inline FileRange span_range(FileRange first, FileRange last) {
     return range;
 }
 
-inline Expression* named_reference_from_identifier(Identifier identifier) {
-    return new NamedReference(
+inline Expression* named_reference_from_identifier(Arena* arena, Identifier identifier) {
+    return new(arena) NamedReference(
         identifier.range,
         identifier
     );
@@ -55,6 +56,8 @@ namespace {
     struct Parser {
         String path;
 
+        Arena* arena;
+
         Array<Token> tokens;
 
         size_t next_token_index;
@@ -137,6 +140,7 @@ namespace {
         inline Identifier identifier_from_token(Token token) {
             Identifier identifier {};
             identifier.text = token.identifier;
+            identifier.hash = token.identifier_hash;
             identifier.range = token_range(token);
 
             return identifier;
@@ -169,13 +173,13 @@ namespace {
 
                     auto identifier = identifier_from_token(token);
 
-                    left_expression = named_reference_from_identifier(identifier);
+                    left_expression = named_reference_from_identifier(arena, identifier);
                 } break;
 
                 case TokenKind::Integer: {
                     consume_token();
 
-                    left_expression = new IntegerLiteral(
+                    left_expression = new(arena) IntegerLiteral(
                         token_range(token),
                         token.integer
                     );
@@ -184,7 +188,7 @@ namespace {
                 case TokenKind::FloatingPoint: {
                     consume_token();
 
-                    left_expression = new FloatLiteral(
+                    left_expression = new(arena) FloatLiteral(
                         token_range(token),
                         token.floating_point
                     );
@@ -195,7 +199,7 @@ namespace {
 
                     expect(expression, parse_expression(OperatorPrecedence::PrefixUnary));
 
-                    left_expression = new UnaryOperation(
+                    left_expression = new(arena) UnaryOperation(
                         span_range(token_range(token), expression->range),
                         UnaryOperation::Operator::Pointer,
                         expression
@@ -207,7 +211,7 @@ namespace {
 
                     expect(expression, parse_expression(OperatorPrecedence::PrefixUnary));
 
-                    left_expression = new UnaryOperation(
+                    left_expression = new(arena) UnaryOperation(
                         span_range(token_range(token), expression->range),
                         UnaryOperation::Operator::PointerDereference,
                         expression
@@ -230,7 +234,7 @@ namespace {
 
                         auto function_call = (FunctionCall*)expression;
 
-                        left_expression = new Bake(
+                        left_expression = new(arena) Bake(
                             span_range(token_range(token), function_call->range),
                             function_call
                         );
@@ -246,7 +250,7 @@ namespace {
 
                     expect(expression, parse_expression(OperatorPrecedence::PrefixUnary));
 
-                    left_expression = new UnaryOperation(
+                    left_expression = new(arena) UnaryOperation(
                         span_range(token_range(token), expression->range),
                         UnaryOperation::Operator::BooleanInvert,
                         expression
@@ -258,7 +262,7 @@ namespace {
 
                     expect(expression, parse_expression(OperatorPrecedence::PrefixUnary));
 
-                    left_expression = new UnaryOperation(
+                    left_expression = new(arena) UnaryOperation(
                         span_range(token_range(token), expression->range),
                         UnaryOperation::Operator::Negation,
                         expression
@@ -268,7 +272,7 @@ namespace {
                 case TokenKind::String: {
                     consume_token();
 
-                    left_expression = new StringLiteral(
+                    left_expression = new(arena) StringLiteral(
                         token_range(token),
                         token.string
                     );
@@ -400,7 +404,7 @@ namespace {
 
                             expect(tags, parse_tags());
 
-                            left_expression = new FunctionType(
+                            left_expression = new(arena) FunctionType(
                                 span_range(first_range, last_range),
                                 parameters,
                                 return_types,
@@ -451,7 +455,7 @@ namespace {
 
                             expect(tags, parse_tags());
 
-                            left_expression = new FunctionType(
+                            left_expression = new(arena) FunctionType(
                                 span_range(first_range, last_range),
                                 Array<FunctionParameter>::empty(),
                                 return_types,
@@ -580,14 +584,14 @@ namespace {
 
                                 expect(tags, parse_tags());
 
-                                left_expression = new FunctionType(
+                                left_expression = new(arena) FunctionType(
                                     span_range(first_range, last_range),
                                     parameters,
                                     return_types,
                                     tags
                                 );
                             } else {
-                                auto expression = named_reference_from_identifier(identifier);
+                                auto expression = named_reference_from_identifier(arena, identifier);
 
                                 expect(right_expression, parse_expression_continuation(OperatorPrecedence::None, expression));
 
@@ -618,7 +622,7 @@ namespace {
                         case TokenKind::CloseCurlyBracket: {
                             consume_token();
 
-                            left_expression = new ArrayLiteral(
+                            left_expression = new(arena) ArrayLiteral(
                                 span_range(first_range, token_range(token)),
                                 {}
                             );
@@ -707,7 +711,7 @@ namespace {
                                         } break;
                                     }
 
-                                    left_expression = new StructLiteral(
+                                    left_expression = new(arena) StructLiteral(
                                         span_range(first_range, last_range),
                                         members
                                     );
@@ -716,16 +720,16 @@ namespace {
                                 case TokenKind::CloseCurlyBracket: {
                                     consume_token();
 
-                                    auto first_element = named_reference_from_identifier(identifier);
+                                    auto first_element = named_reference_from_identifier(arena, identifier);
 
-                                    left_expression = new ArrayLiteral(
+                                    left_expression = new(arena) ArrayLiteral(
                                         span_range(first_range, token_range(token)),
-                                        Array(1, heapify(first_element))
+                                        Array(1, heapify(arena, first_element))
                                     );
                                 } break;
 
                                 default: {
-                                    auto sub_expression = named_reference_from_identifier(identifier);
+                                    auto sub_expression = named_reference_from_identifier(arena, identifier);
 
                                     expect(right_expression, parse_expression_continuation(OperatorPrecedence::None, sub_expression));
 
@@ -787,7 +791,7 @@ namespace {
                                         }
                                     }
 
-                                    left_expression = new ArrayLiteral(
+                                    left_expression = new(arena) ArrayLiteral(
                                         span_range(first_range, last_range),
                                         elements
                                     );
@@ -850,7 +854,7 @@ namespace {
                                 } break;
                             }
 
-                            left_expression = new ArrayLiteral(
+                            left_expression = new(arena) ArrayLiteral(
                                 span_range(first_range, last_range),
                                 elements
                             );
@@ -881,7 +885,7 @@ namespace {
 
                     expect(expression, parse_expression(OperatorPrecedence::PrefixUnary));
 
-                    left_expression = new ArrayType(
+                    left_expression = new(arena) ArrayType(
                         span_range(token_range(token), expression->range),
                         expression,
                         index
@@ -926,7 +930,7 @@ namespace {
 
                         expect(identifier, expect_identifier());
 
-                        current_expression = new MemberReference(
+                        current_expression = new(arena) MemberReference(
                             span_range(current_expression->range, identifier.range),
                             current_expression,
                             identifier
@@ -944,7 +948,7 @@ namespace {
 
                         expect(expression, parse_expression(OperatorPrecedence::Additive));
 
-                        current_expression = new BinaryOperation(
+                        current_expression = new(arena) BinaryOperation(
                             span_range(current_expression->range, expression->range),
                             BinaryOperation::Operator::Addition,
                             current_expression,
@@ -963,7 +967,7 @@ namespace {
 
                         expect(expression, parse_expression(OperatorPrecedence::Additive));
 
-                        current_expression = new BinaryOperation(
+                        current_expression = new(arena) BinaryOperation(
                             span_range(current_expression->range, expression->range),
                             BinaryOperation::Operator::Subtraction,
                             current_expression,
@@ -982,7 +986,7 @@ namespace {
 
                         expect(expression, parse_expression(OperatorPrecedence::Multiplicitive));
 
-                        current_expression = new BinaryOperation(
+                        current_expression = new(arena) BinaryOperation(
                             span_range(current_expression->range, expression->range),
                             BinaryOperation::Operator::Multiplication,
                             current_expression,
@@ -1001,7 +1005,7 @@ namespace {
 
                         expect(expression, parse_expression(OperatorPrecedence::Multiplicitive));
 
-                        current_expression = new BinaryOperation(
+                        current_expression = new(arena) BinaryOperation(
                             span_range(current_expression->range, expression->range),
                             BinaryOperation::Operator::Division,
                             current_expression,
@@ -1020,7 +1024,7 @@ namespace {
 
                         expect(expression, parse_expression(OperatorPrecedence::Multiplicitive));
 
-                        current_expression = new BinaryOperation(
+                        current_expression = new(arena) BinaryOperation(
                             span_range(current_expression->range, expression->range),
                             BinaryOperation::Operator::Modulo,
                             current_expression,
@@ -1039,7 +1043,7 @@ namespace {
 
                         expect(expression, parse_expression(OperatorPrecedence::BitwiseAnd));
 
-                        current_expression = new BinaryOperation(
+                        current_expression = new(arena) BinaryOperation(
                             span_range(current_expression->range, expression->range),
                             BinaryOperation::Operator::BitwiseAnd,
                             current_expression,
@@ -1058,7 +1062,7 @@ namespace {
 
                         expect(expression, parse_expression(OperatorPrecedence::BooleanAnd));
 
-                        current_expression = new BinaryOperation(
+                        current_expression = new(arena) BinaryOperation(
                             span_range(current_expression->range, expression->range),
                             BinaryOperation::Operator::BooleanAnd,
                             current_expression,
@@ -1077,7 +1081,7 @@ namespace {
 
                         expect(expression, parse_expression(OperatorPrecedence::BitwiseOr));
 
-                        current_expression = new BinaryOperation(
+                        current_expression = new(arena) BinaryOperation(
                             span_range(current_expression->range, expression->range),
                             BinaryOperation::Operator::BitwiseOr,
                             current_expression,
@@ -1096,7 +1100,7 @@ namespace {
 
                         expect(expression, parse_expression(OperatorPrecedence::BooleanOr));
 
-                        current_expression = new BinaryOperation(
+                        current_expression = new(arena) BinaryOperation(
                             span_range(current_expression->range, expression->range),
                             BinaryOperation::Operator::BooleanOr,
                             current_expression,
@@ -1115,7 +1119,7 @@ namespace {
 
                         expect(expression, parse_expression(OperatorPrecedence::Comparison));
 
-                        current_expression = new BinaryOperation(
+                        current_expression = new(arena) BinaryOperation(
                             span_range(current_expression->range, expression->range),
                             BinaryOperation::Operator::Equal,
                             current_expression,
@@ -1134,7 +1138,7 @@ namespace {
 
                         expect(expression, parse_expression(OperatorPrecedence::Comparison));
 
-                        current_expression = new BinaryOperation(
+                        current_expression = new(arena) BinaryOperation(
                             span_range(current_expression->range, expression->range),
                             BinaryOperation::Operator::NotEqual,
                             current_expression,
@@ -1153,7 +1157,7 @@ namespace {
 
                         expect(expression, parse_expression(OperatorPrecedence::Comparison));
 
-                        current_expression = new BinaryOperation(
+                        current_expression = new(arena) BinaryOperation(
                             span_range(current_expression->range, expression->range),
                             BinaryOperation::Operator::LessThan,
                             current_expression,
@@ -1172,7 +1176,7 @@ namespace {
 
                         expect(expression, parse_expression(OperatorPrecedence::BitwiseShift));
 
-                        current_expression = new BinaryOperation(
+                        current_expression = new(arena) BinaryOperation(
                             span_range(current_expression->range, expression->range),
                             BinaryOperation::Operator::LeftShift,
                             current_expression,
@@ -1191,7 +1195,7 @@ namespace {
 
                         expect(expression, parse_expression(OperatorPrecedence::Comparison));
 
-                        current_expression = new BinaryOperation(
+                        current_expression = new(arena) BinaryOperation(
                             span_range(current_expression->range, expression->range),
                             BinaryOperation::Operator::GreaterThan,
                             current_expression,
@@ -1210,7 +1214,7 @@ namespace {
 
                         expect(expression, parse_expression(OperatorPrecedence::BitwiseShift));
 
-                        current_expression = new BinaryOperation(
+                        current_expression = new(arena) BinaryOperation(
                             span_range(current_expression->range, expression->range),
                             BinaryOperation::Operator::RightShift,
                             current_expression,
@@ -1271,7 +1275,7 @@ namespace {
                             }
                         }
 
-                        current_expression = new FunctionCall(
+                        current_expression = new(arena) FunctionCall(
                             span_range(current_expression->range, last_range),
                             current_expression,
                             parameters
@@ -1293,7 +1297,7 @@ namespace {
 
                         expect(last_range, expect_basic_token_with_range(TokenKind::CloseSquareBracket));
 
-                        current_expression = new IndexReference(
+                        current_expression = new(arena) IndexReference(
                             span_range(current_expression->range, last_range),
                             current_expression,
                             index
@@ -1312,7 +1316,7 @@ namespace {
 
                             expect(expression, parse_expression(OperatorPrecedence::Cast));
 
-                            current_expression = new Cast(
+                            current_expression = new(arena) Cast(
                                 span_range(current_expression->range, expression->range),
                                 current_expression,
                                 expression
@@ -1522,7 +1526,7 @@ namespace {
                         }
                     }
 
-                    return ok((Statement*)new FunctionDeclaration(
+                    return ok((Statement*)new(arena) FunctionDeclaration(
                         span_range(name.range, last_range),
                         name,
                         parameters,
@@ -1535,7 +1539,7 @@ namespace {
                 case TokenKind::Semicolon: {
                     consume_token();
 
-                    return ok((Statement*)new FunctionDeclaration(
+                    return ok((Statement*)new(arena) FunctionDeclaration(
                         span_range(name.range, last_range),
                         name,
                         parameters,
@@ -1643,11 +1647,14 @@ namespace {
                             }
                         }
 
-                        return ok((Statement*)new Import(
+                        auto name_hash = calculate_string_hash(name);
+
+                        return ok((Statement*)new(arena) Import(
                             span_range(first_range, last_range),
                             string,
                             import_file_path_absolute,
-                            name
+                            intern_symbol(name, name_hash),
+                            name_hash
                         ));
                     } else if(token.identifier == u8"if"_S) {
                         expect(expression, parse_expression(OperatorPrecedence::None));
@@ -1673,7 +1680,7 @@ namespace {
                             }
                         }
 
-                        return ok((Statement*)new StaticIf(
+                        return ok((Statement*)new(arena) StaticIf(
                             span_range(first_range, last_range),
                             expression,
                             statements
@@ -1691,12 +1698,12 @@ namespace {
 
                         auto function_call = (FunctionCall*)expression;
 
-                        auto bake = new Bake(
+                        auto bake = new(arena) Bake(
                             span_range(first_range, function_call->range),
                             function_call
                         );
 
-                        return ok((Statement*)new ExpressionStatement(
+                        return ok((Statement*)new(arena) ExpressionStatement(
                             span_range(first_range, last_range),
                             bake
                         ));
@@ -1822,7 +1829,7 @@ namespace {
                             }
                         }
 
-                        return ok((Statement*)new IfStatement(
+                        return ok((Statement*)new(arena) IfStatement(
                             span_range(first_range, last_range),
                             expression,
                             statements,
@@ -1853,7 +1860,7 @@ namespace {
                             }
                         }
 
-                        return ok((Statement*)new WhileLoop(
+                        return ok((Statement*)new(arena) WhileLoop(
                             span_range(first_range, last_range),
                             expression,
                             statements
@@ -1881,7 +1888,7 @@ namespace {
 
                                 from = expression;
                             } else {
-                                auto named_reference = named_reference_from_identifier(identifier);
+                                auto named_reference = named_reference_from_identifier(arena, identifier);
 
                                 expect(expression, parse_expression_continuation(OperatorPrecedence::None, named_reference));
 
@@ -1923,7 +1930,7 @@ namespace {
                         }
 
                         if(has_index_name) {
-                            return ok((Statement*)new ForLoop(
+                            return ok((Statement*)new(arena) ForLoop(
                                 span_range(first_range, last_range),
                                 index_name,
                                 from,
@@ -1931,7 +1938,7 @@ namespace {
                                 statements
                             ));
                         } else {
-                            return ok((Statement*)new ForLoop(
+                            return ok((Statement*)new(arena) ForLoop(
                                 span_range(first_range, last_range),
                                 from,
                                 to,
@@ -1969,14 +1976,14 @@ namespace {
                             }
                         }
 
-                        return ok((Statement*)new ReturnStatement(
+                        return ok((Statement*)new(arena) ReturnStatement(
                             span_range(first_range, last_range),
                             values
                         ));
                     } else if(token.identifier == u8"break"_S) {
                         expect(last_range, expect_basic_token_with_range(TokenKind::Semicolon));
 
-                        return ok((Statement*)new BreakStatement(
+                        return ok((Statement*)new(arena) BreakStatement(
                             span_range(first_range, last_range)
                         ));
                     } else if(token.identifier == u8"asm"_S) {
@@ -2013,7 +2020,7 @@ namespace {
 
                         expect(last_range, expect_basic_token_with_range(TokenKind::Semicolon));
 
-                        return ok((Statement*)new InlineAssembly(
+                        return ok((Statement*)new(arena) InlineAssembly(
                             span_range(first_range, last_range),
                             assembly,
                             bindings
@@ -2032,7 +2039,7 @@ namespace {
 
                         expect(last_range, expect_basic_token_with_range(TokenKind::Semicolon));
 
-                        return ok((Statement*)new UsingStatement(
+                        return ok((Statement*)new(arena) UsingStatement(
                             span_range(first_range, last_range),
                             export_,
                             expression
@@ -2239,7 +2246,7 @@ namespace {
                                                         span_range(parameters_first_range, last_range)
                                                     );
                                                 } else {
-                                                    auto expression = named_reference_from_identifier(first_identifier);
+                                                    auto expression = named_reference_from_identifier(arena, first_identifier);
 
                                                     expect(right_expression, parse_expression_continuation(OperatorPrecedence::None, expression));
 
@@ -2249,7 +2256,7 @@ namespace {
 
                                                     expect(last_range, expect_basic_token_with_range(TokenKind::Semicolon));
 
-                                                    return ok((Statement*)new ConstantDefinition(
+                                                    return ok((Statement*)new(arena) ConstantDefinition(
                                                         span_range(first_range, last_range),
                                                         identifier,
                                                         outer_right_expression
@@ -2264,7 +2271,7 @@ namespace {
 
                                                 expect(last_range, expect_basic_token_with_range(TokenKind::Semicolon));
 
-                                                return ok((Statement*)new ConstantDefinition(
+                                                return ok((Statement*)new(arena) ConstantDefinition(
                                                     span_range(first_range, last_range),
                                                     identifier,
                                                     right_expression
@@ -2381,7 +2388,7 @@ namespace {
                                                     }
                                                 }
 
-                                                return ok((Statement*)new StructDefinition(
+                                                return ok((Statement*)new(arena) StructDefinition(
                                                     span_range(first_range, token_range(token)),
                                                     identifier,
                                                     parameters,
@@ -2493,7 +2500,7 @@ namespace {
                                                     }
                                                 }
 
-                                                return ok((Statement*)new UnionDefinition(
+                                                return ok((Statement*)new(arena) UnionDefinition(
                                                     span_range(first_range, token_range(token)),
                                                     identifier,
                                                     parameters,
@@ -2574,7 +2581,7 @@ namespace {
                                                     }
                                                 }
 
-                                                return ok((Statement*)new EnumDefinition(
+                                                return ok((Statement*)new(arena) EnumDefinition(
                                                     span_range(first_range, token_range(token)),
                                                     identifier,
                                                     backing_type,
@@ -2583,13 +2590,13 @@ namespace {
                                             } else {
                                                 auto sub_identifier = identifier_from_token(token);
 
-                                                auto expression = named_reference_from_identifier(sub_identifier);
+                                                auto expression = named_reference_from_identifier(arena, sub_identifier);
 
                                                 expect(right_expression, parse_expression_continuation(OperatorPrecedence::None, expression));
 
                                                 expect(last_range, expect_basic_token_with_range(TokenKind::Semicolon));
 
-                                                return ok((Statement*)new ConstantDefinition(
+                                                return ok((Statement*)new(arena) ConstantDefinition(
                                                     span_range(first_range, last_range),
                                                     identifier,
                                                     right_expression
@@ -2602,7 +2609,7 @@ namespace {
 
                                             expect(last_range, expect_basic_token_with_range(TokenKind::Semicolon));
 
-                                            return ok((Statement*)new ConstantDefinition(
+                                            return ok((Statement*)new(arena) ConstantDefinition(
                                                 span_range(first_range, last_range),
                                                 identifier,
                                                 expression
@@ -2634,7 +2641,7 @@ namespace {
 
                                     expect_void(expect_basic_token(TokenKind::Semicolon));
 
-                                    return ok((Statement*)new VariableDeclaration(
+                                    return ok((Statement*)new(arena) VariableDeclaration(
                                         span_range(first_range, token_range(token)),
                                         identifier,
                                         type,
@@ -2671,10 +2678,10 @@ namespace {
                                             break;
                                         } else {
                                             for(auto identifier : identifiers) {
-                                                targets.append(named_reference_from_identifier(identifier));
+                                                targets.append(named_reference_from_identifier(arena, identifier));
                                             }
 
-                                            auto expression = named_reference_from_identifier(identifier);
+                                            auto expression = named_reference_from_identifier(arena, identifier);
 
                                             expect(right_expression, parse_expression_continuation(OperatorPrecedence::None, expression));
 
@@ -2694,7 +2701,7 @@ namespace {
                                         }
                                     } else {
                                         for(auto identifier : identifiers) {
-                                            targets.append(named_reference_from_identifier(identifier));
+                                            targets.append(named_reference_from_identifier(arena, identifier));
                                         }
 
                                         expect(expression, parse_expression(OperatorPrecedence::None));
@@ -2736,17 +2743,17 @@ namespace {
                                 if(token.kind == TokenKind::Equals) {
                                     consume_token();
 
-                                    auto targets = allocate<Expression*>(identifiers.length);
+                                    auto targets = allocate<Expression*>(arena, identifiers.length);
 
                                     for(size_t i = 0; i < identifiers.length; i += 1) {
-                                        targets[i] = named_reference_from_identifier(identifiers[i]);
+                                        targets[i] = named_reference_from_identifier(arena, identifiers[i]);
                                     }
 
                                     expect(value, parse_expression(OperatorPrecedence::None));
 
                                     expect(last_range, expect_basic_token_with_range(TokenKind::Semicolon));
 
-                                    return ok((Statement*)new MultiReturnAssignment(
+                                    return ok((Statement*)new(arena) MultiReturnAssignment(
                                         span_range(first_range, last_range),
                                         Array(identifiers.length, targets),
                                         value
@@ -2760,7 +2767,7 @@ namespace {
 
                                     expect(last_range, expect_basic_token_with_range(TokenKind::Semicolon));
 
-                                    return ok((Statement*)new MultiReturnVariableDeclaration(
+                                    return ok((Statement*)new(arena) MultiReturnVariableDeclaration(
                                         span_range(first_range, last_range),
                                         identifiers,
                                         initializer
@@ -2777,14 +2784,14 @@ namespace {
 
                                 expect(last_range, expect_basic_token_with_range(TokenKind::Semicolon));
 
-                                return ok((Statement*)new MultiReturnAssignment(
+                                return ok((Statement*)new(arena) MultiReturnAssignment(
                                     span_range(first_range, last_range),
                                     targets,
                                     value
                                 ));
                             }
                         } else {
-                            auto expression = named_reference_from_identifier(identifier);
+                            auto expression = named_reference_from_identifier(arena, identifier);
 
                             expect(right_expression, parse_expression_continuation(OperatorPrecedence::None, expression));
 
@@ -2794,7 +2801,7 @@ namespace {
                                 case TokenKind::Semicolon: {
                                     consume_token();
 
-                                    return ok((Statement*)new ExpressionStatement(
+                                    return ok((Statement*)new(arena) ExpressionStatement(
                                         span_range(first_range, token_range(token)),
                                         right_expression
                                     ));
@@ -2828,7 +2835,7 @@ namespace {
 
                                     expect(last_range, expect_basic_token_with_range(TokenKind::Semicolon));
 
-                                    return ok((Statement*)new MultiReturnAssignment(
+                                    return ok((Statement*)new(arena) MultiReturnAssignment(
                                         span_range(first_range, last_range),
                                         targets,
                                         value
@@ -2892,14 +2899,14 @@ namespace {
                                     expect(last_range, expect_basic_token_with_range(TokenKind::Semicolon));
 
                                     if(is_binary_operation_assignment) {
-                                        return ok((Statement*)new BinaryOperationAssignment(
+                                        return ok((Statement*)new(arena) BinaryOperationAssignment(
                                             span_range(first_range, last_range),
                                             right_expression,
                                             binary_operator,
                                             expression
                                         ));
                                     } else {
-                                        return ok((Statement*)new Assignment(
+                                        return ok((Statement*)new(arena) Assignment(
                                             span_range(first_range, last_range),
                                             right_expression,
                                             expression
@@ -2920,7 +2927,7 @@ namespace {
                         case TokenKind::Semicolon: {
                             consume_token();
 
-                            return ok((Statement*)new ExpressionStatement(
+                            return ok((Statement*)new(arena) ExpressionStatement(
                                 span_range(first_range, token_range(token)),
                                 expression
                             ));
@@ -2954,7 +2961,7 @@ namespace {
 
                             expect(last_range, expect_basic_token_with_range(TokenKind::Semicolon));
 
-                            return ok((Statement*)new MultiReturnAssignment(
+                            return ok((Statement*)new(arena) MultiReturnAssignment(
                                 span_range(first_range, last_range),
                                 targets,
                                 value
@@ -2968,7 +2975,7 @@ namespace {
 
                             expect(last_range, expect_basic_token_with_range(TokenKind::Semicolon));
 
-                            return ok((Statement*)new Assignment(
+                            return ok((Statement*)new(arena) Assignment(
                                 span_range(first_range, last_range),
                                 expression,
                                 value_expression
@@ -2987,9 +2994,10 @@ namespace {
     };
 };
 
-profiled_function(Result<Array<Statement*>>, parse_tokens, (String path, Array<Token> tokens), (path, tokens)) {
+profiled_function(Result<Array<Statement*>>, parse_tokens, (String path, Array<Token> tokens, Arena* arena), (path, tokens, arena)) {
     Parser parser {};
     parser.path = path;
+    parser.arena = arena;
     parser.tokens = tokens;
 
     List<Statement*> statements {};
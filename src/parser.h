@@ -4,5 +4,7 @@
 #include "array.h"
 #include "tokens.h"
 #include "ast.h"
+#include "arena.h"
 
-Result<Array<Statement*>> parse_tokens(String path, Array<Token> tokens);
\ No newline at end of file
+// Syntax tree nodes are allocated in the given arena
+Result<Array<Statement*>> parse_tokens(String path, Array<Token> tokens, Arena* arena);
\ No newline at end of file
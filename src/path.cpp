@@ -10,6 +10,9 @@
 
 #include <limits.h>
 #include <libgen.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 Result<String> path_relative_to_absolute(String path) {
     char absolute_path[PATH_MAX];
@@ -104,6 +107,103 @@ Result<String> get_executable_path() {
 }
 #endif
 
+Result<String> get_cache_directory() {
+    StringBuffer buffer {};
+
+    auto cache_home = getenv("XDG_CACHE_HOME");
+    if(cache_home != nullptr && cache_home[0] != '\0') {
+        expect_void(buffer.append_c_string(cache_home));
+    } else {
+        auto home = getenv("HOME");
+        if(home == nullptr || home[0] == '\0') {
+            return err();
+        }
+
+        expect_void(buffer.append_c_string(home));
+        buffer.append(u8"/.cache"_S);
+    }
+
+    if(mkdir(buffer.to_c_string(), 0755) != 0 && errno != EEXIST) {
+        return err();
+    }
+
+    buffer.append(u8"/simple-compiler/"_S);
+
+    if(mkdir(buffer.to_c_string(), 0755) != 0 && errno != EEXIST) {
+        return err();
+    }
+
+    return ok((String)buffer);
+}
+
+Result<String> find_executable(String name) {
+    auto path_variable = getenv("PATH");
+    if(path_variable == nullptr) {
+        return err();
+    }
+
+    const char* directory = path_variable;
+    while(true) {
+        auto directory_end = strchr(directory, ':');
+
+        size_t directory_length;
+        if(directory_end == nullptr) {
+            directory_length = strlen(directory);
+        } else {
+            directory_length = (size_t)(directory_end - directory);
+        }
+
+        // An empty entry means the current directory
+        if(directory_length == 0) {
+            directory = ".";
+            directory_length = 1;
+        }
+
+        if(directory_length + 1 + name.length < PATH_MAX) {
+            char candidate_path[PATH_MAX];
+
+            memcpy(candidate_path, directory, directory_length);
+            candidate_path[directory_length] = '/';
+            memcpy(&candidate_path[directory_length + 1], name.elements, name.length);
+            candidate_path[directory_length + 1 + name.length] = '\0';
+
+            struct stat candidate_status;
+            if(
+                stat(candidate_path, &candidate_status) == 0 &&
+                S_ISREG(candidate_status.st_mode) &&
+                access(candidate_path, X_OK) == 0
+            ) {
+                char absolute_path[PATH_MAX];
+                if(realpath(candidate_path, absolute_path) == nullptr) {
+                    return err();
+                }
+
+                return String::from_c_string(absolute_path);
+            }
+        }
+
+        if(directory_end == nullptr) {
+            return err();
+        }
+
+        directory = directory_end + 1;
+    }
+}
+
+Result<uint64_t> get_file_identity_hash(String path) {
+    struct stat file_status;
+    if(stat(path.to_c_string(), &file_status) != 0) {
+        return err();
+    }
+
+    auto hash = (uint64_t)file_status.st_size;
+    hash = combine_hash(hash, (uint64_t)file_status.st_mtim.tv_sec);
+    hash = combine_hash(hash, (uint64_t)file_status.st_mtim.tv_nsec);
+    hash = combine_hash(hash, (uint64_t)file_status.st_ino);
+
+    return ok(hash);
+}
+
 #elif defined(OS_WINDOWS)
 
 #include <Windows.h>
@@ -156,4 +256,45 @@ String get_executable_path() {
     return String::from_c_string(file_name);
 }
 
+Result<String> get_cache_directory() {
+    auto local_app_data = getenv("LOCALAPPDATA");
+    if(local_app_data == nullptr || local_app_data[0] == '\0') {
+        return err();
+    }
+
+    StringBuffer buffer {};
+
+    expect_void(buffer.append_c_string(local_app_data));
+    buffer.append(u8"\\simple-compiler\\"_S);
+
+    if(!CreateDirectoryA(buffer.to_c_string(), nullptr) && GetLastError() != ERROR_ALREADY_EXISTS) {
+        return err();
+    }
+
+    return ok((String)buffer);
+}
+
+Result<String> find_executable(String name) {
+    auto found_path = allocate<CHAR>(_MAX_PATH);
+
+    auto length = SearchPathA(nullptr, name.to_c_string(), ".exe", _MAX_PATH, found_path, nullptr);
+    if(length == 0 || length >= _MAX_PATH) {
+        return err();
+    }
+
+    return String::from_c_string(found_path);
+}
+
+Result<uint64_t> get_file_identity_hash(String path) {
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if(!GetFileAttributesExA(path.to_c_string(), GetFileExInfoStandard, &attributes)) {
+        return err();
+    }
+
+    auto hash = ((uint64_t)attributes.nFileSizeHigh << 32) | (uint64_t)attributes.nFileSizeLow;
+    hash = combine_hash(hash, ((uint64_t)attributes.ftLastWriteTime.dwHighDateTime << 32) | (uint64_t)attributes.ftLastWriteTime.dwLowDateTime);
+
+    return ok(hash);
+}
+
 #endif
\ No newline at end of file
@@ -6,4 +6,13 @@
 Result<String> path_relative_to_absolute(String path);
 Result<String> path_get_directory_component(String path);
 Result<String> path_get_file_component(String path);
-Result<String> get_executable_path();
\ No newline at end of file
+Result<String> get_executable_path();
+
+// Per-user directory for files that are safe to delete, created if missing
+Result<String> get_cache_directory();
+
+// Searches the directories in PATH for an executable the way a shell would, returning its absolute path with links resolved
+Result<String> find_executable(String name);
+
+// Changes whenever the file is modified or replaced, without reading its contents
+Result<uint64_t> get_file_identity_hash(String path);
\ No newline at end of file
@@ -1,5 +1,10 @@
 #include "platform.h"
 #include "util.h"
+#if defined(OS_UNIX)
+#include <unistd.h>
+#elif defined(OS_WINDOWS)
+#include <Windows.h>
+#endif
 
 bool does_os_exist(String os) {
     return
@@ -218,3 +223,11 @@ String get_host_os() {
     return u8"windows"_S;
 #endif
 }
+
+size_t get_process_id() {
+#if defined(OS_UNIX)
+    return (size_t)getpid();
+#elif defined(OS_WINDOWS)
+    return (size_t)GetCurrentProcessId();
+#endif
+}
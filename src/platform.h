@@ -47,4 +47,6 @@ String get_llvm_triple(String architecture, String os, String toolchain);
 String get_llvm_features(String architecture);
 
 String get_host_architecture();
-String get_host_os();
\ No newline at end of file
+String get_host_os();
+
+size_t get_process_id();
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "register_size.h"
 #include <stdlib.h>
+#include <string.h>
 
 uint64_t register_size_to_byte_size(RegisterSize size) {
     switch(size) {
@@ -19,6 +20,79 @@ uint64_t register_size_to_byte_size(RegisterSize size) {
             return 8;
         } break;
 
+        default: {
+            abort();
+        } break;
+    }
+}
+
+uint64_t read_packed_integer(const uint8_t* bytes, RegisterSize size, bool is_signed, size_t index) {
+    switch(size) {
+        case RegisterSize::Size8: {
+            auto value = bytes[index];
+
+            if(is_signed) {
+                return (uint64_t)(int8_t)value;
+            } else {
+                return value;
+            }
+        } break;
+
+        case RegisterSize::Size16: {
+            uint16_t value;
+            memcpy(&value, &bytes[index * sizeof(value)], sizeof(value));
+
+            if(is_signed) {
+                return (uint64_t)(int16_t)value;
+            } else {
+                return value;
+            }
+        } break;
+
+        case RegisterSize::Size32: {
+            uint32_t value;
+            memcpy(&value, &bytes[index * sizeof(value)], sizeof(value));
+
+            if(is_signed) {
+                return (uint64_t)(int32_t)value;
+            } else {
+                return value;
+            }
+        } break;
+
+        case RegisterSize::Size64: {
+            uint64_t value;
+            memcpy(&value, &bytes[index * sizeof(value)], sizeof(value));
+
+            return value;
+        } break;
+
+        default: {
+            abort();
+        } break;
+    }
+}
+
+void write_packed_integer(uint8_t* bytes, RegisterSize size, size_t index, uint64_t value) {
+    switch(size) {
+        case RegisterSize::Size8: {
+            bytes[index] = (uint8_t)value;
+        } break;
+
+        case RegisterSize::Size16: {
+            auto truncated_value = (uint16_t)value;
+            memcpy(&bytes[index * sizeof(truncated_value)], &truncated_value, sizeof(truncated_value));
+        } break;
+
+        case RegisterSize::Size32: {
+            auto truncated_value = (uint32_t)value;
+            memcpy(&bytes[index * sizeof(truncated_value)], &truncated_value, sizeof(truncated_value));
+        } break;
+
+        case RegisterSize::Size64: {
+            memcpy(&bytes[index * sizeof(value)], &value, sizeof(value));
+        } break;
+
         default: {
             abort();
         } break;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 enum struct RegisterSize {
@@ -9,4 +10,8 @@ enum struct RegisterSize {
     Size64
 };
 
-uint64_t register_size_to_byte_size(RegisterSize size);
\ No newline at end of file
+uint64_t register_size_to_byte_size(RegisterSize size);
+
+// Integers packed back-to-back in host byte order, as used for constant byte buffers
+uint64_t read_packed_integer(const uint8_t* bytes, RegisterSize size, bool is_signed, size_t index);
+void write_packed_integer(uint8_t* bytes, RegisterSize size, size_t index, uint64_t value);
\ No newline at end of file
@@ -0,0 +1,194 @@
+#include "source_files.h"
+#include <stdio.h>
+#include "platform.h"
+#include "list.h"
+#include "util.h"
+#include "threading.h"
+
+#if defined(OS_UNIX)
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static Result<void> map_file(String path, uint8_t** source, size_t* length) {
+    auto file = open(path.to_c_string(), O_RDONLY);
+    if(file == -1) {
+        return err();
+    }
+
+    struct stat file_status;
+    if(fstat(file, &file_status) == -1) {
+        close(file);
+
+        return err();
+    }
+
+    *length = (size_t)file_status.st_size;
+
+    // Zero-length mappings are not allowed
+    if(*length == 0) {
+        *source = nullptr;
+    } else {
+        auto mapping = mmap(nullptr, *length, PROT_READ, MAP_PRIVATE, file, 0);
+        if(mapping == MAP_FAILED) {
+            close(file);
+
+            return err();
+        }
+
+        *source = (uint8_t*)mapping;
+    }
+
+    close(file);
+
+    return ok();
+}
+
+#elif defined(OS_WINDOWS)
+
+#include <Windows.h>
+
+static Result<void> map_file(String path, uint8_t** source, size_t* length) {
+    auto file = CreateFileA(path.to_c_string(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE) {
+        return err();
+    }
+
+    LARGE_INTEGER file_size;
+    if(!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+
+        return err();
+    }
+
+    *length = (size_t)file_size.QuadPart;
+
+    // Zero-length mappings are not allowed
+    if(*length == 0) {
+        *source = nullptr;
+    } else {
+        auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(mapping == nullptr) {
+            CloseHandle(file);
+
+            return err();
+        }
+
+        auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+        CloseHandle(mapping);
+
+        if(view == nullptr) {
+            CloseHandle(file);
+
+            return err();
+        }
+
+        *source = (uint8_t*)view;
+    }
+
+    CloseHandle(file);
+
+    return ok();
+}
+
+#endif
+
+struct SourceFileTable {
+    Mutex mutex;
+
+    List<SourceFile*> files;
+};
+
+static SourceFileTable source_file_table { create_mutex() };
+
+Result<SourceFile*> load_source_file(String path) {
+    lock_mutex(source_file_table.mutex);
+
+    for(auto file : source_file_table.files) {
+        if(file->path == path) {
+            unlock_mutex(source_file_table.mutex);
+
+            return ok(file);
+        }
+    }
+
+    uint8_t* source;
+    size_t length;
+    if(!map_file(path, &source, &length).status) {
+        unlock_mutex(source_file_table.mutex);
+
+        fprintf(stderr, "Error: Unable to read source file at '%.*s'\n", STRING_PRINTF_ARGUMENTS(path));
+
+        return err();
+    }
+
+    auto file = new SourceFile;
+    file->path = path;
+    file->source = source;
+    file->length = length;
+    file->line_offsets = Array<size_t>::empty();
+
+    source_file_table.files.append(file);
+
+    unlock_mutex(source_file_table.mutex);
+
+    return ok(file);
+}
+
+void set_source_file_line_offsets(SourceFile* file, Array<size_t> line_offsets) {
+    lock_mutex(source_file_table.mutex);
+
+    file->line_offsets = line_offsets;
+
+    unlock_mutex(source_file_table.mutex);
+}
+
+SourceFile* find_lexed_source_file(String path) {
+    lock_mutex(source_file_table.mutex);
+
+    for(auto file : source_file_table.files) {
+        if(file->path == path && file->line_offsets.length != 0) {
+            unlock_mutex(source_file_table.mutex);
+
+            return file;
+        }
+    }
+
+    unlock_mutex(source_file_table.mutex);
+
+    return nullptr;
+}
+
+void print_source_line(uint8_t* source, size_t length, size_t line_offset, unsigned int first_column, unsigned int last_column) {
+    auto line_start = line_offset;
+
+    unsigned int skipped_spaces = 0;
+    while(line_start < length && source[line_start] == ' ') {
+        skipped_spaces += 1;
+        line_start += 1;
+    }
+
+    auto line_end = line_start;
+    while(line_end < length && source[line_end] != '\r' && source[line_end] != '\n') {
+        line_end += 1;
+    }
+
+    fprintf(stderr, "%.*s\n", (int)(line_end - line_start), (char*)&source[line_start]);
+
+    for(unsigned int i = skipped_spaces + 1; i < first_column; i += 1) {
+        fprintf(stderr, " ");
+    }
+
+    if(last_column == first_column) {
+        fprintf(stderr, "^");
+    } else {
+        for(unsigned int i = first_column; i <= last_column; i += 1) {
+            fprintf(stderr, "-");
+        }
+    }
+
+    fprintf(stderr, "\n");
+}
\ No newline at end of file
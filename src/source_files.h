@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+#include "result.h"
+#include "array.h"
+#include "string.h"
+
+// Source files are mapped into memory once and stay mapped until the compiler exits, so tokens and diagnostics can
+// refer to their contents directly
+struct SourceFile {
+    String path;
+
+    uint8_t* source;
+    size_t length;
+
+    // Offset of the first byte of each line, recorded by the lexer. Empty until the file has been lexed
+    Array<size_t> line_offsets;
+};
+
+Result<SourceFile*> load_source_file(String path);
+void set_source_file_line_offsets(SourceFile* file, Array<size_t> line_offsets);
+
+// Returns nullptr if the file has not been loaded or lexed yet
+SourceFile* find_lexed_source_file(String path);
+
+// Prints the given line without its leading spaces, with a marker under the given column range below it
+void print_source_line(uint8_t* source, size_t length, size_t line_offset, unsigned int first_column, unsigned int last_column);
\ No newline at end of file
@@ -2,10 +2,17 @@
 #include "string.h"
 #include "util.h"
 #include "profiler.h"
+#include "byte_scan.h"
 
 Result<void> validate_utf8_string(uint8_t* bytes, size_t length) {
     size_t index = 0;
     while(index < length) {
+        index += count_ascii_bytes(&bytes[index], length - index);
+
+        if(index == length) {
+            break;
+        }
+
         auto first_byte = bytes[index];
         index += 1;
 
@@ -0,0 +1,101 @@
+#include "symbols.h"
+#include <string.h>
+#include "util.h"
+#include "arena.h"
+#include "threading.h"
+
+uint32_t calculate_string_hash(String string) {
+    uint32_t hash = 0;
+
+    for(size_t i = 0; i < string.length; i += 1) {
+        hash = (uint8_t)string.elements[i] + (hash << 6) + (hash << 16) - hash;
+    }
+
+    return hash;
+}
+
+struct SymbolTableEntry {
+    uint32_t hash;
+
+    String text;
+};
+
+struct SymbolTable {
+    Mutex mutex;
+
+    Arena text_arena;
+
+    SymbolTableEntry* entries;
+    size_t capacity;
+    size_t count;
+};
+
+static SymbolTable symbol_table { create_mutex() };
+
+static void insert_symbol(SymbolTableEntry* entries, size_t capacity, SymbolTableEntry entry) {
+    auto entry_index = (size_t)entry.hash & (capacity - 1);
+
+    while(entries[entry_index].text.elements != nullptr) {
+        entry_index = (entry_index + 1) & (capacity - 1);
+    }
+
+    entries[entry_index] = entry;
+}
+
+String intern_symbol(String text, uint32_t hash) {
+    lock_mutex(symbol_table.mutex);
+
+    if(symbol_table.capacity != 0) {
+        auto entry_index = (size_t)hash & (symbol_table.capacity - 1);
+
+        while(symbol_table.entries[entry_index].text.elements != nullptr) {
+            auto entry = symbol_table.entries[entry_index];
+
+            if(entry.hash == hash && entry.text == text) {
+                unlock_mutex(symbol_table.mutex);
+
+                return entry.text;
+            }
+
+            entry_index = (entry_index + 1) & (symbol_table.capacity - 1);
+        }
+    }
+
+    if((symbol_table.count + 1) * 2 > symbol_table.capacity) {
+        size_t new_capacity;
+        if(symbol_table.capacity == 0) {
+            new_capacity = 1024;
+        } else {
+            new_capacity = symbol_table.capacity * 2;
+        }
+
+        auto new_entries = allocate<SymbolTableEntry>(new_capacity);
+        memset(new_entries, 0, new_capacity * sizeof(SymbolTableEntry));
+
+        for(size_t i = 0; i < symbol_table.capacity; i += 1) {
+            if(symbol_table.entries[i].text.elements != nullptr) {
+                insert_symbol(new_entries, new_capacity, symbol_table.entries[i]);
+            }
+        }
+
+        free(symbol_table.entries);
+
+        symbol_table.entries = new_entries;
+        symbol_table.capacity = new_capacity;
+    }
+
+    // Every symbol gets its own allocation, even an empty one, so no two symbols share an address
+    SymbolTableEntry entry {};
+    entry.hash = hash;
+    entry.text.length = text.length;
+    entry.text.elements = allocate<char8_t>(&symbol_table.text_arena, text.length + 1);
+    memcpy(entry.text.elements, text.elements, text.length);
+
+    insert_symbol(symbol_table.entries, symbol_table.capacity, entry);
+
+    symbol_table.count += 1;
+
+    unlock_mutex(symbol_table.mutex);
+
+    return entry.text;
+}
\ No newline at end of file
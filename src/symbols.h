@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdint.h>
+#include "string.h"
+
+uint32_t calculate_string_hash(String string);
+
+// Identifiers are interned, so every name with the same text shares one copy of it that lives until the compiler
+// exits. Interned names can then be compared by address instead of by contents.
+String intern_symbol(String text, uint32_t hash);
+
+inline String intern_symbol(String text) {
+    return intern_symbol(text, calculate_string_hash(text));
+}
+
+inline bool symbols_equal(String a, String b) {
+    return a.elements == b.elements;
+}
\ No newline at end of file
@@ -4,13 +4,20 @@
 #include "platform.h"
 
 int main(int argc, char* argv[]) {
-    if(argc != 3) {
+    // Usage: test_driver <compiler> <source file> [compiler options...]
+    if(argc < 3) {
         return 1;
     }
 
     char command[1024];
 
     strcpy(command, argv[1]);
+
+    for(int i = 3; i < argc; i += 1) {
+        strcat(command, " ");
+        strcat(command, argv[i]);
+    }
+
     strcat(command, " ");
     strcat(command, argv[2]);
 
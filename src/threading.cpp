@@ -0,0 +1,187 @@
+#include "threading.h"
+#include <assert.h>
+#include "platform.h"
+#include "util.h"
+
+#if defined(OS_LINUX)
+
+#include <pthread.h>
+#include <unistd.h>
+
+Mutex create_mutex() {
+    pthread_mutexattr_t attributes;
+    auto result = pthread_mutexattr_init(&attributes);
+    assert(result == 0);
+
+    result = pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+    assert(result == 0);
+
+    auto mutex = allocate<pthread_mutex_t>(1);
+    result = pthread_mutex_init(mutex, &attributes);
+    assert(result == 0);
+
+    pthread_mutexattr_destroy(&attributes);
+
+    return {
+        mutex
+    };
+}
+
+void lock_mutex(Mutex mutex) {
+    auto result = pthread_mutex_lock((pthread_mutex_t*)mutex.handle);
+    assert(result == 0);
+}
+
+void unlock_mutex(Mutex mutex) {
+    auto result = pthread_mutex_unlock((pthread_mutex_t*)mutex.handle);
+    assert(result == 0);
+}
+
+ConditionVariable create_condition_variable() {
+    auto condition_variable = allocate<pthread_cond_t>(1);
+    auto result = pthread_cond_init(condition_variable, nullptr);
+    assert(result == 0);
+
+    return {
+        condition_variable
+    };
+}
+
+void wait_condition_variable(ConditionVariable condition_variable, Mutex mutex) {
+    auto result = pthread_cond_wait((pthread_cond_t*)condition_variable.handle, (pthread_mutex_t*)mutex.handle);
+    assert(result == 0);
+}
+
+void wake_all_condition_variable(ConditionVariable condition_variable) {
+    auto result = pthread_cond_broadcast((pthread_cond_t*)condition_variable.handle);
+    assert(result == 0);
+}
+
+struct ThreadStart {
+    void (*entry)(void* data);
+    void* data;
+};
+
+static void* thread_start(void* data) {
+    auto start = (ThreadStart*)data;
+
+    start->entry(start->data);
+
+    free(start);
+
+    return nullptr;
+}
+
+Thread create_thread(void (*entry)(void* data), void* data) {
+    auto start = allocate<ThreadStart>(1);
+    start->entry = entry;
+    start->data = data;
+
+    auto thread = allocate<pthread_t>(1);
+    auto result = pthread_create(thread, nullptr, thread_start, start);
+    assert(result == 0);
+
+    return {
+        thread
+    };
+}
+
+void join_thread(Thread thread) {
+    auto result = pthread_join(*(pthread_t*)thread.handle, nullptr);
+    assert(result == 0);
+
+    free(thread.handle);
+}
+
+size_t get_processor_count() {
+    auto count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if(count < 1) {
+        return 1;
+    }
+
+    return (size_t)count;
+}
+
+#elif defined(OS_WINDOWS)
+
+#include <Windows.h>
+
+Mutex create_mutex() {
+    auto critical_section = allocate<CRITICAL_SECTION>(1);
+    InitializeCriticalSection(critical_section);
+
+    return {
+        critical_section
+    };
+}
+
+void lock_mutex(Mutex mutex) {
+    EnterCriticalSection((CRITICAL_SECTION*)mutex.handle);
+}
+
+void unlock_mutex(Mutex mutex) {
+    LeaveCriticalSection((CRITICAL_SECTION*)mutex.handle);
+}
+
+ConditionVariable create_condition_variable() {
+    auto condition_variable = allocate<CONDITION_VARIABLE>(1);
+    InitializeConditionVariable(condition_variable);
+
+    return {
+        condition_variable
+    };
+}
+
+void wait_condition_variable(ConditionVariable condition_variable, Mutex mutex) {
+    auto success = SleepConditionVariableCS((CONDITION_VARIABLE*)condition_variable.handle, (CRITICAL_SECTION*)mutex.handle, INFINITE);
+    assert(success);
+}
+
+void wake_all_condition_variable(ConditionVariable condition_variable) {
+    WakeAllConditionVariable((CONDITION_VARIABLE*)condition_variable.handle);
+}
+
+struct ThreadStart {
+    void (*entry)(void* data);
+    void* data;
+};
+
+static DWORD WINAPI thread_start(void* data) {
+    auto start = (ThreadStart*)data;
+
+    start->entry(start->data);
+
+    free(start);
+
+    return 0;
+}
+
+Thread create_thread(void (*entry)(void* data), void* data) {
+    auto start = allocate<ThreadStart>(1);
+    start->entry = entry;
+    start->data = data;
+
+    auto thread = CreateThread(nullptr, 0, thread_start, start, 0, nullptr);
+    assert(thread != nullptr);
+
+    return {
+        thread
+    };
+}
+
+void join_thread(Thread thread) {
+    auto result = WaitForSingleObject(thread.handle, INFINITE);
+    assert(result == WAIT_OBJECT_0);
+
+    CloseHandle(thread.handle);
+}
+
+size_t get_processor_count() {
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+
+    return (size_t)system_info.dwNumberOfProcessors;
+}
+
+#endif
\ No newline at end of file
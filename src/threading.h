@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Mutexes are recursive, so a thread may lock one it already holds
+struct Mutex {
+    void* handle;
+};
+
+Mutex create_mutex();
+void lock_mutex(Mutex mutex);
+void unlock_mutex(Mutex mutex);
+
+struct ConditionVariable {
+    void* handle;
+};
+
+ConditionVariable create_condition_variable();
+void wait_condition_variable(ConditionVariable condition_variable, Mutex mutex);
+void wake_all_condition_variable(ConditionVariable condition_variable);
+
+struct Thread {
+    void* handle;
+};
+
+Thread create_thread(void (*entry)(void* data), void* data);
+void join_thread(Thread thread);
+
+size_t get_processor_count();
+
+template <typename T>
+inline T atomic_load(T* pointer) {
+    return __atomic_load_n(pointer, __ATOMIC_ACQUIRE);
+}
+
+template <typename T>
+inline void atomic_store(T* pointer, T value) {
+    __atomic_store_n(pointer, value, __ATOMIC_RELEASE);
+}
+
+template <typename T>
+inline void atomic_add(T* pointer, T value) {
+    __atomic_fetch_add(pointer, value, __ATOMIC_RELAXED);
+}
\ No newline at end of file
@@ -54,6 +54,9 @@ struct Token {
     unsigned int first_column;
     unsigned int last_column;
 
+    // Only set for identifiers, whose text the lexer interns
+    uint32_t identifier_hash;
+
     union {
         String identifier;
 
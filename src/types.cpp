@@ -1,6 +1,7 @@
 #include "types.h"
 #include <string.h>
 #include "util.h"
+#include "threading.h"
 
 bool AnyType::operator==(AnyType other) {
     if(kind != other.kind) {
@@ -34,17 +35,15 @@ bool AnyType::operator==(AnyType other) {
     } else if(kind == TypeKind::FloatType) {
         return float_.size == other.float_.size;
     } else if(kind == TypeKind::Pointer) {
-        auto a_pointer = pointer;
-        auto b_pointer = other.pointer;
-
-        return *a_pointer.pointed_to_type == *b_pointer.pointed_to_type;
+        // Types pointed to by other types are interned, so they are equal only if they are the same object
+        return pointer.pointed_to_type == other.pointer.pointed_to_type;
     } else if(kind == TypeKind::ArrayTypeType) {
-        return *array.element_type == *other.array.element_type;
+        return array.element_type == other.array.element_type;
     } else if(kind == TypeKind::StaticArray) {
         auto a_static_array = static_array;
         auto b_static_array = other.static_array;
 
-        return *a_static_array.element_type == *b_static_array.element_type && a_static_array.length == b_static_array.length;
+        return a_static_array.element_type == b_static_array.element_type && a_static_array.length == b_static_array.length;
     } else if(kind == TypeKind::StructType) {
         auto a_struct = struct_;
         auto b_struct = other.struct_;
@@ -71,7 +70,7 @@ bool AnyType::operator==(AnyType other) {
         auto a_polymorphic_struct = polymorphic_struct;
         auto b_polymorphic_struct = other.polymorphic_struct;
 
-        return a_polymorphic_struct.definition != b_polymorphic_struct.definition;
+        return a_polymorphic_struct.definition == b_polymorphic_struct.definition;
     } else if(kind == TypeKind::UnionType) {
         auto a_union = union_;
         auto b_union = other.union_;
@@ -98,7 +97,7 @@ bool AnyType::operator==(AnyType other) {
         auto a_polymorphic_union = polymorphic_union;
         auto b_polymorphic_union = other.polymorphic_union;
 
-        return a_polymorphic_union.definition != b_polymorphic_union.definition;
+        return a_polymorphic_union.definition == b_polymorphic_union.definition;
     } else if(kind == TypeKind::UndeterminedStruct) {
         auto a_undetermined_struct = undetermined_struct;
         auto b_undetermined_struct = other.undetermined_struct;
@@ -144,6 +143,179 @@ bool AnyType::operator!=(AnyType other) {
     return !(*this == other);
 }
 
+// Only hashes what operator== compares, stopping after a few levels so self-referencing aggregates terminate
+static uint64_t calculate_type_hash(AnyType type, size_t depth) {
+    auto hash = (uint64_t)type.kind;
+
+    if(depth == 0) {
+        return hash;
+    }
+
+    if(type.kind == TypeKind::FunctionTypeType) {
+        hash = combine_hash(hash, (uint64_t)type.function.calling_convention);
+
+        for(size_t i = 0; i < type.function.parameters.length; i += 1) {
+            hash = combine_hash(hash, calculate_type_hash(type.function.parameters[i], depth - 1));
+        }
+
+        hash = combine_hash(hash, type.function.parameters.length);
+
+        for(size_t i = 0; i < type.function.return_types.length; i += 1) {
+            hash = combine_hash(hash, calculate_type_hash(type.function.return_types[i], depth - 1));
+        }
+    } else if(type.kind == TypeKind::Integer) {
+        hash = combine_hash(hash, (uint64_t)type.integer.size);
+        hash = combine_hash(hash, (uint64_t)type.integer.is_signed);
+    } else if(type.kind == TypeKind::FloatType) {
+        hash = combine_hash(hash, (uint64_t)type.float_.size);
+    } else if(type.kind == TypeKind::Pointer) {
+        hash = combine_hash(hash, (uint64_t)type.pointer.pointed_to_type);
+    } else if(type.kind == TypeKind::ArrayTypeType) {
+        hash = combine_hash(hash, (uint64_t)type.array.element_type);
+    } else if(type.kind == TypeKind::StaticArray) {
+        hash = combine_hash(hash, type.static_array.length);
+        hash = combine_hash(hash, (uint64_t)type.static_array.element_type);
+    } else if(type.kind == TypeKind::StructType) {
+        hash = combine_hash(hash, (uint64_t)type.struct_.definition);
+
+        for(size_t i = 0; i < type.struct_.members.length; i += 1) {
+            hash = combine_hash(hash, calculate_type_hash(type.struct_.members[i].type, depth - 1));
+        }
+    } else if(type.kind == TypeKind::UnionType) {
+        hash = combine_hash(hash, (uint64_t)type.union_.definition);
+
+        for(size_t i = 0; i < type.union_.members.length; i += 1) {
+            hash = combine_hash(hash, calculate_type_hash(type.union_.members[i].type, depth - 1));
+        }
+    } else if(type.kind == TypeKind::UndeterminedStruct) {
+        for(size_t i = 0; i < type.undetermined_struct.members.length; i += 1) {
+            hash = combine_hash(hash, calculate_type_hash(type.undetermined_struct.members[i].type, depth - 1));
+        }
+    } else if(type.kind == TypeKind::Enum) {
+        hash = combine_hash(hash, (uint64_t)type.enum_.definition);
+    } else if(type.kind == TypeKind::MultiReturn) {
+        for(size_t i = 0; i < type.multi_return.types.length; i += 1) {
+            hash = combine_hash(hash, calculate_type_hash(type.multi_return.types[i], depth - 1));
+        }
+    }
+
+    return hash;
+}
+
+uint64_t AnyType::get_hash() {
+    return calculate_type_hash(*this, 4);
+}
+
+struct InternedTypeTable {
+    AnyType** buckets;
+    size_t capacity;
+};
+
+// Lookups read the current table and its buckets without taking the mutex, so jobs that find an existing type never wait
+// on each other. Buckets are only ever filled, and a full table is replaced rather than resized in place. Replaced tables
+// are never freed, since another thread may still be probing one.
+struct TypeInterner {
+    Mutex mutex;
+
+    InternedTypeTable* table;
+    size_t count;
+};
+
+static TypeInterner type_interner { create_mutex() };
+
+static AnyType* find_interned_type(InternedTypeTable* table, AnyType type, uint64_t hash) {
+    auto bucket_index = (size_t)hash & (table->capacity - 1);
+
+    while(true) {
+        auto interned_type = atomic_load(&table->buckets[bucket_index]);
+
+        if(interned_type == nullptr) {
+            return nullptr;
+        }
+
+        if(*interned_type == type) {
+            return interned_type;
+        }
+
+        bucket_index = (bucket_index + 1) & (table->capacity - 1);
+    }
+}
+
+static void insert_interned_type(InternedTypeTable* table, AnyType* type, uint64_t hash) {
+    auto bucket_index = (size_t)hash & (table->capacity - 1);
+
+    while(table->buckets[bucket_index] != nullptr) {
+        bucket_index = (bucket_index + 1) & (table->capacity - 1);
+    }
+
+    atomic_store(&table->buckets[bucket_index], type);
+}
+
+AnyType* intern_type(AnyType type) {
+    auto hash = type.get_hash();
+
+    auto table = atomic_load(&type_interner.table);
+
+    if(table != nullptr) {
+        auto interned_type = find_interned_type(table, type, hash);
+
+        if(interned_type != nullptr) {
+            return interned_type;
+        }
+    }
+
+    lock_mutex(type_interner.mutex);
+
+    // Another thread may have interned the type, or replaced the table, since the lookup above
+    table = type_interner.table;
+
+    if(table != nullptr) {
+        auto interned_type = find_interned_type(table, type, hash);
+
+        if(interned_type != nullptr) {
+            unlock_mutex(type_interner.mutex);
+
+            return interned_type;
+        }
+    }
+
+    if(table == nullptr || (type_interner.count + 1) * 2 > table->capacity) {
+        size_t new_capacity;
+        if(table == nullptr) {
+            new_capacity = 256;
+        } else {
+            new_capacity = table->capacity * 2;
+        }
+
+        auto new_table = allocate<InternedTypeTable>(1);
+        new_table->buckets = allocate<AnyType*>(new_capacity);
+        new_table->capacity = new_capacity;
+        memset(new_table->buckets, 0, new_capacity * sizeof(AnyType*));
+
+        if(table != nullptr) {
+            for(size_t i = 0; i < table->capacity; i += 1) {
+                if(table->buckets[i] != nullptr) {
+                    insert_interned_type(new_table, table->buckets[i], table->buckets[i]->get_hash());
+                }
+            }
+        }
+
+        table = new_table;
+
+        atomic_store(&type_interner.table, new_table);
+    }
+
+    auto interned_type = heapify(type);
+
+    insert_interned_type(table, interned_type, hash);
+
+    type_interner.count += 1;
+
+    unlock_mutex(type_interner.mutex);
+
+    return interned_type;
+}
+
 String AnyType::get_description() {
     if(kind == TypeKind::FunctionTypeType) {
         StringBuffer buffer {};
@@ -308,6 +308,7 @@ struct AnyType {
 
     bool operator==(AnyType other);
     bool operator!=(AnyType other);
+    uint64_t get_hash();
     String get_description();
     bool is_runtime_type();
     bool is_pointable_type();
@@ -319,4 +320,8 @@ struct StructTypeMember {
     String name;
 
     AnyType type;
-};
\ No newline at end of file
+};
+
+// Returns the one shared copy of a type. Types that other types point to must be interned, which lets them be
+// compared and hashed by address.
+AnyType* intern_type(AnyType type);
\ No newline at end of file
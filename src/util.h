@@ -27,10 +27,20 @@ inline T* allocate(size_t count) {
     return (T*)malloc(sizeof(T) * count);
 }
 
+inline uint64_t combine_hash(uint64_t hash, uint64_t value) {
+    hash ^= value + 0x9E3779B97F4A7C15 + (hash << 6) + (hash >> 2);
+
+    return hash;
+}
+
 template <typename T>
 inline T* reallocate(T* old_data, size_t new_count) {
     return (T*)realloc(old_data, sizeof(T) * new_count);
 }
 
+// Held for the whole of a diagnostic, so the lines of diagnostics from different threads don't interleave
+void lock_diagnostics();
+void unlock_diagnostics();
+
 void error(String path, FileRange range, const char* format, va_list arguments);
 void error(String path, FileRange range, const char* format, ...);
\ No newline at end of file